@@ -889,7 +889,7 @@ int Extract::writePreviews() const {
     if (num == 0) {
       // Write all previews
       for (num = 0; num < pvList.size(); ++num) {
-        writePreviewFile(pvMgr.getPreviewImage(pvList[num]), num + 1);
+        writePreviewFile(pvMgr.getPreviewView(pvList[num]), num + 1);
       }
       break;
     }
@@ -898,7 +898,7 @@ int Extract::writePreviews() const {
       std::cerr << path_ << ": " << _("Image does not have preview") << " " << num + 1 << "\n";
       continue;
     }
-    writePreviewFile(pvMgr.getPreviewImage(pvList[num]), num + 1);
+    writePreviewFile(pvMgr.getPreviewView(pvList[num]), num + 1);
   }
   return 0;
 }  // Extract::writePreviews
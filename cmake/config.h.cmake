@@ -30,6 +30,9 @@
 // Define if you have the strerror_r function.
 #cmakedefine EXV_HAVE_STRERROR_R
 
+// Define if you have the copy_file_range function.
+#cmakedefine EXV_HAVE_COPY_FILE_RANGE
+
 // Define if the strerror_r function returns char*.
 #cmakedefine EXV_STRERROR_R_CHAR_P
 
@@ -44,6 +44,7 @@ endif()
 
 if( EXIV2_ENABLE_PNG )
     find_package( ZLIB REQUIRED )
+    find_package( Threads REQUIRED )
 endif( )
 
 if( EXIV2_ENABLE_BMFF AND EXIV2_ENABLE_BROTLI )
@@ -126,8 +126,9 @@ class EXIV2API AsfVideo : public Image {
   /*!
     @brief Parse the header
     @param depth Current recursion depth, to detect files with excessive nesting.
+    @param end End of the header object, the objects in it are not read beyond.
    */
-  void decodeHeader(size_t depth);
+  void decodeHeader(size_t depth, uint64_t end);
   /*!
     @brief Interpret File_Properties tag information, and save it in
         the respective XMP container.
@@ -343,6 +343,24 @@ class EXIV2API FileIo : public BasicIo {
            0 if failure;
    */
   size_t write(BasicIo& src) override;
+  /*!
+    @brief Write data from the memory-mapped area of another file to
+        the file. The file position is advanced by the number of bytes
+        written.
+
+    If \em data lies within the area mapped by \em src.mmap(), the bytes
+    are copied from file to file without passing through user space
+    where the platform supports it (copy_file_range(2) on Linux). Any
+    other data is written like write(const byte*, size_t) does.
+
+    @param src FileIo instance whose mapped area may hold \em data.
+    @param data Pointer to data. Data must be at least \em wcount
+        bytes long
+    @param wcount Number of bytes to be written.
+    @return Number of bytes written to the file successfully;<BR>
+           0 if failure;
+   */
+  size_t write(const FileIo& src, const byte* data, size_t wcount);
   /*!
     @brief Write one byte to the file. The file position is
         advanced by one byte.
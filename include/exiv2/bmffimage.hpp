@@ -99,10 +99,18 @@ class EXIV2API BmffImage : public Image {
   //! @name Manipulators
   //@{
   void readMetadata() override;
+  /*!
+    @brief Write the Exif and XMP items of a HEIF or AVIF image.
+
+    An item which fits where it is is overwritten in place, else it is
+    appended to a new mdat box at the end of the file. Only the length and
+    offset of the item in the iloc box change, the rest of the file is left
+    as it is.
+    @throw Error if the file has no such item to write, such as CR3 and JXL
+        files, or it is not located in a single extent.
+   */
   void writeMetadata() override;
-  void setExifData(const ExifData&) override;
   void setIptcData(const IptcData&) override;
-  void setXmpData(const XmpData&) override;
   void setComment(const std::string& comment) override;
   void printStructure(std::ostream& out, Exiv2::PrintStructureOption option, size_t depth) override;
   //@}
@@ -118,15 +126,34 @@ class EXIV2API BmffImage : public Image {
 
  private:
   void openOrThrow() const;
+
+  //! Payload of a container box read into memory, the boxes in it are parsed from slices of it
+  struct BoxPayload {
+    Slice<const byte*> bytes_;  //!< The payload
+    uint64_t start_;            //!< Offset of the payload in the file
+
+    //! Return the \em size bytes at file offset \em offset, or nullptr if they are not in the payload
+    [[nodiscard]] const byte* bytesAt(uint64_t offset, size_t size) const;
+  };
+
   /*!
     @brief recursiveBoxHandler
     @throw Error if we visit a box more than once
     @param pbox_end The end location of the parent box. Boxes are
         nested, so we must not read beyond this.
+    @param parent Payload of the innermost container read into memory
+        which holds the box, if there is one.
     @return address of next box
     @warning This function should only be called by readMetadata()
    */
-  uint64_t boxHandler(std::ostream& out, Exiv2::PrintStructureOption option, uint64_t pbox_end, size_t depth);
+  uint64_t boxHandler(std::ostream& out, Exiv2::PrintStructureOption option, uint64_t pbox_end, size_t depth,
+                      const BoxPayload* parent = nullptr);
+  //! Read \em size bytes at the current position, from \em parent if it holds them, and advance
+  size_t readBytes(byte* buf, size_t size, const BoxPayload* parent);
+  //! Decode embedded tiff data, which starts at the first "II" or "MM" in it if \em hunt is true
+  void decodeTiff(uint32_t root_tag, const byte* pData, size_t size, bool hunt);
+  //! Decode an embedded xmp packet
+  void decodeXmp(const byte* pData, size_t size);
 
   uint32_t fileType_{0};
   std::set<size_t> visits_;
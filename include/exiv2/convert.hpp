@@ -16,6 +16,7 @@
 #include "exiv2lib_export.h"
 
 // standard includes
+#include <cstdint>
 #include <string>
 
 // *****************************************************************************
@@ -32,11 +33,25 @@ class XmpData;
 
 //! Convert (copy) Exif tags to XMP properties.
 EXIV2API void copyExifToXmp(const ExifData& exifData, XmpData& xmpData);
+/*!
+  @brief Convert (copy) the Exif tags that changed after generation \em since
+         of \em exifData to XMP properties, all of them if \em since is 0.
+  @return The generation of \em exifData, to pass as \em since to the next
+          call. See ChangeLog.
+ */
+EXIV2API uint64_t copyExifToXmp(const ExifData& exifData, XmpData& xmpData, uint64_t since);
 //! Convert (move) Exif tags to XMP properties, remove converted Exif tags.
 EXIV2API void moveExifToXmp(ExifData& exifData, XmpData& xmpData);
 
 //! Convert (copy) XMP properties to Exif tags.
 EXIV2API void copyXmpToExif(const XmpData& xmpData, ExifData& exifData);
+/*!
+  @brief Convert (copy) the XMP properties that changed after generation
+         \em since of \em xmpData to Exif tags, all of them if \em since is 0.
+  @return The generation of \em xmpData, to pass as \em since to the next
+          call. See ChangeLog.
+ */
+EXIV2API uint64_t copyXmpToExif(const XmpData& xmpData, ExifData& exifData, uint64_t since);
 //! Convert (move) XMP properties to Exif tags, remove converted XMP properties.
 EXIV2API void moveXmpToExif(XmpData& xmpData, ExifData& exifData);
 
@@ -45,11 +60,28 @@ EXIV2API void syncExifWithXmp(ExifData& exifData, XmpData& xmpData);
 
 //! Convert (copy) IPTC datasets to XMP properties.
 EXIV2API void copyIptcToXmp(const IptcData& iptcData, XmpData& xmpData, const char* iptcCharset = nullptr);
+/*!
+  @brief Convert (copy) the IPTC datasets that changed after generation
+         \em since of \em iptcData to XMP properties, all of them if \em since
+         is 0.
+  @return The generation of \em iptcData, to pass as \em since to the next
+          call. See ChangeLog.
+ */
+EXIV2API uint64_t copyIptcToXmp(const IptcData& iptcData, XmpData& xmpData, const char* iptcCharset,
+                                uint64_t since);
 //! Convert (move) IPTC datasets to XMP properties, remove converted IPTC datasets.
 EXIV2API void moveIptcToXmp(IptcData& iptcData, XmpData& xmpData, const char* iptcCharset = nullptr);
 
 //! Convert (copy) XMP properties to IPTC datasets.
 EXIV2API void copyXmpToIptc(const XmpData& xmpData, IptcData& iptcData);
+/*!
+  @brief Convert (copy) the XMP properties that changed after generation
+         \em since of \em xmpData to IPTC datasets, all of them if \em since
+         is 0.
+  @return The generation of \em xmpData, to pass as \em since to the next
+          call. See ChangeLog.
+ */
+EXIV2API uint64_t copyXmpToIptc(const XmpData& xmpData, IptcData& iptcData, uint64_t since);
 //! Convert (move) XMP properties to IPTC tags, remove converted XMP properties.
 EXIV2API void moveXmpToIptc(XmpData& xmpData, IptcData& iptcData);
 
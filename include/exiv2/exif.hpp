@@ -19,6 +19,7 @@
 #include "params.hpp"
 
 // + standard includes
+#include <functional>
 #include <list>
 
 // *****************************************************************************
@@ -32,8 +33,14 @@ namespace Exiv2 {
 // class declarations
 class ExifData;
 class ExifKey;
+class TiffParser;
 enum class IfdId : uint32_t;
 
+namespace Internal {
+class TiffDecoder;
+class TiffEncoder;
+}  // namespace Internal
+
 // *****************************************************************************
 // class definitions
 
@@ -378,8 +385,20 @@ using ExifMetadata = std::list<Exifdatum>;
   - write Exif data to JPEG files
   - extract Exif metadata to files, insert from these files
   - extract and delete Exif thumbnail (JPEG and TIFF thumbnails)
+
+  If the metadata was decoded with DecodeParams::lazy_makernotes(), the
+  makernote tags are only added to the container when it is first
+  iterated, sorted or counted, or when a key of a makernote group is looked
+  up. A makernote which was never expanded is written back unchanged.
+  This happens in const member functions too, so a container with a
+  deferred makernote must not be read from several threads at once.
 */
 class EXIV2API ExifData {
+  friend class ExifParser;
+  friend class TiffParser;
+  friend class Internal::TiffDecoder;
+  friend class Internal::TiffEncoder;
+
  public:
   //! ExifMetadata iterator type
   using iterator = ExifMetadata::iterator;
@@ -434,8 +453,10 @@ class EXIV2API ExifData {
   void sortByKey();
   //! Sort metadata by tag
   void sortByTag();
-  //! Begin of the metadata
+  //! Begin of the metadata, counts as a change of all entries, see ChangeLog
   iterator begin() {
+    expand();
+    changes_.touchAll();
     return exifMetadata_.begin();
   }
   //! End of the metadata
@@ -453,6 +474,7 @@ class EXIV2API ExifData {
   //@{
   //! Begin of the metadata
   [[nodiscard]] const_iterator begin() const {
+    expand();
     return exifMetadata_.begin();
   }
   //! End of the metadata
@@ -466,17 +488,35 @@ class EXIV2API ExifData {
   [[nodiscard]] const_iterator findKey(const ExifKey& key) const;
   //! Return true if there is no Exif metadata
   [[nodiscard]] bool empty() const {
-    return exifMetadata_.empty();
+    return exifMetadata_.empty() && !deferred_;
   }
   //! Get the number of metadata entries
   [[nodiscard]] size_t count() const {
+    expand();
     return exifMetadata_.size();
   }
+  //! Return the current generation of the metadata, see ChangeLog
+  [[nodiscard]] uint64_t generation() const {
+    return changes_.generation();
+  }
   //@}
 
  private:
+  //! Add the tags of a deferred makernote to the metadata, if there is one
+  void expand() const;
+  /*!
+    @brief Delete all entries of IFD \em ifdId. Expands a deferred makernote
+           only if \em ifdId is a makernote group.
+   */
+  void eraseIfd(IfdId ifdId);
+
   // DATA
-  ExifMetadata exifMetadata_;
+  mutable ExifMetadata exifMetadata_;
+  //! Decodes a deferred makernote into the list passed to it, set by the TIFF decoder
+  mutable std::function<void(ExifMetadata&)> deferred_;
+  //! Changes of the metadata, for the incremental conversions
+  ChangeLog changes_;
+  friend class Converter;
 };  // class ExifData
 
 /*!
@@ -315,6 +315,16 @@ class EXIV2API Image {
     access to the raw XMP packet.
    */
   void writeXmpFromPacket(bool flag);
+  /*!
+    @brief Determine when readMetadata() decodes the Exif makernote.
+
+    If the flag is set, the makernote is kept in its parsed form and
+    its tags are added to the Exif data only when it is first iterated
+    or a makernote key is looked up. A makernote which was never
+    expanded is written back unchanged. The default is false, i.e., the
+    makernote is decoded right away. See DecodeParams::lazy_makernotes().
+   */
+  void lazyMakernotes(bool flag);
   /*!
     @brief Set the byte order to encode the Exif metadata in.
 
@@ -464,6 +474,9 @@ class EXIV2API Image {
        this image supports for the metadata type \em metadataId.
     @param metadataId The metadata identifier.
     @return Access mode for the requested image type and metadata identifier.
+    @note The access mode is that of the image type. BMFF images are writable,
+       but writeMetadata() throws for CR3 and JPEG XL files, which have no
+       Exif or XMP items.
    */
   [[nodiscard]] AccessMode checkMode(MetadataId metadataId) const;
   /*!
@@ -473,6 +486,8 @@ class EXIV2API Image {
   [[deprecated]] [[nodiscard]] bool supportsMetadata(MetadataId metadataId) const;
   //! Return the flag indicating the source when writing XMP metadata.
   [[nodiscard]] bool writeXmpFromPacket() const;
+  //! Return the flag indicating if the makernote is decoded lazily.
+  [[nodiscard]] bool lazyMakernotes() const;
   //! Return list of native previews. This is meant to be used only by the PreviewManager.
   [[nodiscard]] const NativePreviewList& nativePreviews() const;
   //@}
@@ -526,6 +541,7 @@ class EXIV2API Image {
   bool writeXmpFromPacket_{true};  //!< Determines the source when writing XMP
 #endif
   ByteOrder byteOrder_{invalidByteOrder};  //!< Byte order
+  bool lazyMakernotes_{false};             //!< Determines when the makernote is decoded
 
   std::map<int, std::string> tags_;  //!< Map of tags
   bool init_{true};                  //!< Flag marking if map of tags needs to be initialized
@@ -677,6 +693,9 @@ class EXIV2API ImageFactory {
     @param metadataId The metadata identifier.
     @return Access mode for the requested image type and metadata identifier.
     @throw Error(kerUnsupportedImageType) if the image type is not supported.
+    @note ImageType::bmff covers HEIF, AVIF, CR3 and JPEG XL. Only HEIF and
+       AVIF files can be written, writeMetadata() throws
+       Error(kerWritingImageFormatUnsupported) for the others.
    */
   static AccessMode checkMode(ImageType type, MetadataId metadataId);
   /*!
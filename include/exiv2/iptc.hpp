@@ -198,13 +198,15 @@ class EXIV2API IptcData {
    */
   void clear() {
     iptcMetadata_.clear();
+    changes_.touchAll();
   }
   //! Sort metadata by key
   void sortByKey();
   //! Sort metadata by tag (aka dataset)
   void sortByTag();
-  //! Begin of the metadata
+  //! Begin of the metadata, counts as a change of all entries, see ChangeLog
   iterator begin() {
+    changes_.touchAll();
     return iptcMetadata_.begin();
   }
   //! End of the metadata
@@ -252,6 +254,10 @@ class EXIV2API IptcData {
   [[nodiscard]] size_t count() const {
     return iptcMetadata_.size();
   }
+  //! Return the current generation of the metadata, see ChangeLog
+  [[nodiscard]] uint64_t generation() const {
+    return changes_.generation();
+  }
 
   //! @brief Return the exact size of all contained IPTC metadata
   [[nodiscard]] size_t size() const;
@@ -266,6 +272,9 @@ class EXIV2API IptcData {
  private:
   // DATA
   IptcMetadata iptcMetadata_;
+  //! Changes of the metadata, for the incremental conversions
+  ChangeLog changes_;
+  friend class Converter;
 };  // class IptcData
 
 /*!
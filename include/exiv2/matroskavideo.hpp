@@ -158,6 +158,20 @@ class EXIV2API MatroskaVideo : public Image {
   void decodeFloatTags(const Internal::MatroskaTag* tag, const byte* buf);
 
  private:
+  /*!
+    @brief Read the ID and the data size of the element at the current
+        position of \em io. Return false at the end of the data or if the
+        header is not valid.
+   */
+  static bool readElementHeader(BasicIo& io, uint64_t& id, uint64_t& size);
+  /*!
+    @brief Decode the Info, Tracks and Tags elements of the segment at the
+        current IO position at the positions which its SeekHead records,
+        wherever they are in the file.
+    @return false if the segment has no usable SeekHead. Nothing is decoded then.
+   */
+  bool decodeIndexedElements();
+
   //! Variable to check the end of metadata traversing.
   bool continueTraversing_{};
   //! Variable to store height and width of a video frame.
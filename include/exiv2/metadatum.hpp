@@ -10,7 +10,10 @@
 #include "types.hpp"
 
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 // *****************************************************************************
 // namespace extensions
@@ -290,6 +293,55 @@ EXIV2API bool cmpMetadataByTag(const Metadatum& lhs, const Metadatum& rhs);
  */
 EXIV2API bool cmpMetadataByKey(const Metadatum& lhs, const Metadatum& rhs);
 
+/*!
+  @brief Change tracking for the metadata containers, which the incremental
+         conversions between Exif, IPTC and XMP use to convert only what
+         changed since their last run.
+
+  Every change increments the generation of the container. The containers
+  record the keys they add, erase or hand out through operator[] and
+  findKey(); handing out a mutable begin() or clearing the container counts
+  as a change of all entries. Keys are only recorded once generation() was
+  called, until then each change counts as a change of all entries.
+  Assigning a container counts as a change of all its entries as well.
+ */
+class EXIV2API ChangeLog {
+ public:
+  //! @name Creators
+  //@{
+  ChangeLog() = default;
+  ChangeLog(const ChangeLog& rhs) = default;
+  //! Assignment, counts as a change of all entries
+  ChangeLog& operator=(const ChangeLog& rhs);
+  //@}
+
+  //! @name Manipulators
+  //@{
+  //! Record a change of the entries with \em key
+  void touch(const std::string& key);
+  //! Record a change of all entries
+  void touchAll();
+  //@}
+
+  //! @name Accessors
+  //@{
+  //! Return the current generation and start recording the keys that change
+  [[nodiscard]] uint64_t generation() const;
+  //! Return true if all entries count as changed after generation \em since
+  [[nodiscard]] bool allChangedSince(uint64_t since) const {
+    return allChanged_ > since;
+  }
+  //! Return the keys that changed after generation \em since
+  [[nodiscard]] std::vector<std::string> changedSince(uint64_t since) const;
+  //@}
+
+ private:
+  uint64_t generation_{};                     //!< Incremented by every change
+  uint64_t allChanged_{};                     //!< Generation of the last change of all entries
+  mutable bool recording_{};                  //!< Whether changed_ is kept, set by generation()
+  std::map<std::string, uint64_t> changed_;  //!< Generation of the last change of each key
+};  // class ChangeLog
+
 }  // namespace Exiv2
 
 #endif  // EXIV2_METADATUM_HPP
@@ -14,20 +14,40 @@ namespace Exiv2 {
   @brief Parameters for the "decode" functions. There are a fairly large
   number of static "decode" functions. Examples are `ExifParser::decode`,
   `TiffParser::decode`, and `XmpParser::decode`. This class is a common
-  set of parameters for those functions. It currently only contains a
-  `max_recursion_depth_` field, but it will make it easier to add new
-  parameters in the future.
+  set of parameters for those functions, which makes it easier to add
+  new parameters in the future.
  */
 class EXIV2API DecodeParams {
  public:
-  explicit DecodeParams(size_t max_recursion_depth);
+  explicit DecodeParams(size_t max_recursion_depth, bool lazy_makernotes = false, bool native_xmp = false);
 
   size_t max_recursion_depth() const {
     return max_recursion_depth_;
   }
 
+  /*!
+    @brief If true, the TIFF decoder does not expand a makernote into
+           Exif tags right away. The ExifData container keeps the parsed
+           makernote and expands it when the metadata is first iterated
+           or a key of a makernote group is looked up.
+   */
+  bool lazy_makernotes() const {
+    return lazy_makernotes_;
+  }
+
+  /*!
+    @brief If true, `XmpParser::decode` reads packets that only use simple,
+           struct and array properties without the XMP toolkit. Any other
+           packet is still parsed by the toolkit, the result is the same.
+   */
+  bool native_xmp() const {
+    return native_xmp_;
+  }
+
  private:
   const size_t max_recursion_depth_;
+  const bool lazy_makernotes_;
+  const bool native_xmp_;
 };
 
 }  // namespace Exiv2
@@ -9,12 +9,29 @@
 // included header files
 #include "image.hpp"
 
+#include <string>
+#include <vector>
+
 // *****************************************************************************
 // namespace extensions
 namespace Exiv2 {
 // *****************************************************************************
 // class definitions
 
+//! The CRC check of a PNG chunk, see PngImage::setVerifyChunks().
+struct EXIV2API PngChunkCheck {
+  std::string type_;      //!< Chunk type, e.g. "IDAT".
+  size_t offset_{};       //!< Offset of the chunk in the file.
+  uint32_t length_{};     //!< Size of the chunk data.
+  uint32_t storedCrc_{};  //!< CRC stored in the file, 0 if the file ends before it.
+  uint32_t crc_{};        //!< CRC computed over the chunk type and data.
+
+  //! Return true if the stored CRC is correct.
+  [[nodiscard]] bool ok() const {
+    return storedCrc_ == crc_;
+  }
+};
+
 /*!
   @brief Class to access PNG images. Exif and IPTC metadata are supported
       directly.
@@ -52,11 +69,32 @@ class EXIV2API PngImage : public Image {
     @warning This function is not thread safe and intended for exiv2 -pS for debugging.
    */
   void printStructure(std::ostream& out, PrintStructureOption option, size_t depth) override;
+  /*!
+    @brief Set the maximum size of a compressed text chunk or ICC profile
+        after it is uncompressed, 16 MB by default. readMetadata() fails
+        on a text chunk which is larger and skips such an ICC profile.
+   */
+  void setMaxInflatedSize(size_t size);
+  /*!
+    @brief Set if readMetadata() checks the CRC of every chunk of the image,
+        off by default. The results are in chunkChecks(). Large chunks are
+        checked in pieces on several threads.
+   */
+  void setVerifyChunks(bool flag);
   //@}
 
   //! @name Accessors
   //@{
   [[nodiscard]] std::string mimeType() const override;
+  //! Return the maximum size of an uncompressed chunk, see setMaxInflatedSize().
+  [[nodiscard]] size_t maxInflatedSize() const;
+  //! Return true if readMetadata() checks the CRC of every chunk.
+  [[nodiscard]] bool verifyChunks() const;
+  /*!
+    @brief Return the CRC checks of the last readMetadata(), one for each
+        chunk in file order, if it checked them. Else an empty list.
+   */
+  [[nodiscard]] const std::vector<PngChunkCheck>& chunkChecks() const;
   //@}
 
  private:
@@ -71,6 +109,9 @@ class EXIV2API PngImage : public Image {
   //@}
 
   std::string profileName_;
+  size_t maxInflatedSize_{16 * 1024 * 1024};
+  bool verifyChunks_{false};
+  std::vector<PngChunkCheck> chunkChecks_;
 
 };  // class PngImage
 
@@ -10,12 +10,15 @@
 
 #include "types.hpp"
 
+#include <memory>
 #include <string>
 #include <vector>
 
 // *****************************************************************************
 // namespace extensions
 namespace Exiv2 {
+class BasicIo;
+class FileIo;
 class Image;
 // *****************************************************************************
 // class definitions
@@ -40,8 +43,13 @@ using PreviewPropertiesList = std::vector<PreviewProperties>;
 
 /*!
   @brief Class that holds preview image properties and data buffer.
+
+  A preview image returned by PreviewManager::getPreviewView() may be a view
+  of the preview image in the source file instead. It keeps its own mapping of
+  the file, which copies of the preview image share.
  */
 class EXIV2API PreviewImage {
+  friend class PreviewIndex;
   friend class PreviewManager;
 
  public:
@@ -74,6 +82,26 @@ class EXIV2API PreviewImage {
     @brief Return the size of the preview image in bytes.
    */
   [[nodiscard]] uint32_t size() const;
+  /*!
+    @brief Return true if the preview image is a view of a contiguous range
+           of the source file rather than a copy of the image data.
+   */
+  [[nodiscard]] bool isView() const;
+  /*!
+    @brief Return the offset of the preview image in the source file if it is
+           a view, else 0.
+   */
+  [[nodiscard]] size_t offset() const;
+  /*!
+    @brief Write the preview image to \em io at its current position.
+
+    If the preview image is a view and \em io is a FileIo, the data is copied
+    from file to file by the kernel where possible.
+
+    @param io BasicIo instance to write to, it must be open for writing.
+    @return The number of bytes written.
+  */
+  size_t writeTo(BasicIo& io) const;
 #ifdef EXV_ENABLE_FILESYSTEM
   /*!
     @brief Write the thumbnail image to a file.
@@ -114,9 +142,20 @@ class EXIV2API PreviewImage {
  private:
   //! Private constructor
   PreviewImage(PreviewProperties properties, DataBuf&& data);
+#ifdef EXV_ENABLE_FILESYSTEM
+  //! Private constructor for a view of \em size bytes at \em offset of \em source, mapped at \em mapped
+  PreviewImage(PreviewProperties properties, std::shared_ptr<FileIo> source, const byte* mapped, size_t offset,
+               size_t size);
+#endif
 
-  PreviewProperties properties_;  //!< Preview image properties
-  DataBuf preview_;               //!< Preview image data
+  PreviewProperties properties_;    //!< Preview image properties
+  DataBuf preview_;                 //!< Preview image data, empty for a view
+#ifdef EXV_ENABLE_FILESYSTEM
+  std::shared_ptr<FileIo> source_;  //!< Mapped source file of a view
+#endif
+  const byte* pView_{};             //!< Start of a view in the mapped source file
+  size_t offset_{};                 //!< Offset of a view in the source file
+  size_t viewSize_{};               //!< Size of a view
 
 };  // class PreviewImage
 
@@ -143,12 +182,95 @@ class EXIV2API PreviewManager {
     @brief Return the preview image for the given preview properties.
    */
   [[nodiscard]] PreviewImage getPreviewImage(const PreviewProperties& properties) const;
+  /*!
+    @brief Return the preview image for the given preview properties as a
+           view of the source file, without copying the image data.
+
+    Only preview images that are stored in one piece in a file can be
+    returned as a view. For all others, and if the library is built without
+    filesystem access, the result is the same as that of getPreviewImage().
+    The file is mapped once, on the first call, and the mapping is shared
+    by all views the manager returns. Do not call this method on the same
+    manager from several threads at once.
+   */
+  [[nodiscard]] PreviewImage getPreviewView(const PreviewProperties& properties) const;
+#ifdef EXV_ENABLE_FILESYSTEM
+  /*!
+    @brief Return an index of the preview images of an image read from a
+           file, to be stored and read with PreviewIndex later.
+
+    The index records the properties of each preview image, the location
+    of preview images stored in one piece, and the size, modification time
+    and a hash of the beginning of the file.
+
+    @throw Error if the image is not read from a file.
+   */
+  [[nodiscard]] DataBuf getPreviewIndex() const;
+#endif
   //@}
 
  private:
   const Image& image_;
+#ifdef EXV_ENABLE_FILESYSTEM
+  mutable std::shared_ptr<FileIo> source_;  //!< Mapped image file of the views
+  mutable const byte* mapped_{};            //!< Start of the mapping
+#endif
 
 };  // class PreviewManager
+
+#ifdef EXV_ENABLE_FILESYSTEM
+/*!
+  @brief Preview images of a file, read from an index that
+         PreviewManager::getPreviewIndex() created.
+
+  The index allows to list the preview images of a file and to read those
+  stored in one piece, without opening the file as an Image and reading its
+  metadata.
+ */
+class EXIV2API PreviewIndex {
+ public:
+  //! @name Constructors
+  //@{
+  /*!
+    @brief Read a preview index.
+    @throw Error if the data is not a preview index.
+   */
+  PreviewIndex(const byte* data, size_t size);
+  //@}
+
+  //! @name Accessors
+  //@{
+  /*!
+    @brief Return true if the file at \em path has the size, modification
+           time and beginning of the file that the index was created for.
+   */
+  [[nodiscard]] bool matches(const std::string& path) const;
+  /*!
+    @brief Return the properties of all preview images in the index, in the
+           order of PreviewManager::getPreviewProperties().
+   */
+  [[nodiscard]] const PreviewPropertiesList& getPreviewProperties() const;
+  /*!
+    @brief Return a view of the preview image for the given preview
+           properties in the file at \em path.
+
+    Check that the index matches() the file first. Preview images that are
+    not stored in one piece must be read with PreviewManager; for these,
+    the returned preview image is empty.
+   */
+  [[nodiscard]] PreviewImage getPreviewImage(const std::string& path, const PreviewProperties& properties) const;
+  //@}
+
+ private:
+  uint64_t fileSize_{};               //!< Size of the file
+  uint64_t modified_{};               //!< Modification time of the file
+  uint64_t hash_{};                   //!< Hash of the beginning of the file
+  PreviewPropertiesList properties_;  //!< Preview image properties
+  std::vector<uint64_t> offsets_;     //!< Offsets of the preview images stored in one piece
+  std::vector<bool> inPlace_;         //!< True for preview images stored in one piece
+
+};  // class PreviewIndex
+#endif
 }  // namespace Exiv2
 
 #endif  // EXIV2_PREVIEW_HPP
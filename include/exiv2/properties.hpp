@@ -250,6 +250,7 @@ class EXIV2API XmpProperties {
 
   // DATA
   static NsRegistry nsRegistry_;  //!< Namespace registry
+  static uint64_t nsGeneration_;  //!< Incremented by every change of nsRegistry_
 
   /*!
     @brief Get all registered namespaces (for both Exiv2 and XMPsdk)
@@ -26,6 +26,10 @@
 // included header files
 #include "image.hpp"
 
+// + standard includes
+#include <iterator>
+#include <vector>
+
 // *****************************************************************************
 // namespace extensions
 namespace Exiv2 {
@@ -33,6 +37,101 @@ namespace Exiv2 {
 // *****************************************************************************
 // class definitions
 
+//! A sample of a telemetry track, see TelemetryTrack.
+struct EXIV2API TelemetrySample {
+  double time_{};      //!< Time of the sample, in seconds from the start of the track.
+  double duration_{};  //!< Duration of the sample, in seconds.
+  uint64_t offset_{};  //!< Position of the sample in the file.
+  DataBuf data_;       //!< The sample as it is stored, e.g. GPMF data for a gpmd track.
+};
+
+/*!
+  @brief A track of GPS or other telemetry samples of a QuickTime video, see
+      QuickTimeVideo::telemetryTracks(). Iterating over the track reads one
+      sample at a time from the video, the IO of which must stay valid. If
+      the IO is not open, it is opened and closed again for each sample, so
+      callers which read many samples may keep it open meanwhile.
+ */
+class EXIV2API TelemetryTrack {
+ public:
+  //! Input iterator over the samples of the track.
+  class EXIV2API const_iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = TelemetrySample;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const TelemetrySample*;
+    using reference = const TelemetrySample&;
+
+    const_iterator() = default;
+    reference operator*() const {
+      return sample_;
+    }
+    pointer operator->() const {
+      return &sample_;
+    }
+    //! Read the next sample.
+    const_iterator& operator++();
+    //! Read the next sample, return the iterator at the sample before.
+    const_iterator operator++(int) {
+      auto previous = *this;
+      ++*this;
+      return previous;
+    }
+    bool operator==(const const_iterator& other) const {
+      return track_ == other.track_ && index_ == other.index_;
+    }
+
+   private:
+    friend class TelemetryTrack;
+    const_iterator(const TelemetryTrack* track, size_t index);
+
+    const TelemetryTrack* track_{};
+    size_t index_{};
+    TelemetrySample sample_;
+  };
+
+  //! Where a sample is and when it is, in units of the time scale of the track.
+  struct Entry {
+    uint64_t offset_;
+    uint32_t size_;
+    uint32_t duration_;
+    uint64_t time_;
+  };
+
+  //! @name Creators
+  //@{
+  TelemetryTrack(BasicIo& io, std::string format, uint32_t trackId, uint32_t timeScale, std::vector<Entry> entries);
+  //@}
+
+  //! @name Accessors
+  //@{
+  //! Sample format of the track: "gpmd", "camm", "rtmd", or "gps " for the Novatek gps atom.
+  [[nodiscard]] const std::string& format() const {
+    return format_;
+  }
+  //! Track ID, 0 for the Novatek gps atom.
+  [[nodiscard]] uint32_t trackId() const {
+    return trackId_;
+  }
+  //! Number of samples of the track.
+  [[nodiscard]] size_t size() const {
+    return entries_.size();
+  }
+  //! Read the sample at \em index from the video.
+  [[nodiscard]] TelemetrySample sample(size_t index) const;
+  [[nodiscard]] const_iterator begin() const;
+  [[nodiscard]] const_iterator end() const;
+  //@}
+
+ private:
+  BasicIo* io_;
+  std::string format_;
+  uint32_t trackId_;
+  uint32_t timeScale_;
+  std::vector<Entry> entries_;
+};
+
 /*!
   @brief Class to access QuickTime video files.
  */
@@ -58,12 +157,50 @@ class EXIV2API QuickTimeVideo : public Image {
   //! @name Manipulators
   //@{
   void readMetadata() override;
+  /*!
+    @brief Write the XMP metadata to the moov atom and the XMP uuid atom,
+        nothing else of the file is rewritten. The XMP packet holds all
+        properties except the Xmp.video and Xmp.audio properties, which are
+        read from the atoms of the movie. Those which QuickTime stores as
+        user data text atoms, like Xmp.video.Title in the ©nam atom, are
+        written to these atoms.
+
+        Files with the "qt  " major brand keep the packet in the XMP_ atom of
+        the user data. ISO base media files, like MP4, keep it in a top-level
+        uuid atom with the XMP UUID, written right after the moov atom. Any
+        other XMP uuid atom, and every one in a QuickTime file, becomes a
+        free atom.
+
+        The new moov atom, and the uuid atom of an ISO file, replace the old
+        moov atom if they fit, together with the free, skip and XMP uuid
+        atoms after it. Else they are written at the end of the file if no
+        media data follows, and otherwise the file is rewritten with the
+        chunk offsets of the stco and co64 tables adjusted.
+   */
   void writeMetadata() override;
+  /*!
+    @brief Set if readMetadata() decodes only the summary of the sample
+        tables, off by default. The frame rate is then computed from the
+        sample count in the stsz header and the media duration, the entries
+        of the stts table are skipped and only the first sample description
+        of each track is decoded. This bounds the cost of long recordings.
+   */
+  void setSummarizeSampleTables(bool flag);
   //@}
 
   //! @name Accessors
   //@{
   [[nodiscard]] std::string mimeType() const override;
+  //! Return true if readMetadata() decodes only the summary of the sample tables.
+  [[nodiscard]] bool summarizeSampleTables() const;
+  /*!
+    @brief Return the telemetry tracks of the video which readMetadata() read:
+        timed metadata tracks in gpmd, camm or rtmd format and the GPS data
+        the Novatek gps atom of the user data refers to. The moov atom is
+        read once, the samples are read as the tracks are iterated over and
+        located with the stco or co64, stsc, stsz and stts tables.
+   */
+  [[nodiscard]] std::vector<TelemetryTrack> telemetryTracks() const;
   //@}
 
  protected:
@@ -141,6 +278,11 @@ class EXIV2API QuickTimeVideo : public Image {
     @param outer_size Size of the data block used to store Tag Information.
    */
   void userDataDecoder(size_t outer_size, size_t recursion_depth);
+  /*!
+    @brief Interpret an XMP packet, and save it in the XMP container.
+    @param size Size of the XMP packet.
+   */
+  void xmpPacketDecoder(size_t size);
   /*!
     @brief Interpret Preview Tag, and save it
         in the respective XMP container.
@@ -179,8 +321,16 @@ class EXIV2API QuickTimeVideo : public Image {
   /*!
     @brief Helps to calculate Frame Rate from timeToSample chunk,
         and save it in the respective XMP container.
+    @param size Size of the data block used to store Tag Information.
+   */
+  void timeToSampleDecoder(size_t size);
+  /*!
+    @brief Calculate the Frame Rate from the sample count in the header of
+        the sample size chunk and the media duration, and save it in the
+        respective XMP container.
+    @param size Size of the data block used to store Tag Information.
    */
-  void timeToSampleDecoder();
+  void sampleSizeDecoder(size_t size);
   /*!
     @brief Recognizes which stream is currently under processing,
         and save its information in currentStream_ .
@@ -199,6 +349,13 @@ class EXIV2API QuickTimeVideo : public Image {
   uint64_t mvhdTimeScale_ = 0;
   //! Variable which stores Time Scale unit retrieved from mdhd box, used to calculate time.
   uint64_t mdhdTimeScale_ = 0;
+  //! Variable which stores the duration retrieved from mdhd box, in mdhdTimeScale_ units.
+  uint64_t mdhdDuration_ = 0;
+  //! Variable which stores if only the summary of the sample tables is decoded.
+  bool summarizeSampleTables_ = false;
+  //! Variables which store the position and the size of the payload of the moov atom.
+  uint64_t moovPos_ = 0;
+  size_t moovSize_ = 0;
   //! Variable which stores current stream being processed.
   int currentStream_ = 0;
   //! Variable to check the end of metadata traversing.
@@ -61,7 +61,11 @@ class EXIV2API RiffVideo : public Image {
     }
   };
 
-  void readList(const HeaderReader& header_);
+  /*!
+  @brief Interpret a LIST chunk.
+  @return true if the chunks of the list are to be walked next, false if the list has been decoded or skipped.
+ */
+  bool readList(const HeaderReader& header_);
 
   void readChunk(const HeaderReader& header_);
 
@@ -13,7 +13,9 @@
 #include "properties.hpp"
 
 #include <atomic>
+#include <limits>
 #include <map>
+#include <unordered_map>
 
 // *****************************************************************************
 // namespace extensions
@@ -49,6 +51,8 @@ class EXIV2API Xmpdatum : public Metadatum {
   explicit Xmpdatum(const XmpKey& key, const Value* pValue = nullptr);
   //! Copy constructor
   Xmpdatum(const Xmpdatum& rhs);
+  //! Move constructor, leaves \em rhs empty: it may only be assigned to or destroyed
+  Xmpdatum(Xmpdatum&& rhs) noexcept;
   //! Destructor
   ~Xmpdatum() override;
   //@}
@@ -57,6 +61,8 @@ class EXIV2API Xmpdatum : public Metadatum {
   //@{
   //! Assignment operator
   Xmpdatum& operator=(const Xmpdatum& rhs);
+  //! Move assignment operator, swaps the key and value with those of \em rhs
+  Xmpdatum& operator=(Xmpdatum&& rhs) noexcept;
   /*!
     @brief Assign std::string \em value to the %Xmpdatum.
            Calls setValue(const std::string&).
@@ -186,7 +192,7 @@ class EXIV2API XmpData {
   void clear();
   //! Sort metadata by key
   void sortByKey();
-  //! Begin of the metadata
+  //! Begin of the metadata, counts as a change of all entries, see ChangeLog, and of their keys
   iterator begin();
   //! End of the metadata
   iterator end();
@@ -212,6 +218,8 @@ class EXIV2API XmpData {
   [[nodiscard]] bool empty() const;
   //! Get the number of metadata entries
   [[nodiscard]] long count() const;
+  //! Return the current generation of the metadata, see ChangeLog
+  [[nodiscard]] uint64_t generation() const;
 
   //! are we to use the packet?
   [[nodiscard]] bool usePacket() const {
@@ -243,6 +251,16 @@ class EXIV2API XmpData {
   bool usePacket_{};
   //! Per-instance prefix-to-URI namespace bindings, see nsBindings().
   std::map<std::string, std::string> nsBindings_;
+  //! Position of the first Xmpdatum with each key, for the first keyIndexed_ entries, see findUnlocked().
+  mutable std::unordered_map<std::string, size_t> keyIndex_;
+  //! Number of entries in keyIndex_
+  mutable size_t keyIndexed_{};
+  //! keyIndex_ must be rebuilt: entries were erased or reordered, or a mutable iterator was handed out
+  mutable bool keyIndexStale_{};
+  //! Position of the entry operator[] or findKey() handed out last, whose key may have been changed through it
+  mutable size_t keyIndexLent_{std::numeric_limits<size_t>::max()};
+  //! Changes of the metadata, for the incremental conversions
+  ChangeLog changes_;
 
   /*!
     @brief Namespace prefix-to-URI bindings captured from this object's own
@@ -268,7 +286,19 @@ class EXIV2API XmpData {
   long countUnlocked(const XmpProperties::XmpLock&) const;
   void sortByKeyUnlocked(const XmpProperties::XmpLock&);
   void clearUnlocked(const XmpProperties::XmpLock&);
+  /*!
+    @brief Return the position of the first Xmpdatum with \em key, or the
+           number of entries if there is none. Brings the hashed key index
+           up to date first: entries appended since the last call are added,
+           it is rebuilt if it is stale or the key of the entry handed out
+           last changed. It is also rebuilt if the entry found no longer has
+           \em key, which was changed through another reference.
+   */
+  size_t findUnlocked(const std::string& key, const XmpProperties::XmpLock&) const;
+  //! Mark the key index stale, for changes other than appending entries
+  void resetKeyIndex();
   friend class XmpParser;
+  friend class Converter;
 };  // class XmpData
 
 /*!
@@ -286,7 +316,8 @@ class EXIV2API XmpParser {
     includeThumbnailPad = 0x0100UL,  //!< Include a padding allowance for a thumbnail image.
     exactPacketLength = 0x0200UL,    //!< The padding parameter is the overall packet length.
     writeAliasComments = 0x0400UL,   //!< Show aliases as XML comments.
-    omitAllFormatting = 0x0800UL     //!< Omit all formatting whitespace.
+    omitAllFormatting = 0x0800UL,    //!< Omit all formatting whitespace.
+    useNativeSerializer = 0x1000UL   //!< Serialize simple packets without the XMP toolkit, with the same result.
   };
   /*!
     @brief Decode XMP metadata from an XMP packet \em xmpPacket into
@@ -312,7 +343,9 @@ class EXIV2API XmpParser {
                        packet.
     @param xmpData     XMP properties to encode.
     @param formatFlags Flags that control the format of the XMP packet,
-                       see enum XmpFormatFlags.
+                       see enum XmpFormatFlags. With useNativeSerializer,
+                       a compact packet of simple, struct and array
+                       properties is written without the XMP toolkit.
     @param padding     Padding length.
     @return 0 if successful;<BR>
             1 if XMP support has not been compiled-in;<BR>
@@ -362,7 +395,8 @@ class EXIV2API XmpParser {
 
   /*!
     @brief Register a namespace with the XMP Toolkit without locking.
-           Assumes the lock obtained via XmpProperties::XmpLock is already held by caller.
+           Assumes the lock obtained via XmpProperties::XmpLock is already held by caller,
+           and the lock of the toolkit's namespace bindings exclusively, see registerNs().
    */
   static void registerNsImpl(const std::string& ns, const std::string& prefix);
 
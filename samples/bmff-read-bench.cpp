@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// BMFF read benchmark: bytes read and time per readMetadata() of HEIF, AVIF, CR3 and JXL files
+
+#include <exiv2/exiv2.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+// Memory io which counts what is read from it
+class CountingIo : public Exiv2::MemIo {
+ public:
+  CountingIo(const Exiv2::byte* data, size_t size) : Exiv2::MemIo(data, size) {
+  }
+
+  Exiv2::DataBuf read(size_t rcount) override {
+    Exiv2::DataBuf buf = Exiv2::MemIo::read(rcount);
+    ++reads_;
+    bytes_ += buf.size();
+    return buf;
+  }
+
+  size_t read(Exiv2::byte* buf, size_t rcount) override {
+    const size_t n = Exiv2::MemIo::read(buf, rcount);
+    ++reads_;
+    bytes_ += n;
+    return n;
+  }
+
+  int getb() override {
+    ++reads_;
+    ++bytes_;
+    return Exiv2::MemIo::getb();
+  }
+
+  size_t reads_{0};
+  size_t bytes_{0};
+};
+}  // namespace
+
+int main(int argc, char* const argv[]) {
+  try {
+    int rounds = 200;
+    int first = 1;
+    while (first + 1 < argc && argv[first][0] == '-') {
+      const std::string opt(argv[first]);
+      if (opt == "-n")
+        rounds = std::max(1, std::atoi(argv[first + 1]));
+      else
+        break;
+      first += 2;
+    }
+    if (first >= argc || argv[first][0] == '-') {
+      std::cout << "Usage: " << argv[0] << " [-n rounds] file...\n";
+      std::cout << "Reads the metadata of each file from memory [rounds] times (default 200) and reports\n"
+                << "the bytes and the number of reads it took, and the time per readMetadata().\n";
+      return EXIT_FAILURE;
+    }
+
+    for (int i = first; i < argc; ++i) {
+      Exiv2::FileIo file(argv[i]);
+      if (file.open() != 0) {
+        std::cerr << argv[i] << ": failed to open the file\n";
+        return EXIT_FAILURE;
+      }
+      const Exiv2::DataBuf data = file.read(file.size());
+      file.close();
+
+      size_t bytes = 0;
+      size_t reads = 0;
+      const auto start = Clock::now();
+      for (int r = 0; r < rounds; ++r) {
+        auto io = std::make_unique<CountingIo>(data.c_data(), data.size());
+        auto& counter = *io;
+        auto image = Exiv2::ImageFactory::open(std::move(io));
+        image->readMetadata();
+        bytes = counter.bytes_;
+        reads = counter.reads_;
+      }
+      const auto us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+
+      std::cout << "file:        " << argv[i] << "\n"
+                << "size:        " << data.size() << " bytes\n"
+                << "read:        " << bytes << " bytes in " << reads << " reads\n"
+                << "time:        " << static_cast<double>(us) / rounds << " us per readMetadata\n";
+    }
+    return EXIT_SUCCESS;
+  } catch (Exiv2::Error& e) {
+    std::cout << "Caught Exiv2 exception '" << e.what() << "'\n";
+    return EXIT_FAILURE;
+  }
+}
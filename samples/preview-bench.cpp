@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Preview benchmark: list the preview images of files like "exiv2 -pp" does
+
+#include <exiv2/exiv2.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static long long elapsedUs(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+}
+
+int main(int argc, char* const argv[]) {
+  try {
+    int runs = 20;
+    int first = 1;
+    if (argc > 2 && std::string(argv[1]) == "-n") {
+      runs = std::max(1, std::atoi(argv[2]));
+      first = 3;
+    }
+    if (first >= argc) {
+      std::cout << "Usage: " << argv[0] << " [-n runs] file...\n";
+      std::cout << "Reads the metadata of each file once and lists its preview images [runs] times (default 20).\n"
+                << "Reports the time to list the previews of all files.\n";
+      return EXIT_FAILURE;
+    }
+
+    std::vector<Exiv2::Image::UniquePtr> images;
+    for (int i = first; i < argc; ++i) {
+      // Skip files that exiv2 -pp would report an error for
+      try {
+        auto image = Exiv2::ImageFactory::open(argv[i]);
+        image->readMetadata();
+        (void)Exiv2::PreviewManager(*image).getPreviewProperties();
+        images.push_back(std::move(image));
+      } catch (Exiv2::Error& e) {
+        std::cerr << argv[i] << ": skipped, " << e.what() << "\n";
+      }
+    }
+    if (images.empty())
+      return EXIT_FAILURE;
+
+    size_t previews = 0;
+    size_t bytes = 0;
+    std::vector<long long> times;
+    for (int i = 0; i < runs; ++i) {
+      previews = 0;
+      bytes = 0;
+      const auto start = Clock::now();
+      for (auto&& image : images) {
+        Exiv2::PreviewManager manager(*image);
+        for (auto&& properties : manager.getPreviewProperties()) {
+          ++previews;
+          bytes += properties.size_;
+        }
+      }
+      times.push_back(elapsedUs(start));
+    }
+    std::sort(times.begin(), times.end());
+    std::cout << "files:       " << images.size() << "\n"
+              << "previews:    " << previews << " (" << bytes << " bytes)\n"
+              << "runs:        " << runs << "\n"
+              << "min (us):    " << times.front() << "\n"
+              << "median (us): " << times[times.size() / 2] << "\n"
+              << "max (us):    " << times.back() << "\n";
+    return EXIT_SUCCESS;
+  } catch (Exiv2::Error& e) {
+    std::cout << "Caught Exiv2 exception '" << e.what() << "'\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Startup benchmark: library load and static initialization plus the first readMetadata()
+
+#include <exiv2/exiv2.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static long long elapsedUs(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+}
+
+// Time from entering main() to the end of the first readMetadata() in this process.
+static int firstRead(const char* path) {
+  const auto start = Clock::now();
+  auto image = Exiv2::ImageFactory::open(path);
+  image->readMetadata();
+  std::cout << elapsedUs(start) << "\n";
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char* const argv[]) {
+  try {
+    if (argc == 3 && std::string(argv[1]) == "--first-read") {
+      return firstRead(argv[2]);
+    }
+    if (argc < 2 || argc > 3) {
+      std::cout << "Usage: " << argv[0] << " file [runs]\n";
+      std::cout << "Runs this program in a new process [runs] times (default 20) and reports the wall time\n"
+                << "to load libexiv2 and read the metadata of file once.\n";
+      return EXIT_FAILURE;
+    }
+    const char* path = argv[1];
+    const int runs = argc == 3 ? std::max(1, std::atoi(argv[2])) : 20;
+    const std::string cmd = std::string("\"") + argv[0] + "\" --first-read \"" + path + "\" > " +
+#ifdef _WIN32
+                            "NUL";
+#else
+                            "/dev/null";
+#endif
+
+    std::vector<long long> times;
+    for (int i = 0; i < runs; ++i) {
+      const auto start = Clock::now();
+      if (std::system(cmd.c_str()) != 0) {
+        std::cerr << "Child process failed: " << cmd << "\n";
+        return EXIT_FAILURE;
+      }
+      times.push_back(elapsedUs(start));
+    }
+    std::sort(times.begin(), times.end());
+    std::cout << "runs:        " << runs << "\n"
+              << "min (us):    " << times.front() << "\n"
+              << "median (us): " << times[times.size() / 2] << "\n"
+              << "max (us):    " << times.back() << "\n";
+    return EXIT_SUCCESS;
+  } catch (Exiv2::Error& e) {
+    std::cout << "Caught Exiv2 exception '" << e.what() << "'\n";
+    return EXIT_FAILURE;
+  }
+}
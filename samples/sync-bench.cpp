@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Exif and XMP sync benchmark: syncExifWithXmp() on the Exif data of files
+
+#include <exiv2/exiv2.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+// Run op rounds times, return the time per round in us
+double timePerRound(int rounds, const std::function<void()>& op) {
+  const auto start = Clock::now();
+  for (int i = 0; i < rounds; ++i)
+    op();
+  const auto us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+  return static_cast<double>(us) / rounds;
+}
+}  // namespace
+
+int main(int argc, char* const argv[]) {
+  try {
+    int rounds = 500;
+    int first = 1;
+    while (first + 1 < argc && argv[first][0] == '-') {
+      const std::string opt(argv[first]);
+      if (opt == "-n")
+        rounds = std::max(1, std::atoi(argv[first + 1]));
+      else
+        break;
+      first += 2;
+    }
+    if (first >= argc || argv[first][0] == '-') {
+      std::cout << "Usage: " << argv[0] << " [-n rounds] file...\n";
+      std::cout << "Syncs the Exif data of each file with XMP [rounds] times (default 500), once into\n"
+                << "empty XMP, once into XMP which is up to date and once into XMP after Exif changed,\n"
+                << "and reports the time per sync.\n";
+      return EXIT_FAILURE;
+    }
+
+    for (int i = first; i < argc; ++i) {
+      auto image = Exiv2::ImageFactory::open(argv[i]);
+      image->readMetadata();
+      const Exiv2::ExifData exifData = image->exifData();
+      if (exifData.empty()) {
+        std::cerr << argv[i] << ": no Exif data\n";
+        continue;
+      }
+      // XMP with the digests of the Exif data
+      Exiv2::ExifData synced = exifData;
+      Exiv2::XmpData xmpData;
+      Exiv2::syncExifWithXmp(synced, xmpData);
+      // XMP with digests which do not match
+      Exiv2::XmpData stale = xmpData;
+      stale["Xmp.tiff.NativeDigest"] = "0;0";
+
+      const double copy = timePerRound(rounds, [&] {
+        Exiv2::ExifData exif = exifData;
+        Exiv2::XmpData xmp = xmpData;
+      });
+      const double empty = timePerRound(rounds, [&] {
+        Exiv2::ExifData exif = exifData;
+        Exiv2::XmpData xmp;
+        Exiv2::syncExifWithXmp(exif, xmp);
+      });
+      const double upToDate = timePerRound(rounds, [&] {
+        Exiv2::ExifData exif = exifData;
+        Exiv2::XmpData xmp = xmpData;
+        Exiv2::syncExifWithXmp(exif, xmp);
+      });
+      const double changed = timePerRound(rounds, [&] {
+        Exiv2::ExifData exif = exifData;
+        Exiv2::XmpData xmp = stale;
+        Exiv2::syncExifWithXmp(exif, xmp);
+      });
+
+      std::cout << "file:        " << argv[i] << "\n"
+                << "exif:        " << exifData.count() << " tags\n"
+                << "xmp:         " << xmpData.count() << " properties\n"
+                << "rounds:      " << rounds << "\n"
+                << "copy:        " << copy << " us\n"
+                << "sync:        " << empty << " us empty, " << upToDate << " us up to date, " << changed
+                << " us changed\n";
+    }
+    return EXIT_SUCCESS;
+  } catch (Exiv2::Error& e) {
+    std::cout << "Caught Exiv2 exception '" << e.what() << "'\n";
+    return EXIT_FAILURE;
+  }
+}
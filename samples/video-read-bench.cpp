@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Video read benchmark: bytes read and time per readMetadata() of large AVI and ASF files
+
+#include <exiv2/exiv2.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+// Memory io which counts what is read from it
+class CountingIo : public Exiv2::MemIo {
+ public:
+  CountingIo(const Exiv2::byte* data, size_t size) : Exiv2::MemIo(data, size) {
+  }
+
+  Exiv2::DataBuf read(size_t rcount) override {
+    Exiv2::DataBuf buf = Exiv2::MemIo::read(rcount);
+    ++reads_;
+    bytes_ += buf.size();
+    return buf;
+  }
+
+  size_t read(Exiv2::byte* buf, size_t rcount) override {
+    const size_t n = Exiv2::MemIo::read(buf, rcount);
+    ++reads_;
+    bytes_ += n;
+    return n;
+  }
+
+  int getb() override {
+    ++reads_;
+    ++bytes_;
+    return Exiv2::MemIo::getb();
+  }
+
+  size_t reads_{0};
+  size_t bytes_{0};
+};
+
+std::string le16(uint16_t v) {
+  return {static_cast<char>(v & 0xff), static_cast<char>(v >> 8)};
+}
+
+std::string le32(uint32_t v) {
+  return le16(static_cast<uint16_t>(v)) + le16(static_cast<uint16_t>(v >> 16));
+}
+
+std::string le64(uint64_t v) {
+  return le32(static_cast<uint32_t>(v)) + le32(static_cast<uint32_t>(v >> 32));
+}
+
+std::string chunk(const std::string& id, const std::string& payload) {
+  std::string c = id + le32(static_cast<uint32_t>(payload.size())) + payload;
+  if (payload.size() % 2)
+    c += '\0';
+  return c;
+}
+
+std::string list(const std::string& id, const std::string& type, const std::string& chunks) {
+  return chunk(id, type + chunks);
+}
+
+// An OpenDML AVI file as cameras and muxers write it: the headers with room reserved for the
+// stream indexes, the INFO list, [megabytes] of frames split over two RIFF chunks, and idx1
+std::string makeAvi(size_t megabytes) {
+  const uint32_t frameSize = 64 * 1024;
+  const uint32_t frames = static_cast<uint32_t>(megabytes * 1024 * 1024 / frameSize);
+
+  std::string avih = le32(40000) + le32(frameSize * 25) + le32(0) + le32(0x10) + le32(frames) + le32(0) + le32(2) +
+                     le32(frameSize) + le32(1920) + le32(1080) + std::string(16, '\0');
+  std::string vids = "vids" + std::string("MJPG") + le32(0) + le16(0) + le16(0) + le32(0) + le32(1) + le32(25) +
+                     le32(0) + le32(frames) + le32(frameSize) + le32(0xffffffff) + le32(0) + std::string(8, '\0');
+  std::string bitmap = le32(40) + le32(1920) + le32(1080) + le16(1) + le16(24) + "MJPG" + le32(1920 * 1080 * 3) +
+                       le32(0) + le32(0) + le32(0) + le32(0);
+  std::string auds = "auds" + std::string(4, '\0') + le32(0) + le16(0) + le16(0) + le32(0) + le32(1) + le32(48000) +
+                     le32(0) + le32(0) + le32(0) + le32(0xffffffff) + le32(4) + std::string(8, '\0');
+  std::string wave = le16(1) + le16(2) + le32(48000) + le32(192000) + le16(4) + le16(16) + le16(0);
+  const std::string reserved = chunk("JUNK", std::string(4096, '\0'));
+  std::string hdrl = chunk("avih", avih) +
+                     list("LIST", "strl", chunk("strh", vids) + chunk("strf", bitmap) + reserved) +
+                     list("LIST", "strl", chunk("strh", auds) + chunk("strf", wave) + reserved);
+  std::string info = chunk("ISFT", "video-read-bench") + chunk("IDIT", "Sat Oct 18 12:00:00 2026") +
+                     chunk("INAM", "A large AVI file");
+
+  const std::string frame = chunk("00dc", std::string(frameSize, '\x55'));
+  std::string movi;
+  std::string avix;
+  std::string idx1;
+  for (uint32_t i = 0; i < frames; ++i) {
+    if (i < frames / 2) {
+      idx1 += "00dc" + le32(0x10) + le32(static_cast<uint32_t>(4 + movi.size())) + le32(frameSize);
+      movi += frame;
+    } else {
+      avix += frame;
+    }
+  }
+  return list("RIFF", "AVI ",
+              list("LIST", "hdrl", hdrl) + chunk("JUNK", std::string(2048, '\0')) + list("LIST", "INFO", info) +
+                  list("LIST", "movi", movi) + chunk("idx1", idx1)) +
+         list("RIFF", "AVIX", list("LIST", "movi", avix));
+}
+
+std::string guid(uint32_t d1, uint16_t d2, uint16_t d3, uint64_t d4) {
+  std::string g = le32(d1) + le16(d2) + le16(d3);
+  for (int shift = 56; shift >= 0; shift -= 8)
+    g += static_cast<char>((d4 >> shift) & 0xff);
+  return g;
+}
+
+std::string object(const std::string& id, const std::string& payload) {
+  return id + le64(24 + payload.size()) + payload;
+}
+
+std::string wchars(const std::string& s) {
+  std::string w;
+  for (char c : s)
+    w += std::string(1, c) + '\0';
+  return w + std::string(2, '\0');
+}
+
+// An ASF file with the objects of a Windows Media header, padding, [megabytes] of data packets and a simple index
+std::string makeAsf(size_t megabytes) {
+  const uint32_t packetSize = 8 * 1024;
+  const uint64_t packets = megabytes * 1024 * 1024 / packetSize;
+  const std::string fileId = guid(0x01234567, 0x89ab, 0xcdef, 0x0123456789abcdefULL);
+
+  const std::string fileProperties = object(
+      guid(0x8CABDCA1, 0xA947, 0x11CF, 0x8EE400C00C205365ULL),
+      fileId + le64(0) + le64(116444736000000000ULL) + le64(packets) + le64(600000000) + le64(600000000) +
+          le64(3000) + le32(2) + le32(packetSize) + le32(packetSize) + le32(packetSize * 8 * 25));
+  const std::string bitmap = le32(40) + le32(1280) + le32(720) + le16(1) + le16(24) + "WMV3" + le32(0) + le32(0) +
+                             le32(0) + le32(0) + le32(0);
+  const std::string video = le32(1280) + le32(720) + '\x02' + le16(40) + bitmap;
+  const std::string streamProperties = object(
+      guid(0xB7DC0791, 0xA9B7, 0x11CF, 0x8EE600C00C205365ULL),
+      guid(0xBC19EFC0, 0x5B4D, 0x11CF, 0xA8FD00805F5C442BULL) +
+          guid(0x20FB5700, 0x5B55, 0x11CF, 0xA8FD00805F5C442BULL) + le64(0) +
+          le32(static_cast<uint32_t>(video.size())) + le32(0) + le16(1) + le32(0) + video);
+  const std::string title = wchars("A large ASF file");
+  const std::string author = wchars("video-read-bench");
+  const std::string contentDescription =
+      object(guid(0x75B22633, 0x668E, 0x11CF, 0xA6D900AA0062CE6CULL),
+             le16(static_cast<uint16_t>(title.size())) + le16(static_cast<uint16_t>(author.size())) + le16(0) +
+                 le16(0) + le16(0) + title + author);
+  const std::string headerExtension = object(guid(0x5FBF03B5, 0xA92E, 0x11CF, 0x8EE300C00C205365ULL),
+                                             guid(0xABD3D211, 0xA9BA, 0x11CF, 0x8EE600C00C205365ULL) + le16(6) +
+                                                 le32(0));
+  const std::string padding =
+      object(guid(0x1806D474, 0xCADF, 0x4509, 0xA4BA9AABCB96AAE8ULL), std::string(16 * 1024, '\0'));
+
+  const std::string children = fileProperties + headerExtension + streamProperties + contentDescription + padding;
+  const std::string header = object(guid(0x75B22630, 0x668E, 0x11CF, 0xA6D900AA0062CE6CULL),
+                                    le32(5) + '\x01' + '\x02' + children);
+
+  std::string data = fileId + le64(packets) + le16(0x0101);
+  data.reserve(data.size() + packets * packetSize);
+  for (uint64_t i = 0; i < packets; ++i)
+    data += std::string(packetSize, '\x55');
+  std::string index = fileId + le64(10000000) + le32(1) + le32(static_cast<uint32_t>(packets / 25));
+  for (uint64_t i = 0; i < packets / 25; ++i)
+    index += le32(static_cast<uint32_t>(i * 25)) + le16(1);
+
+  return header + object(guid(0x75B22636, 0x668E, 0x11CF, 0xA6D900AA0062CE6CULL), data) +
+         object(guid(0x33000890, 0xE5B1, 0x11CF, 0x89F400A0C90349CBULL), index);
+}
+
+void report(const char* name, const std::string& file, int rounds) {
+  size_t bytes = 0;
+  size_t reads = 0;
+  std::cout << name << file.size() << " bytes, ";
+  try {
+    const auto start = Clock::now();
+    for (int r = 0; r < rounds; ++r) {
+      auto io = std::make_unique<CountingIo>(reinterpret_cast<const Exiv2::byte*>(file.data()), file.size());
+      auto& counter = *io;
+      auto image = Exiv2::ImageFactory::open(std::move(io));
+      image->readMetadata();
+      bytes = counter.bytes_;
+      reads = counter.reads_;
+    }
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    std::cout << "read " << bytes << " bytes in " << reads << " reads, " << static_cast<double>(us) / rounds
+              << " us per readMetadata\n";
+  } catch (Exiv2::Error& e) {
+    std::cout << "failed: " << e.what() << "\n";
+  }
+}
+}  // namespace
+
+int main(int argc, char* const argv[]) {
+  try {
+    int rounds = 200;
+    size_t megabytes = 256;
+    int first = 1;
+    while (first + 1 < argc && argv[first][0] == '-') {
+      const std::string opt(argv[first]);
+      if (opt == "-n")
+        rounds = std::max(1, std::atoi(argv[first + 1]));
+      else if (opt == "-s")
+        megabytes = std::max(1, std::atoi(argv[first + 1]));
+      else
+        break;
+      first += 2;
+    }
+    if (first < argc) {
+      std::cout << "Usage: " << argv[0] << " [-n rounds] [-s megabytes]\n";
+      std::cout << "Writes an AVI and an ASF file with [megabytes] (default 256) of media data to memory, reads\n"
+                << "their metadata [rounds] times (default 200) and reports the bytes and the number of reads\n"
+                << "it took, and the time per readMetadata().\n";
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "rounds:      " << rounds << "\n";
+    report("AVI:         ", makeAvi(megabytes), rounds);
+    report("ASF:         ", makeAsf(megabytes), rounds);
+    return EXIT_SUCCESS;
+  } catch (Exiv2::Error& e) {
+    std::cout << "Caught Exiv2 exception '" << e.what() << "'\n";
+    return EXIT_FAILURE;
+  }
+}
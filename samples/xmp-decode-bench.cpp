@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// XMP decode benchmark: XmpParser::decode() of the same packet on 1, 2, 4, ... threads
+
+#include <exiv2/exiv2.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static long long elapsedUs(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+}
+
+// Wall time for threads threads to decode the packet decodes times each
+static long long run(const std::string& packet, unsigned threads, int decodes) {
+  std::vector<std::thread> workers;
+  const auto start = Clock::now();
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([&packet, decodes] {
+      const Exiv2::DecodeParams dp(500);
+      for (int i = 0; i < decodes; ++i) {
+        Exiv2::XmpData xmpData;
+        Exiv2::XmpParser::decode(xmpData, packet, dp);
+      }
+    });
+  }
+  for (auto&& worker : workers)
+    worker.join();
+  return elapsedUs(start);
+}
+
+int main(int argc, char* const argv[]) {
+  try {
+    int decodes = 200;
+    unsigned maxThreads = std::max(1U, std::thread::hardware_concurrency());
+    int first = 1;
+    while (first + 1 < argc && argv[first][0] == '-') {
+      const std::string opt(argv[first]);
+      if (opt == "-n")
+        decodes = std::max(1, std::atoi(argv[first + 1]));
+      else if (opt == "-t")
+        maxThreads = static_cast<unsigned>(std::max(1, std::atoi(argv[first + 1])));
+      else
+        break;
+      first += 2;
+    }
+    if (first + 1 != argc) {
+      std::cout << "Usage: " << argv[0] << " [-n decodes] [-t threads] file\n";
+      std::cout << "Decodes the XMP packet of file [decodes] times (default 200) on each of 1, 2, 4, ... up to\n"
+                << "[threads] threads (default: the number of hardware threads) and reports the throughput.\n";
+      return EXIT_FAILURE;
+    }
+
+    auto image = Exiv2::ImageFactory::open(argv[first]);
+    image->readMetadata();
+    const std::string packet = image->xmpPacket();
+    if (packet.empty()) {
+      std::cerr << argv[first] << ": no XMP packet\n";
+      return EXIT_FAILURE;
+    }
+
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2)
+      counts.push_back(threads);
+    counts.push_back(maxThreads);
+
+    std::cout << "packet:   " << packet.size() << " bytes\n"
+              << "decodes:  " << decodes << " per thread\n"
+              << "threads   time (us)   decodes/s   speedup\n";
+    double single = 0;
+    for (unsigned threads : counts) {
+      const auto us = std::max(1LL, run(packet, threads, decodes));
+      const double rate = 1e6 * threads * decodes / static_cast<double>(us);
+      if (threads == 1)
+        single = rate;
+      std::cout << std::setw(7) << threads << std::setw(12) << us << std::setw(12) << static_cast<long long>(rate)
+                << std::setw(10) << std::fixed << std::setprecision(2) << rate / single << "\n";
+    }
+    return EXIT_SUCCESS;
+  } catch (Exiv2::Error& e) {
+    std::cout << "Caught Exiv2 exception '" << e.what() << "'\n";
+    return EXIT_FAILURE;
+  }
+}
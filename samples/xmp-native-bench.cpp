@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// XMP native fast path benchmark: XmpParser::decode() and encode() with and without the XMP toolkit
+
+#include <exiv2/exiv2.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+// The XMP a camera writes into a JPEG
+Exiv2::XmpData cameraXmp() {
+  Exiv2::XmpData xmpData;
+  xmpData["Xmp.tiff.Make"] = "Camera Maker";
+  xmpData["Xmp.tiff.Model"] = "Camera 1";
+  xmpData["Xmp.tiff.Orientation"] = "1";
+  xmpData["Xmp.xmp.CreateDate"] = "2024-01-02T03:04:05.67";
+  xmpData["Xmp.xmp.ModifyDate"] = "2024-01-02T03:04:05.67";
+  xmpData["Xmp.xmp.CreatorTool"] = "Camera 1 Ver.1.00";
+  xmpData["Xmp.xmp.Rating"] = "0";
+  xmpData["Xmp.exif.ExposureTime"] = "1/250";
+  xmpData["Xmp.exif.FNumber"] = "56/10";
+  xmpData["Xmp.exif.ExposureProgram"] = "3";
+  xmpData["Xmp.exif.DateTimeOriginal"] = "2024-01-02T03:04:05.67";
+  xmpData["Xmp.exif.FocalLength"] = "350/10";
+  xmpData["Xmp.exif.PixelXDimension"] = "6000";
+  xmpData["Xmp.exif.PixelYDimension"] = "4000";
+  Exiv2::XmpArrayValue iso(Exiv2::xmpSeq);
+  iso.read("200");
+  xmpData.add(Exiv2::XmpKey("Xmp.exif.ISOSpeedRatings"), &iso);
+  xmpData["Xmp.exif.Flash/exif:Fired"] = "False";
+  xmpData["Xmp.exif.Flash/exif:Return"] = "0";
+  xmpData["Xmp.exif.Flash/exif:Mode"] = "2";
+  xmpData["Xmp.aux.SerialNumber"] = "0123456789";
+  xmpData["Xmp.aux.Lens"] = "35mm F1.8";
+  xmpData["Xmp.photoshop.DateCreated"] = "2024-01-02T03:04:05.67";
+  xmpData["Xmp.dc.format"] = "image/jpeg";
+  xmpData["Xmp.dc.creator"] = "Someone";
+  xmpData["Xmp.dc.rights"] = "lang=\"x-default\" (c) Someone";
+  xmpData["Xmp.dc.subject"] = "holiday";
+  return xmpData;
+}
+
+// Run op rounds times, return the time per round in us
+double timePerRound(int rounds, const std::function<void()>& op) {
+  const auto start = Clock::now();
+  for (int i = 0; i < rounds; ++i)
+    op();
+  const auto us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+  return static_cast<double>(us) / rounds;
+}
+}  // namespace
+
+int main(int argc, char* const argv[]) {
+  try {
+    int rounds = 2000;
+    int first = 1;
+    while (first + 1 < argc && argv[first][0] == '-') {
+      const std::string opt(argv[first]);
+      if (opt == "-n")
+        rounds = std::max(1, std::atoi(argv[first + 1]));
+      else
+        break;
+      first += 2;
+    }
+    if (first + 1 < argc || (first < argc && argv[first][0] == '-')) {
+      std::cout << "Usage: " << argv[0] << " [-n rounds] [file]\n";
+      std::cout << "Decodes and encodes the XMP packet of file, or else a generated camera packet, [rounds]\n"
+                << "times (default 2000) with the XMP toolkit and with the native fast path, and reports\n"
+                << "the time per decode and encode.\n";
+      return EXIT_FAILURE;
+    }
+
+    std::string packet;
+    if (first < argc) {
+      auto image = Exiv2::ImageFactory::open(argv[first]);
+      image->readMetadata();
+      packet = image->xmpPacket();
+      if (packet.empty()) {
+        std::cerr << argv[first] << ": no XMP packet\n";
+        return EXIT_FAILURE;
+      }
+    } else if (Exiv2::XmpParser::encode(packet, cameraXmp()) != 0) {
+      std::cerr << "Failed to encode the XMP packet\n";
+      return EXIT_FAILURE;
+    }
+
+    const Exiv2::DecodeParams toolkit(500);
+    const Exiv2::DecodeParams native(500, false, true);
+    Exiv2::XmpData xmpData;
+    if (Exiv2::XmpParser::decode(xmpData, packet, native) != 0) {
+      std::cerr << "Failed to decode the XMP packet\n";
+      return EXIT_FAILURE;
+    }
+    const uint16_t flags = Exiv2::XmpParser::useCompactFormat;
+    const uint16_t nativeFlags = flags | Exiv2::XmpParser::useNativeSerializer;
+    std::string out;
+
+    const double decodeToolkit = timePerRound(rounds, [&] {
+      Exiv2::XmpData data;
+      Exiv2::XmpParser::decode(data, packet, toolkit);
+    });
+    const double decodeNative = timePerRound(rounds, [&] {
+      Exiv2::XmpData data;
+      Exiv2::XmpParser::decode(data, packet, native);
+    });
+    const double encodeToolkit = timePerRound(rounds, [&] { Exiv2::XmpParser::encode(out, xmpData, flags); });
+    const double encodeNative = timePerRound(rounds, [&] { Exiv2::XmpParser::encode(out, xmpData, nativeFlags); });
+
+    std::cout << "packet:      " << packet.size() << " bytes\n"
+              << "properties:  " << xmpData.count() << "\n"
+              << "rounds:      " << rounds << "\n"
+              << "decode:      " << decodeToolkit << " us toolkit, " << decodeNative << " us native\n"
+              << "encode:      " << encodeToolkit << " us toolkit, " << encodeNative << " us native\n";
+    return EXIT_SUCCESS;
+  } catch (Exiv2::Error& e) {
+    std::cout << "Caught Exiv2 exception '" << e.what() << "'\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// XMP sidecar benchmark: XmpParser::decode() of a large XMP sidecar, such as Lightroom develop settings
+
+#include <exiv2/exiv2.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+const char* const header =
+    "<?xpacket begin=\"\xEF\xBB\xBF\" id=\"W5M0MpCehiHzreSzNTczkc9d\"?>\n"
+    "<x:xmpmeta xmlns:x=\"adobe:ns:meta/\" x:xmptk=\"Adobe XMP Core 7.0-c000 1.000000, 0000/00/00-00:00:00\">\n"
+    " <rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\">\n"
+    "  <rdf:Description rdf:about=\"\"\n"
+    "    xmlns:crs=\"http://ns.adobe.com/camera-raw-settings/1.0/\"\n"
+    "    crs:Version=\"15.0\" crs:ProcessVersion=\"11.0\" crs:WhiteBalance=\"As Shot\"\n"
+    "    crs:Exposure2012=\"+0.35\" crs:Contrast2012=\"+12\" crs:Highlights2012=\"-40\"\n"
+    "    crs:Shadows2012=\"+25\" crs:Whites2012=\"+5\" crs:Blacks2012=\"-8\" crs:Clarity2012=\"+10\"\n"
+    "    crs:Vibrance=\"+15\" crs:Saturation=\"0\" crs:HasSettings=\"True\" crs:HasCrop=\"False\">\n"
+    "   <crs:ToneCurvePV2012>\n"
+    "    <rdf:Seq>\n"
+    "     <rdf:li>0, 0</rdf:li>\n"
+    "     <rdf:li>64, 60</rdf:li>\n"
+    "     <rdf:li>128, 131</rdf:li>\n"
+    "     <rdf:li>192, 196</rdf:li>\n"
+    "     <rdf:li>255, 255</rdf:li>\n"
+    "    </rdf:Seq>\n"
+    "   </crs:ToneCurvePV2012>\n"
+    "   <crs:MaskGroupBasedCorrections>\n"
+    "    <rdf:Seq>\n";
+
+const char* const trailer =
+    "    </rdf:Seq>\n"
+    "   </crs:MaskGroupBasedCorrections>\n"
+    "  </rdf:Description>\n"
+    " </rdf:RDF>\n"
+    "</x:xmpmeta>\n"
+    "<?xpacket end=\"w\"?>";
+
+// A local brush correction with a few dabs, the bulk of a retouched Lightroom sidecar
+std::string correction(int n) {
+  const auto id = std::to_string(n);
+  std::string li =
+      "     <rdf:li>\n"
+      "      <rdf:Description crs:What=\"Correction\" crs:CorrectionAmount=\"1.000000\"\n"
+      "        crs:CorrectionActive=\"true\" crs:CorrectionName=\"Brush " +
+      id +
+      "\"\n"
+      "        crs:LocalExposure2012=\"0.250000\" crs:LocalContrast2012=\"0.000000\"\n"
+      "        crs:LocalHighlights2012=\"-0.150000\" crs:LocalShadows2012=\"0.100000\"\n"
+      "        crs:LocalClarity2012=\"0.000000\" crs:LocalSaturation=\"0.000000\">\n"
+      "       <crs:CorrectionMasks>\n"
+      "        <rdf:Seq>\n";
+  for (int dab = 0; dab < 8; ++dab) {
+    li += "         <rdf:li crs:What=\"Mask/Paint\" crs:MaskValue=\"1.000000\" crs:Radius=\"0.0" +
+          std::to_string(40 + dab) + "\" crs:Flow=\"1.000000\" crs:CenterWeight=\"0.000000\" crs:Dabs=\"d 0.4" + id +
+          " 0.5" + std::to_string(dab) + "\"/>\n";
+  }
+  li +=
+      "        </rdf:Seq>\n"
+      "       </crs:CorrectionMasks>\n"
+      "      </rdf:Description>\n"
+      "     </rdf:li>\n";
+  return li;
+}
+
+// A Lightroom style develop settings sidecar of at least kib KiB
+std::string developSettings(size_t kib) {
+  std::string packet = header;
+  for (int n = 0; packet.size() < kib * 1024; ++n)
+    packet += correction(n);
+  return packet + trailer;
+}
+}  // namespace
+
+int main(int argc, char* const argv[]) {
+  try {
+    int decodes = 100;
+    size_t kib = 128;
+    int first = 1;
+    while (first + 1 < argc && argv[first][0] == '-') {
+      const std::string opt(argv[first]);
+      if (opt == "-n")
+        decodes = std::max(1, std::atoi(argv[first + 1]));
+      else if (opt == "-k")
+        kib = static_cast<size_t>(std::max(1, std::atoi(argv[first + 1])));
+      else
+        break;
+      first += 2;
+    }
+    if (first + 1 < argc || (first < argc && argv[first][0] == '-')) {
+      std::cout << "Usage: " << argv[0] << " [-n decodes] [-k KiB] [file]\n";
+      std::cout << "Decodes the XMP packet of file, or else a generated Lightroom develop settings sidecar of\n"
+                << "[KiB] KiB (default 128), [decodes] times (default 100) and reports the time per decode.\n";
+      return EXIT_FAILURE;
+    }
+
+    std::string packet;
+    if (first < argc) {
+      auto image = Exiv2::ImageFactory::open(argv[first]);
+      image->readMetadata();
+      packet = image->xmpPacket();
+      if (packet.empty()) {
+        std::cerr << argv[first] << ": no XMP packet\n";
+        return EXIT_FAILURE;
+      }
+    } else {
+      packet = developSettings(kib);
+    }
+
+    const Exiv2::DecodeParams dp(500);
+    Exiv2::XmpData xmpData;
+    if (Exiv2::XmpParser::decode(xmpData, packet, dp) != 0) {
+      std::cerr << "Failed to decode the XMP packet\n";
+      return EXIT_FAILURE;
+    }
+    const auto properties = xmpData.count();
+
+    const auto start = Clock::now();
+    for (int i = 0; i < decodes; ++i) {
+      Exiv2::XmpData data;
+      Exiv2::XmpParser::decode(data, packet, dp);
+    }
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    const auto perDecode = std::max(1LL, static_cast<long long>(us) / decodes);
+
+    std::cout << "packet:      " << packet.size() << " bytes\n"
+              << "properties:  " << properties << "\n"
+              << "decodes:     " << decodes << "\n"
+              << "per decode:  " << perDecode << " us\n"
+              << "throughput:  " << static_cast<long long>(packet.size()) * 1000000 / perDecode / 1024 << " KiB/s\n";
+    return EXIT_SUCCESS;
+  } catch (Exiv2::Error& e) {
+    std::cout << "Caught Exiv2 exception '" << e.what() << "'\n";
+    return EXIT_FAILURE;
+  }
+}
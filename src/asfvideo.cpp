@@ -226,17 +226,19 @@ AsfVideo::HeaderReader::HeaderReader(const BasicIo::UniquePtr& io) : IdBuf_(GUID
 
 void AsfVideo::decodeBlock(size_t depth) {
   Internal::enforce(GUID + QWORD <= io_->size() - io_->tell(), Exiv2::ErrorCode::kerCorruptedMetadata);
+  const uint64_t start = io_->tell();
   HeaderReader objectHeader(io_);
 #ifdef EXIV2_DEBUG_MESSAGES
   EXV_INFO << "decodeBlock = " << GUIDTag(objectHeader.getId().data()).to_string()
            << "\tsize= " << objectHeader.getSize() << "\t " << io_->tell() << "/" << io_->size() << '\n';
 #endif
+  Internal::enforce(objectHeader.getSize() >= GUID + QWORD, Exiv2::ErrorCode::kerCorruptedMetadata);
   Internal::enforce(objectHeader.getSize() <= io_->size() - io_->tell(), Exiv2::ErrorCode::kerCorruptedMetadata);
   auto tag = GUIDReferenceTags.find(GUIDTag(objectHeader.getId().data()));
 
   if (tag != GUIDReferenceTags.end()) {
     if (tag->second == "Header")
-      decodeHeader(depth + 1);
+      decodeHeader(depth + 1, start + objectHeader.getSize());
     else if (tag->second == "File_Properties")
       fileProperties();
     else if (tag->second == "Stream_Properties")
@@ -268,9 +270,11 @@ void AsfVideo::decodeBlock(size_t depth) {
     io_->seekOrThrow(io_->tell() + remaining_size, BasicIo::beg, ErrorCode::kerFailedToReadImageData);
   }
 
+  // Continue after the object, however much of it the decoder read
+  io_->seekOrThrow(start + objectHeader.getSize(), BasicIo::beg, ErrorCode::kerFailedToReadImageData);
 }  // AsfVideo::decodeBlock
 
-void AsfVideo::decodeHeader(size_t depth) {
+void AsfVideo::decodeHeader(size_t depth, uint64_t end) {
   Internal::enforce(depth <= max_recursion_depth_, Exiv2::ErrorCode::kerCorruptedMetadata);
   DataBuf nbHeadersBuf(DWORD + 1);
   io_->readOrThrow(nbHeadersBuf.data(), DWORD, Exiv2::ErrorCode::kerCorruptedMetadata);
@@ -279,7 +283,8 @@ void AsfVideo::decodeHeader(size_t depth) {
   Internal::enforce(nb_headers < std::numeric_limits<uint32_t>::max(), Exiv2::ErrorCode::kerCorruptedMetadata);
   io_->seekOrThrow(io_->tell() + (BYTE * 2), BasicIo::beg,
                    ErrorCode::kerFailedToReadImageData);  // skip two reserved tags
-  for (uint32_t i = 0; i < nb_headers; i++) {
+  // The metadata is all in the objects of the header, the data and index objects after it are never read
+  for (uint32_t i = 0; i < nb_headers && io_->tell() + GUID + QWORD <= end; i++) {
     decodeBlock(depth);
   }
 }
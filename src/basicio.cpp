@@ -377,6 +377,37 @@ size_t FileIo::write(BasicIo& src) {
   return writeTotal;
 }
 
+size_t FileIo::write(const FileIo& src, const byte* data, size_t wcount) {
+#ifdef EXV_HAVE_COPY_FILE_RANGE
+  // Smaller ranges are cheaper to write from the mapped area than to copy with a system call
+  constexpr size_t minCopyRange = 64 * 1024;
+  const byte* pMapped = src.p_->pMappedArea_;
+  const size_t mappedLength = src.p_->mappedLength_;
+  if (wcount >= minCopyRange && src.p_->fp_ && pMapped && data >= pMapped && wcount <= mappedLength &&
+      static_cast<size_t>(data - pMapped) <= mappedLength - wcount) {
+    if (p_->switchMode(Impl::opWrite) != 0 || std::fflush(p_->fp_) != 0)
+      return 0;
+    loff_t offIn = data - pMapped;
+    loff_t offOut = ftello(p_->fp_);
+    if (offOut == -1)
+      return 0;
+    size_t copied = 0;
+    while (copied < wcount) {
+      auto n = ::copy_file_range(fileno(src.p_->fp_), &offIn, fileno(p_->fp_), &offOut, wcount - copied, 0);
+      if (n <= 0)
+        break;  // Not supported for these files, e.g., EXDEV; write the rest from the mapped area
+      copied += n;
+    }
+    if (fseeko(p_->fp_, offOut, SEEK_SET) != 0)
+      return 0;
+    if (copied < wcount)
+      copied += write(data + copied, wcount - copied);
+    return copied;
+  }
+#endif
+  return write(data, wcount);
+}
+
 void FileIo::transfer(BasicIo& src) {
   const bool wasOpen = (p_->fp_ != nullptr);
   const std::string lastMode(p_->openMode_);
@@ -417,25 +448,24 @@ void FileIo::transfer(BasicIo& src) {
         fs::rename(fileIo->path(), pf);
         fs::remove(fileIo->path());
       } else {
-        if (fileExists(pf) && fs::remove(pf) != 0)
+        if (fileExists(pf) && !fs::remove(pf))
           throw Error(ErrorCode::kerCallFailed, pf, strError(), "fs::remove");
         fs::rename(fileIo->path(), pf);
         fs::remove(fileIo->path());
       }
 #else
-      if (fileExists(pf) && fs::remove(pf) != 0) {
-        throw Error(ErrorCode::kerCallFailed, pf, strError(), "fs::remove");
-      }
+      // rename() atomically replaces an existing file, readers see either the old or the new content
       fs::rename(fileIo->path(), pf);
-      fs::remove(fileIo->path());
 #endif
       // Check permissions of new file
       auto newStMode = fs::status(pf).permissions();
       // Set original file permissions
       if (statOk && origStMode != newStMode) {
-        fs::permissions(pf, origStMode);
+        std::error_code ec;
+        fs::permissions(pf, origStMode, ec);
 #ifndef SUPPRESS_WARNINGS
-        EXV_WARNING << Error(ErrorCode::kerCallFailed, pf, strError(), "::chmod") << "\n";
+        if (ec)
+          EXV_WARNING << Error(ErrorCode::kerCallFailed, pf, ec.message(), "::chmod") << "\n";
 #endif
       }
     }
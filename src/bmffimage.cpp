@@ -22,10 +22,14 @@
 #endif
 
 // + standard includes
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <iostream>
+#include <map>
+#include <optional>
 #include <string>
+#include <vector>
 
 enum TAG {
   ftyp = 0x66747970U,  //!< "ftyp" File type box */
@@ -53,8 +57,10 @@ enum TAG {
   ipco = 0x6970636fU,  //!< "ipco" Item property container */
   iinf = 0x69696e66U,  //!< "iinf" Item info */
   iloc = 0x696c6f63U,  //!< "iloc" Item location */
+  idat = 0x69646174U,  //!< "idat" Item data */
   ispe = 0x69737065U,  //!< "ispe" Image spatial extents */
   infe = 0x696e6665U,  //!< "infe" Item Info Extension */
+  mime = 0x6d696d65U,  //!< "mime" Item type of XMP */
   ipma = 0x69706d61U,  //!< "ipma" Item Property Association */
   cmt1 = 0x434d5431U,  //!< "CMT1" ifd0Id */
   cmt2 = 0x434D5432U,  //!< "CMD2" exifID */
@@ -117,6 +123,42 @@ static bool skipBox(uint32_t box) {
   return box == 0 || box == TAG::mdat;  // mdat is where the main image lives and can be huge
 }
 
+static bool containerBox(uint32_t box) {
+  // Boxes whose payload is read once, with the boxes in it parsed from slices of it
+  return box == TAG::moov || box == TAG::iprp || box == TAG::ipco || box == TAG::meta || box == TAG::iinf;
+}
+
+static size_t boxBytes(uint32_t box, size_t size) {
+  // How many bytes of the payload of a box boxHandler() looks at
+  switch (box) {
+    case TAG::moov:
+    case TAG::iprp:
+    case TAG::ipco:
+    case TAG::meta:
+    case TAG::iinf:
+    case TAG::ftyp:
+    case TAG::infe:
+    case TAG::iloc:
+    case TAG::ispe:
+    case TAG::colr:
+    case TAG::brob:
+    case TAG::exif:
+    case TAG::xml:
+    case TAG::cmt1:
+    case TAG::cmt2:
+    case TAG::cmt3:
+    case TAG::cmt4:
+      return size;
+    case TAG::uuid:
+      return 16;
+    case TAG::thmb:
+    case TAG::prvw:
+      return std::min<size_t>(size, 16);  // version/flags, then the preview header, not the preview
+    default:
+      return 0;
+  }
+}
+
 std::string BmffImage::mimeType() const {
   switch (fileType_) {
     case TAG::avci:
@@ -223,8 +265,24 @@ void BmffImage::brotliUncompress(const byte* compressedBuf, size_t compressedBuf
 }
 #endif
 
+const byte* BmffImage::BoxPayload::bytesAt(uint64_t offset, size_t size) const {
+  if (size == 0 || offset < start_ || offset - start_ > bytes_.size() || size > bytes_.size() - (offset - start_))
+    return nullptr;
+  const auto begin = static_cast<size_t>(offset - start_);
+  return bytes_.subSlice(begin, begin + size).cbegin();
+}
+
+size_t BmffImage::readBytes(byte* buf, size_t size, const BoxPayload* parent) {
+  if (const byte* bytes = parent ? parent->bytesAt(io_->tell(), size) : nullptr) {
+    std::copy_n(bytes, size, buf);
+    io_->seek(static_cast<int64_t>(size), BasicIo::cur);
+    return size;
+  }
+  return io_->read(buf, size);
+}
+
 uint64_t BmffImage::boxHandler(std::ostream& out /* = std::cout*/, Exiv2::PrintStructureOption option /* = kpsNone */,
-                               uint64_t pbox_end, size_t depth) {
+                               uint64_t pbox_end, size_t depth, const BoxPayload* parent /* = nullptr */) {
   const size_t address = io_->tell();
   // never visit a box twice!
   if (depth == 0)
@@ -245,7 +303,7 @@ uint64_t BmffImage::boxHandler(std::ostream& out /* = std::cout*/, Exiv2::PrintS
 
   size_t hdrsize = sizeof(hdrbuf);
   Internal::enforce(hdrsize <= static_cast<size_t>(pbox_end - address), Exiv2::ErrorCode::kerCorruptedMetadata);
-  if (io_->read(hdrbuf, sizeof(hdrbuf)) != sizeof(hdrbuf))
+  if (readBytes(hdrbuf, sizeof(hdrbuf), parent) != sizeof(hdrbuf))
     return pbox_end;
 
   // The box length is encoded as a uint32_t by default, but the special value 1 means
@@ -264,9 +322,9 @@ uint64_t BmffImage::boxHandler(std::ostream& out /* = std::cout*/, Exiv2::PrintS
     // The box size is encoded as a uint64_t, so we need to read another 8 bytes.
     hdrsize += 8;
     Internal::enforce(hdrsize <= static_cast<size_t>(pbox_end - address), Exiv2::ErrorCode::kerCorruptedMetadata);
-    DataBuf data(8);
-    io_->read(data.data(), data.size());
-    box_length = data.read_uint64(0, endian_);
+    byte lenbuf[8]{};
+    readBytes(lenbuf, sizeof(lenbuf), parent);
+    box_length = getULongLong(lenbuf, endian_);
   }
 
   if (box_length == 0) {
@@ -289,18 +347,36 @@ uint64_t BmffImage::boxHandler(std::ostream& out /* = std::cout*/, Exiv2::PrintS
     return restore + buffer_size;
   }
 
-  DataBuf data(static_cast<size_t>(buffer_size));
-  const size_t box_end = restore + data.size();
-  io_->read(data.data(), data.size());
-  io_->seek(restore, BasicIo::beg);
+  const size_t box_end = restore + static_cast<size_t>(buffer_size);
 
-  size_t skip = 0;  // read position in data.pData_
+  // A container is read once, unless its parent holds it already, and the boxes in it are parsed
+  // from slices of it. Other boxes are only read as far as the switch below looks into them.
+  const size_t size = boxBytes(box_type, static_cast<size_t>(buffer_size));
+  DataBuf buf;
+  const byte* bytes = parent ? parent->bytesAt(restore, size) : nullptr;
+  if (!bytes && size > 0) {
+    buf.alloc(size);
+    if (io_->read(buf.data(), size) != size && io_->error())
+      throw Error(ErrorCode::kerFailedToReadImageData);
+    io_->seek(restore, BasicIo::beg);
+    bytes = buf.c_data();
+  }
+  // The payload of a container, for the boxes in it
+  std::optional<BoxPayload> payload;
+  if (bytes && containerBox(box_type))
+    payload = BoxPayload{Slice<const byte*>(bytes, 0, size), restore};
+  // The payload of other boxes, the decoder looks into
+  DataBuf data;
+  if (bytes && !containerBox(box_type))
+    data = buf.empty() ? DataBuf(bytes, size) : std::move(buf);
+
+  size_t skip = 0;  // read position in the payload
   uint8_t version = 0;
   uint32_t flags = 0;
 
   if (fullBox(box_type)) {
-    Internal::enforce(data.size() - skip >= 4, Exiv2::ErrorCode::kerCorruptedMetadata);
-    flags = data.read_uint32(skip, endian_);  // version/flags
+    Internal::enforce(size - skip >= 4, Exiv2::ErrorCode::kerCorruptedMetadata);
+    flags = getULong(bytes + skip, endian_);  // version/flags
     version = static_cast<uint8_t>(flags >> 24);
     flags &= 0x00ffffff;
     skip += 4;
@@ -323,13 +399,13 @@ uint64_t BmffImage::boxHandler(std::ostream& out /* = std::cout*/, Exiv2::PrintS
         bLF = false;
       }
 
-      Internal::enforce(data.size() - skip >= 2, Exiv2::ErrorCode::kerCorruptedMetadata);
-      uint16_t n = data.read_uint16(skip, endian_);
+      Internal::enforce(size - skip >= 2, Exiv2::ErrorCode::kerCorruptedMetadata);
+      uint16_t n = getUShort(bytes + skip, endian_);
       skip += 2;
 
       io_->seek(skip, BasicIo::cur);
       while (n-- > 0) {
-        io_->seek(boxHandler(out, option, box_end, depth + 1), BasicIo::beg);
+        io_->seek(boxHandler(out, option, box_end, depth + 1, &*payload), BasicIo::beg);
       }
     } break;
 
@@ -368,7 +444,7 @@ uint64_t BmffImage::boxHandler(std::ostream& out /* = std::cout*/, Exiv2::PrintS
       }
       io_->seek(skip, BasicIo::cur);
       while (io_->tell() < box_end) {
-        io_->seek(boxHandler(out, option, box_end, depth + 1), BasicIo::beg);
+        io_->seek(boxHandler(out, option, box_end, depth + 1, payload ? &*payload : nullptr), BasicIo::beg);
       }
       // post-process meta box to recover Exif and XMP
       if (box_type == TAG::meta) {
@@ -484,9 +560,9 @@ uint64_t BmffImage::boxHandler(std::ostream& out /* = std::cout*/, Exiv2::PrintS
     } break;
 
     case TAG::uuid: {
-      DataBuf uuid(16);
-      io_->read(uuid.data(), uuid.size());
-      std::string name = uuidName(uuid);
+      // The boxes in a uuid box are read on their own, a preview in it can be big
+      io_->seek(16, BasicIo::cur);
+      std::string name = uuidName(data);
       if (bTrace) {
         out << " uuidName " << name << '\n';
         bLF = false;
@@ -498,7 +574,7 @@ uint64_t BmffImage::boxHandler(std::ostream& out /* = std::cout*/, Exiv2::PrintS
           io_->seek(8, BasicIo::cur);
         }
         while (io_->tell() < box_end) {
-          io_->seek(boxHandler(out, option, box_end, depth + 1), BasicIo::beg);
+          io_->seek(boxHandler(out, option, box_end, depth + 1, parent), BasicIo::beg);
         }
       } else if (name == "xmp") {
         parseXmp(box_length, io_->tell());
@@ -506,22 +582,22 @@ uint64_t BmffImage::boxHandler(std::ostream& out /* = std::cout*/, Exiv2::PrintS
     } break;
 
     case TAG::cmt1:
-      parseTiff(Internal::Tag::root, box_length);
+      decodeTiff(Internal::Tag::root, data.c_data(), data.size(), false);
       break;
     case TAG::cmt2:
-      parseTiff(Internal::Tag::cmt2, box_length);
+      decodeTiff(Internal::Tag::cmt2, data.c_data(), data.size(), false);
       break;
     case TAG::cmt3:
-      parseTiff(Internal::Tag::cmt3, box_length);
+      decodeTiff(Internal::Tag::cmt3, data.c_data(), data.size(), false);
       break;
     case TAG::cmt4:
-      parseTiff(Internal::Tag::cmt4, box_length);
+      decodeTiff(Internal::Tag::cmt4, data.c_data(), data.size(), false);
       break;
     case TAG::exif:
-      parseTiff(Internal::Tag::root, buffer_size, io_->tell());
+      decodeTiff(Internal::Tag::root, data.c_data(), data.size(), true);
       break;
     case TAG::xml:
-      parseXmp(buffer_size, io_->tell());
+      decodeXmp(data.c_data(), data.size());
       break;
     case TAG::brob: {
       Internal::enforce(data.size() >= 4, Exiv2::ErrorCode::kerCorruptedMetadata);
@@ -532,7 +608,7 @@ uint64_t BmffImage::boxHandler(std::ostream& out /* = std::cout*/, Exiv2::PrintS
 #ifdef EXV_HAVE_BROTLI
       DataBuf arr;
       brotliUncompress(data.c_data(4), data.size() - 4, arr);
-      const DecodeParams dp(max_recursion_depth_);
+      const DecodeParams dp(max_recursion_depth_, lazyMakernotes());
       if (realType == TAG::exif) {
         uint32_t offset = Safe::add(arr.read_uint32(0, endian_), 4u);
         Internal::enforce(Safe::add(offset, 4u) < arr.size(), Exiv2::ErrorCode::kerCorruptedMetadata);
@@ -591,23 +667,33 @@ void BmffImage::parseTiff(uint32_t root_tag, uint64_t length, uint64_t start) {
   const size_t restore = io_->tell();
   DataBuf exif(static_cast<size_t>(length));
   io_->seek(static_cast<int64_t>(start), BasicIo::beg);
-  if (exif.size() > 8 && io_->read(exif.data(), exif.size()) == exif.size()) {
+  if (exif.size() > 8 && io_->read(exif.data(), exif.size()) == exif.size())
+    decodeTiff(root_tag, exif.c_data(), exif.size(), true);
+  io_->seek(restore, BasicIo::beg);
+}
+
+void BmffImage::decodeTiff(uint32_t root_tag, const byte* pData, size_t size, bool hunt) {
+  size_t punt = 0;
+  if (hunt) {
+    if (size <= 8)
+      return;
     // hunt for "II" or "MM"
     const size_t eof = std::numeric_limits<size_t>::max();  // impossible value for punt
-    size_t punt = eof;
-    for (size_t i = 0; i < exif.size() - 9 && punt == eof; ++i) {
-      auto charCurrent = exif.read_uint8(i);
-      auto charNext = exif.read_uint8(i + 1);
+    punt = eof;
+    for (size_t i = 0; i < size - 9 && punt == eof; ++i) {
+      auto charCurrent = pData[i];
+      auto charNext = pData[i + 1];
       if (charCurrent == charNext && (charCurrent == 'I' || charCurrent == 'M'))
         punt = i;
     }
-    if (punt != eof) {
-      const DecodeParams dp(max_recursion_depth_);
-      Internal::TiffParserWorker::decode(exifData(), iptcData(), xmpData(), exif.c_data(punt), exif.size() - punt,
-                                         root_tag, Internal::TiffMapping::findDecoder, dp);
-    }
+    if (punt == eof)
+      return;
+  } else if (size == 0) {
+    return;
   }
-  io_->seek(restore, BasicIo::beg);
+  const DecodeParams dp(max_recursion_depth_, lazyMakernotes());
+  Internal::TiffParserWorker::decode(exifData(), iptcData(), xmpData(), pData + punt, size - punt, root_tag,
+                                     Internal::TiffMapping::findDecoder, dp);
 }
 
 void BmffImage::parseTiff(uint32_t root_tag, uint64_t length) {
@@ -622,9 +708,7 @@ void BmffImage::parseTiff(uint32_t root_tag, uint64_t length) {
     if (bufRead != data.size())
       throw Error(ErrorCode::kerInputDataReadFailed);
 
-    const DecodeParams dp(max_recursion_depth_);
-    Internal::TiffParserWorker::decode(exifData(), iptcData(), xmpData(), data.c_data(), data.size(), root_tag,
-                                       Internal::TiffMapping::findDecoder, dp);
+    decodeTiff(root_tag, data.c_data(), data.size(), false);
   }
 }
 
@@ -636,20 +720,26 @@ void BmffImage::parseXmp(uint64_t length, uint64_t start) {
   io_->seek(static_cast<int64_t>(start), BasicIo::beg);
 
   auto lengthSizeT = static_cast<size_t>(length);
-  DataBuf xmp(lengthSizeT + 1);
-  xmp.write_uint8(lengthSizeT, 0);  // ensure xmp is null terminated!
+  DataBuf xmp(lengthSizeT);
   if (io_->read(xmp.data(), lengthSizeT) != lengthSizeT)
     throw Error(ErrorCode::kerInputDataReadFailed);
   if (io_->error())
     throw Error(ErrorCode::kerFailedToReadImageData);
+  decodeXmp(xmp.c_data(), xmp.size());
+
+  io_->seek(restore, BasicIo::beg);
+}
+
+void BmffImage::decodeXmp(const byte* pData, size_t size) {
+  // the packet ends at the first null byte, if there is one
+  const auto xmp = reinterpret_cast<const char*>(pData);
+  xmpPacket_ = size ? std::string(xmp, strnlen(xmp, size)) : std::string();
   try {
     const DecodeParams dp(max_recursion_depth_);
-    Exiv2::XmpParser::decode(xmpData(), std::string(xmp.c_str()), dp);
+    Exiv2::XmpParser::decode(xmpData(), xmpPacket_, dp);
   } catch (...) {
     throw Error(ErrorCode::kerFailedToReadImageData);
   }
-
-  io_->seek(restore, BasicIo::beg);
 }
 
 /// \todo instead of passing the last 4 parameters, pass just one and build the different offsets inside
@@ -677,20 +767,12 @@ void BmffImage::parseCr3Preview(const DataBuf& data, std::ostream& out, bool bTr
   nativePreviews_.push_back(std::move(nativePreview));
 }
 
-void BmffImage::setExifData(const ExifData& /*exifData*/) {
-  throw(Error(ErrorCode::kerInvalidSettingForImage, "Exif metadata", "BMFF"));
-}
-
 void BmffImage::setIptcData(const IptcData& /*iptcData*/) {
   throw(Error(ErrorCode::kerInvalidSettingForImage, "IPTC metadata", "BMFF"));
 }
 
-void BmffImage::setXmpData(const XmpData& /*xmpData*/) {
-  throw(Error(ErrorCode::kerInvalidSettingForImage, "XMP metadata", "BMFF"));
-}
-
 void BmffImage::setComment(const std::string&) {
-  // bmff files are read-only
+  // bmff files have no comment
   throw(Error(ErrorCode::kerInvalidSettingForImage, "Image comment", "BMFF"));
 }
 
@@ -762,9 +844,324 @@ void BmffImage::printStructure(std::ostream& out, Exiv2::PrintStructureOption op
   }
 }
 
+namespace {
+//! Location of an item in the iloc box, and the file positions of the fields to patch to move it
+struct ItemLocation {
+  uint16_t constructionMethod_{0};
+  uint64_t constructionMethodPos_{0};  //!< 0 if the iloc version has no construction method
+  uint16_t dataReferenceIndex_{0};
+  uint64_t baseOffset_{0};
+  uint16_t extentCount_{0};
+  uint64_t offset_{0};     //!< Offset of the first extent, from the base offset
+  uint64_t length_{0};     //!< Length of the first extent
+  uint64_t offsetPos_{0};  //!< File position of the offset of the first extent
+  uint64_t lengthPos_{0};  //!< File position of the length of the first extent
+};
+
+//! What writeMetadata() needs to know about the items of a file
+struct ItemLayout {
+  std::optional<uint32_t> exifId_;
+  std::optional<uint32_t> xmpId_;
+  size_t offsetSize_{0};
+  size_t lengthSize_{0};
+  std::map<uint32_t, ItemLocation> locations_;
+  std::optional<uint64_t> idat_;  //!< File position of the payload of the idat box
+};
+
+uint64_t readUInt(const DataBuf& buf, size_t pos, size_t size) {
+  Internal::enforce(size <= buf.size() && pos <= buf.size() - size, ErrorCode::kerCorruptedMetadata);
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; ++i)
+    value = value << 8 | buf.read_uint8(pos + i);
+  return value;
+}
+
+//! Write \em value big-endian to \em buf, in \em size 2, 4 or 8 bytes
+void putUInt(byte* buf, uint64_t value, size_t size) {
+  if (size == 2)
+    us2Data(buf, static_cast<uint16_t>(value), bigEndian);
+  else if (size == 4)
+    ul2Data(buf, static_cast<uint32_t>(value), bigEndian);
+  else
+    ull2Data(buf, value, bigEndian);
+}
+
+//! Parse the infe boxes of the iinf box at \em pos in \em meta for the Exif and XMP items
+void parseItemInfos(const DataBuf& meta, size_t pos, size_t end, ItemLayout& layout) {
+  const auto version = readUInt(meta, pos, 1);
+  pos += 4;
+  uint64_t count = readUInt(meta, pos, version == 0 ? 2 : 4);
+  pos += version == 0 ? 2 : 4;
+  while (count-- > 0 && pos < end) {
+    const auto length = readUInt(meta, pos, 4);
+    Internal::enforce(length >= 12 && length <= end - pos, ErrorCode::kerCorruptedMetadata);
+    const size_t next = pos + static_cast<size_t>(length);
+    const auto infeVersion = readUInt(meta, pos + 8, 1);
+    if (readUInt(meta, pos + 4, 4) == TAG::infe && infeVersion >= 2) {
+      size_t p = pos + 12;
+      const auto id = static_cast<uint32_t>(readUInt(meta, p, infeVersion == 2 ? 2 : 4));
+      p += (infeVersion == 2 ? 2 : 4) + 2;  // protection index
+      const auto type = readUInt(meta, p, 4);
+      p += 4;
+      // item name, then the content type of a mime item
+      const auto str = [&meta, &p, next] {
+        Internal::enforce(p <= next, ErrorCode::kerCorruptedMetadata);
+        const auto s = reinterpret_cast<const char*>(meta.c_data(p));
+        const size_t len = s ? strnlen(s, next - p) : 0;
+        p += len + 1;
+        return std::string(s ? s : "", len);
+      };
+      str();
+      if (type == TAG::exif)
+        layout.exifId_ = id;
+      else if (type == TAG::mime && str() == "application/rdf+xml")
+        layout.xmpId_ = id;
+    }
+    pos = next;
+  }
+}
+
+//! Parse the iloc box at \em pos in \em meta, whose payload starts at file position \em metaPos
+void parseItemLocations(const DataBuf& meta, size_t pos, uint64_t metaPos, ItemLayout& layout) {
+  const auto version = readUInt(meta, pos, 1);
+  pos += 4;
+  const auto sizes = readUInt(meta, pos, 2);
+  pos += 2;
+  layout.offsetSize_ = static_cast<size_t>(sizes >> 12);
+  layout.lengthSize_ = static_cast<size_t>(sizes >> 8 & 0xf);
+  const auto baseOffsetSize = static_cast<size_t>(sizes >> 4 & 0xf);
+  const size_t indexSize = version == 1 || version == 2 ? static_cast<size_t>(sizes & 0xf) : 0;
+  const size_t idSize = version < 2 ? 2 : 4;
+  auto count = readUInt(meta, pos, idSize);
+  pos += idSize;
+  while (count-- > 0) {
+    ItemLocation loc;
+    const auto id = static_cast<uint32_t>(readUInt(meta, pos, idSize));
+    pos += idSize;
+    if (version == 1 || version == 2) {
+      loc.constructionMethodPos_ = metaPos + pos;
+      loc.constructionMethod_ = static_cast<uint16_t>(readUInt(meta, pos, 2) & 0xf);
+      pos += 2;
+    }
+    loc.dataReferenceIndex_ = static_cast<uint16_t>(readUInt(meta, pos, 2));
+    pos += 2;
+    loc.baseOffset_ = readUInt(meta, pos, baseOffsetSize);
+    pos += baseOffsetSize;
+    loc.extentCount_ = static_cast<uint16_t>(readUInt(meta, pos, 2));
+    pos += 2;
+    for (uint16_t i = 0; i < loc.extentCount_; ++i) {
+      pos += indexSize;
+      if (i == 0) {
+        loc.offsetPos_ = metaPos + pos;
+        loc.offset_ = readUInt(meta, pos, layout.offsetSize_);
+        loc.lengthPos_ = metaPos + pos + layout.offsetSize_;
+        loc.length_ = readUInt(meta, pos + layout.offsetSize_, layout.lengthSize_);
+      }
+      pos += layout.offsetSize_ + layout.lengthSize_;
+      Internal::enforce(pos <= meta.size(), ErrorCode::kerCorruptedMetadata);
+    }
+    layout.locations_[id] = loc;
+  }
+}
+
+//! A change to write to the file
+struct Patch {
+  uint64_t pos_;
+  std::vector<byte> bytes_;
+};
+}  // namespace
+
 void BmffImage::writeMetadata() {
-  // bmff files are read-only
-  throw(Error(ErrorCode::kerWritingImageFormatUnsupported, "BMFF"));
+  if (io_->open() != 0) {
+    throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
+  }
+  IoCloser closer(*io_);
+  const uint64_t fileSize = io_->size();
+
+  // Find the meta box, and the last box
+  uint64_t metaPos = 0;
+  uint64_t metaLength = 0;
+  uint64_t lastBox = 0;
+  uint64_t lastHdrSize = 8;
+  bool lastToEnd = false;
+  uint64_t address = 0;
+  while (address < fileSize) {
+    byte hdr[16];
+    io_->seek(static_cast<int64_t>(address), BasicIo::beg);
+    Internal::enforce(fileSize - address >= 8 && io_->read(hdr, 8) == 8, ErrorCode::kerCorruptedMetadata);
+    uint64_t length = getULong(hdr, endian_);
+    const uint32_t type = getULong(hdr + 4, endian_);
+    uint64_t hdrsize = 8;
+    if (length == 1) {
+      Internal::enforce(fileSize - address >= 16 && io_->read(hdr + 8, 8) == 8, ErrorCode::kerCorruptedMetadata);
+      length = getULongLong(hdr + 8, endian_);
+      hdrsize = 16;
+    }
+    lastToEnd = length == 0;
+    if (length == 0)
+      length = fileSize - address;
+    Internal::enforce(length >= hdrsize && length <= fileSize - address, ErrorCode::kerCorruptedMetadata);
+    if (type == TAG::meta && metaLength == 0) {
+      metaPos = address + hdrsize;
+      metaLength = length - hdrsize;
+    }
+    lastBox = address;
+    lastHdrSize = hdrsize;
+    address += length;
+  }
+  // CR3 and JXL files have no items, their metadata lives in boxes of its own
+  if (metaLength == 0)
+    throw Error(ErrorCode::kerWritingImageFormatUnsupported, "BMFF");
+  Internal::enforce(metaLength <= std::numeric_limits<size_t>::max(), ErrorCode::kerCorruptedMetadata);
+
+  // Find the Exif and XMP items, and where they are
+  DataBuf meta(static_cast<size_t>(metaLength));
+  io_->seek(static_cast<int64_t>(metaPos), BasicIo::beg);
+  if (io_->read(meta.data(), meta.size()) != meta.size())
+    throw Error(ErrorCode::kerFailedToReadImageData);
+  ItemLayout layout;
+  for (size_t pos = 4; pos + 8 <= meta.size();) {
+    const auto length = readUInt(meta, pos, 4);
+    Internal::enforce(length >= 8 && length <= meta.size() - pos, ErrorCode::kerCorruptedMetadata);
+    const auto end = pos + static_cast<size_t>(length);
+    switch (readUInt(meta, pos + 4, 4)) {
+      case TAG::iinf:
+        parseItemInfos(meta, pos + 8, end, layout);
+        break;
+      case TAG::iloc:
+        parseItemLocations(meta, pos + 8, metaPos, layout);
+        break;
+      case TAG::idat:
+        layout.idat_ = metaPos + pos + 8;
+        break;
+      default:
+        break;
+    }
+    pos = end;
+  }
+
+  // The new items
+  std::vector<byte> exif;
+  if (!exifData_.empty()) {
+    Blob blob;
+    ExifParser::encode(blob, littleEndian, exifData_);
+    exif.assign(blob.begin(), blob.end());
+  }
+  if (!writeXmpFromPacket() && XmpParser::encode(xmpPacket_, xmpData_) > 1) {
+#ifndef SUPPRESS_WARNINGS
+    EXV_ERROR << "Failed to encode XMP metadata." << '\n';
+#endif
+  }
+  std::vector<byte> xmp(xmpPacket_.begin(), xmpPacket_.end());
+
+  // An extent of length 0 is read as the rest of the file, an item which is cleared keeps an empty TIFF
+  // header or packet
+  if (layout.exifId_ && exif.empty())
+    exif = {'I', 'I', 0x2a, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+  if (layout.xmpId_ && xmp.empty()) {
+    const std::string packet =
+        "<?xpacket begin=\"\xef\xbb\xbf\" id=\"W5M0MpCehiHzreSzNTczkc9d\"?>"
+        "<x:xmpmeta xmlns:x=\"adobe:ns:meta/\"><rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\"/>"
+        "</x:xmpmeta><?xpacket end=\"w\"?>";
+    xmp.assign(packet.begin(), packet.end());
+  }
+
+  // Check that the items can be written before changing anything
+  const auto location = [&layout](const std::optional<uint32_t>& id, const std::vector<byte>& item) {
+    if (!id) {
+      if (item.empty())
+        return static_cast<ItemLocation*>(nullptr);
+      throw Error(ErrorCode::kerErrorMessage, "Adding a metadata item to a BMFF image is not supported");
+    }
+    auto pos = layout.locations_.find(*id);
+    if (pos == layout.locations_.end() || pos->second.extentCount_ != 1 || pos->second.dataReferenceIndex_ != 0 ||
+        pos->second.constructionMethod_ > 1 || (pos->second.constructionMethod_ == 1 && !layout.idat_) ||
+        (layout.offsetSize_ != 4 && layout.offsetSize_ != 8) || (layout.lengthSize_ != 4 && layout.lengthSize_ != 8))
+      throw Error(ErrorCode::kerErrorMessage, "Unsupported location of a metadata item in a BMFF image");
+    return &pos->second;
+  };
+  ItemLocation* exifLoc = location(layout.exifId_, exif);
+  ItemLocation* xmpLoc = location(layout.xmpId_, xmp);
+
+  // An Exif item starts with the offset of the TIFF header, keep what precedes the header
+  if (exifLoc && !exif.empty()) {
+    std::vector<byte> prefix(4);
+    const uint64_t start = (exifLoc->constructionMethod_ == 1 ? *layout.idat_ : 0) + exifLoc->baseOffset_ +
+                           exifLoc->offset_;
+    if (exifLoc->length_ >= 4 && exifLoc->length_ <= fileSize && start <= fileSize - exifLoc->length_) {
+      io_->seek(static_cast<int64_t>(start), BasicIo::beg);
+      if (io_->read(prefix.data(), 4) != 4)
+        throw Error(ErrorCode::kerFailedToReadImageData);
+      const uint32_t skip = getULong(prefix.data(), bigEndian);
+      if (skip <= exifLoc->length_ - 4 && skip <= 64) {
+        prefix.resize(4 + skip);
+        if (io_->read(prefix.data() + 4, skip) != skip)
+          throw Error(ErrorCode::kerFailedToReadImageData);
+      } else {
+        prefix.assign(4, 0);
+      }
+    }
+    exif.insert(exif.begin(), prefix.begin(), prefix.end());
+  }
+
+  // Overwrite an item which fits where it is, else append it to a new mdat box at the end of the file
+  std::vector<Patch> patches;
+  std::vector<byte> tail;
+  const uint64_t tailPos = fileSize + 8;
+  const auto place = [&](ItemLocation* loc, const std::vector<byte>& item) {
+    if (!loc)
+      return;
+    uint64_t start = (loc->constructionMethod_ == 1 ? *layout.idat_ : 0) + loc->baseOffset_ + loc->offset_;
+    if (item.size() > loc->length_) {
+      start = tailPos + tail.size();
+      Internal::enforce(start >= loc->baseOffset_, ErrorCode::kerCorruptedMetadata);
+      const uint64_t offset = start - loc->baseOffset_;
+      if (layout.offsetSize_ == 4 && offset > std::numeric_limits<uint32_t>::max())
+        throw Error(ErrorCode::kerErrorMessage, "Unsupported location of a metadata item in a BMFF image");
+      tail.insert(tail.end(), item.begin(), item.end());
+      Patch patch{loc->offsetPos_, std::vector<byte>(layout.offsetSize_)};
+      putUInt(patch.bytes_.data(), offset, layout.offsetSize_);
+      patches.push_back(std::move(patch));
+      if (loc->constructionMethod_ == 1) {
+        // the item moves from the idat box to the file
+        Patch method{loc->constructionMethodPos_, std::vector<byte>(2)};
+        putUInt(method.bytes_.data(), 0, 2);
+        patches.push_back(std::move(method));
+      }
+    } else {
+      patches.push_back(Patch{start, item});
+    }
+    Patch length{loc->lengthPos_, std::vector<byte>(layout.lengthSize_)};
+    putUInt(length.bytes_.data(), item.size(), layout.lengthSize_);
+    patches.push_back(std::move(length));
+  };
+  place(exifLoc, exif);
+  place(xmpLoc, xmp);
+
+  if (!tail.empty()) {
+    if (lastToEnd) {
+      // the last box extends to the end of the file, give it a size before a box follows it
+      const size_t sizeBytes = lastHdrSize == 8 ? 4 : 8;
+      Internal::enforce(sizeBytes == 8 || fileSize - lastBox <= std::numeric_limits<uint32_t>::max(),
+                        ErrorCode::kerCorruptedMetadata);
+      Patch size{lastHdrSize == 8 ? lastBox : lastBox + 8, std::vector<byte>(sizeBytes)};
+      putUInt(size.bytes_.data(), fileSize - lastBox, sizeBytes);
+      patches.push_back(std::move(size));
+    }
+    Internal::enforce(tail.size() + 8 <= std::numeric_limits<uint32_t>::max(), ErrorCode::kerCorruptedMetadata);
+    Patch mdat{fileSize, std::vector<byte>(8)};
+    putUInt(mdat.bytes_.data(), tail.size() + 8, 4);
+    putUInt(mdat.bytes_.data() + 4, TAG::mdat, 4);
+    mdat.bytes_.insert(mdat.bytes_.end(), tail.begin(), tail.end());
+    // append first, so the item locations are patched last
+    patches.insert(patches.begin(), std::move(mdat));
+  }
+
+  for (const auto& patch : patches) {
+    io_->seek(static_cast<int64_t>(patch.pos_), BasicIo::beg);
+    if (io_->write(patch.bytes_.data(), patch.bytes_.size()) != patch.bytes_.size())
+      throw Error(ErrorCode::kerImageWriteFailed);
+  }
 }  // BmffImage::writeMetadata
 
 // *************************************************************************
@@ -23,6 +23,8 @@
 // + standard includes
 #include <algorithm>
 #include <functional>
+#include <string_view>
+#include <unordered_map>
 
 #ifdef EXV_HAVE_ICONV
 #ifndef SUPPRESS_WARNINGS
@@ -96,12 +98,26 @@ class Converter {
   Converter(IptcData& iptcData, XmpData& xmpData, const char* iptcCharset = nullptr);
   //@}
 
+  //! Structure to define a source key a conversion reads besides its first key.
+  struct Dependency {
+    const char* key1_;  //!< First key of the conversion.
+    const char* key_;   //!< Other key read by the conversion.
+  };
+
   //! @name Manipulators
   //@{
-  //! Convert Exif tags or IPTC datasets to XMP properties according to the conversion table.
-  void cnvToXmp();
-  //! Convert XMP properties to Exif tags or IPTC datasets according to the conversion table.
-  void cnvFromXmp();
+  /*!
+    @brief Convert Exif tags or IPTC datasets to XMP properties according to the conversion table.
+           If \em since is not 0, only convert the tags or datasets that changed after that
+           generation of their container.
+   */
+  void cnvToXmp(uint64_t since = 0);
+  /*!
+    @brief Convert XMP properties to Exif tags or IPTC datasets according to the conversion table.
+           If \em since is not 0, only convert the properties that changed after that generation
+           of the XMP container.
+   */
+  void cnvFromXmp(uint64_t since = 0);
   /*!
     @brief Set the erase flag.
 
@@ -273,10 +289,22 @@ class Converter {
   bool prepareExifTarget(const char* to, bool force = false);
   bool prepareIptcTarget(const char* to, bool force = false);
   bool prepareXmpTarget(const char* to, bool force = false);
-  std::string computeExifDigest(bool tiff);
+  //! The tiff:NativeDigest and exif:NativeDigest of the Exif data
+  using Digests = std::pair<std::string, std::string>;
+  //! Compute both digests in one pass over the Exif data
+  [[nodiscard]] Digests computeExifDigests() const;
+  //! Write digests computed before to XMP, see writeExifDigest()
+  void writeExifDigest(const Digests& digests);
+  /*!
+    @brief Return the positions of the applicable rules in the conversion table, in order.
+           If \em since is not 0, only those with source keys in \em changes that changed
+           after \em since.
+   */
+  [[nodiscard]] std::vector<size_t> rules(const ChangeLog& changes, uint64_t since, bool fromXmp) const;
 
   // DATA
-  static const Conversion conversion_[];  //!< Conversion rules
+  static const Conversion conversion_[];    //!< Conversion rules
+  static const Dependency dependencies_[];  //!< Other source keys of the conversion rules
   bool erase_{false};
   bool overwrite_{true};
   ExifData* exifData_;
@@ -491,6 +519,20 @@ const Converter::Conversion Converter::conversion_[] = {
 
 };
 
+// Source keys of the conversions from Exif other than their first key
+const Converter::Dependency Converter::dependencies_[] = {
+    {"Exif.Image.DateTime", "Exif.Photo.SubSecTime"},
+    {"Exif.Photo.DateTimeOriginal", "Exif.Photo.SubSecTimeOriginal"},
+    {"Exif.Photo.DateTimeDigitized", "Exif.Photo.SubSecTimeDigitized"},
+    {"Exif.GPSInfo.GPSTimeStamp", "Exif.GPSInfo.GPSDateStamp"},
+    {"Exif.GPSInfo.GPSTimeStamp", "Exif.Photo.DateTimeOriginal"},
+    {"Exif.GPSInfo.GPSTimeStamp", "Exif.Photo.DateTimeDigitized"},
+    {"Exif.GPSInfo.GPSLatitude", "Exif.GPSInfo.GPSLatitudeRef"},
+    {"Exif.GPSInfo.GPSLongitude", "Exif.GPSInfo.GPSLongitudeRef"},
+    {"Exif.GPSInfo.GPSDestLatitude", "Exif.GPSInfo.GPSDestLatitudeRef"},
+    {"Exif.GPSInfo.GPSDestLongitude", "Exif.GPSInfo.GPSDestLongitudeRef"},
+};
+
 Converter::Converter(ExifData& exifData, XmpData& xmpData) :
     exifData_(&exifData), iptcData_(nullptr), xmpData_(&xmpData), iptcCharset_(nullptr) {
 }
@@ -499,19 +541,63 @@ Converter::Converter(IptcData& iptcData, XmpData& xmpData, const char* iptcChars
     exifData_(nullptr), iptcData_(&iptcData), xmpData_(&xmpData), iptcCharset_(iptcCharset) {
 }
 
-void Converter::cnvToXmp() {
-  for (auto&& c : conversion_) {
-    if ((c.metadataId_ == mdExif && exifData_) || (c.metadataId_ == mdIptc && iptcData_)) {
-      std::invoke(c.key1ToKey2_, *this, c.key1_, c.key2_);
+std::vector<size_t> Converter::rules(const ChangeLog& changes, uint64_t since, bool fromXmp) const {
+  const auto metadataId = exifData_ ? mdExif : mdIptc;
+  std::vector<size_t> rules;
+  if (since == 0 || changes.allChangedSince(since)) {
+    for (size_t i = 0; i < std::size(conversion_); ++i) {
+      if (conversion_[i].metadataId_ == metadataId)
+        rules.push_back(i);
     }
+    return rules;
   }
-}
 
-void Converter::cnvFromXmp() {
-  for (auto&& c : conversion_) {
-    if ((c.metadataId_ == mdExif && exifData_) || (c.metadataId_ == mdIptc && iptcData_)) {
-      std::invoke(c.key2ToKey1_, *this, c.key2_, c.key1_);
+  // Positions of the rules by source key: the first key and its dependencies for
+  // conversions to XMP, the XMP property for conversions from XMP
+  using Index = std::unordered_map<std::string_view, std::vector<size_t>>;
+  static const auto index = [] {
+    std::pair<Index, Index> byKeys;
+    for (size_t i = 0; i < std::size(conversion_); ++i) {
+      byKeys.first[conversion_[i].key1_].push_back(i);
+      byKeys.second[conversion_[i].key2_].push_back(i);
+    }
+    for (auto&& d : dependencies_) {
+      for (auto i : byKeys.first.at(d.key1_))
+        byKeys.first[d.key_].push_back(i);
     }
+    return byKeys;
+  }();
+
+  const auto& byKey = fromXmp ? index.second : index.first;
+  for (const auto& key : changes.changedSince(since)) {
+    std::string_view k(key);
+    // Conversions from XMP read the fields and items of the property, too
+    if (fromXmp)
+      k = k.substr(0, k.find_first_of("/["));
+    if (auto i = byKey.find(k); i != byKey.end()) {
+      for (auto rule : i->second) {
+        if (conversion_[rule].metadataId_ == metadataId)
+          rules.push_back(rule);
+      }
+    }
+  }
+  std::sort(rules.begin(), rules.end());
+  rules.erase(std::unique(rules.begin(), rules.end()), rules.end());
+  return rules;
+}
+
+void Converter::cnvToXmp(uint64_t since) {
+  const auto& changes = exifData_ ? exifData_->changes_ : iptcData_->changes_;
+  for (auto i : rules(changes, since, false)) {
+    const auto& c = conversion_[i];
+    std::invoke(c.key1ToKey2_, *this, c.key1_, c.key2_);
+  }
+}
+
+void Converter::cnvFromXmp(uint64_t since) {
+  for (auto i : rules(xmpData_->changes_, since, true)) {
+    const auto& c = conversion_[i];
+    std::invoke(c.key2ToKey1_, *this, c.key2_, c.key1_);
   }
 }
 
@@ -1235,48 +1321,91 @@ void Converter::cnvXmpValueToIptc(const char* from, const char* to) {
 }
 
 #ifdef EXV_HAVE_XMP_TOOLKIT
-std::string Converter::computeExifDigest(bool tiff) {
-  std::string res;
-  MD5_CTX context;
-  unsigned char digest[16];
+namespace {
+//! The tags of the Exif conversion rules, in the order the digests hash them
+struct DigestTags {
+  std::vector<std::pair<uint32_t, bool>> tags_;    //!< (IFD << 16 | tag, tiff digest) per rule
+  std::unordered_map<uint32_t, size_t> index_;     //!< Position of the first rule for a tag
+  std::string lists_[2];                           //!< Tag lists of the exif and tiff digests
+};
 
-  MD5Init(&context);
-  for (auto&& c : conversion_) {
-    if (c.metadataId_ == mdExif) {
-      Exiv2::ExifKey key(c.key1_);
-      if (tiff && key.groupName() != "Image")
-        continue;
-      if (!tiff && key.groupName() == "Image")
-        continue;
+uint32_t digestTag(IfdId ifdId, uint16_t tag) {
+  return static_cast<uint32_t>(ifdId) << 16 | tag;
+}
 
-      if (!res.empty())
-        res += ',';
-      res += std::to_string(key.tag());
-      auto pos = exifData_->findKey(key);
-      if (pos == exifData_->end())
-        continue;
-      DataBuf data(pos->size());
-      pos->copy(data.data(), littleEndian /* FIXME ? */);
-      MD5Update(&context, data.c_data(), static_cast<uint32_t>(data.size()));
-    }
-  }
+std::string digestString(const std::string& tagList, MD5_CTX& context) {
+  constexpr char hex[] = "0123456789ABCDEF";
+  unsigned char digest[16];
   MD5Final(digest, &context);
+  std::string res;
+  res.reserve(tagList.size() + 1 + 2 * sizeof(digest));
+  res += tagList;
   res += ';';
   for (const auto& i : digest) {
-    res += stringFormat("{:02X}", i);
+    res += hex[i >> 4];
+    res += hex[i & 0x0f];
   }
   return res;
 }
+}  // namespace
+
+Converter::Digests Converter::computeExifDigests() const {
+  // Parse the keys of the rules only once
+  static const DigestTags digestTags = [] {
+    DigestTags d;
+    for (auto&& c : conversion_) {
+      if (c.metadataId_ != mdExif)
+        continue;
+      const ExifKey key(c.key1_);
+      const bool tiff = key.groupName() == "Image";
+      const auto tag = digestTag(key.ifdId(), key.tag());
+      d.index_.try_emplace(tag, d.tags_.size());
+      d.tags_.emplace_back(tag, tiff);
+      auto& list = d.lists_[tiff];
+      if (!list.empty())
+        list += ',';
+      list += std::to_string(key.tag());
+    }
+    return d;
+  }();
+
+  // The first datum of each rule, in one pass over the Exif data
+  std::vector<const Exifdatum*> found(digestTags.tags_.size());
+  for (const auto& datum : exifData_->exifMetadata_) {
+    auto pos = digestTags.index_.find(digestTag(datum.ifdId(), datum.tag()));
+    if (pos != digestTags.index_.end() && !found[pos->second])
+      found[pos->second] = &datum;
+  }
+
+  MD5_CTX context[2];
+  MD5Init(&context[0]);
+  MD5Init(&context[1]);
+  std::vector<byte> buf;
+  for (size_t i = 0; i < found.size(); ++i) {
+    if (!found[i])
+      continue;
+    const size_t size = found[i]->size();
+    if (buf.size() < size)
+      buf.resize(size);
+    found[i]->copy(buf.data(), littleEndian /* FIXME ? */);
+    MD5Update(&context[digestTags.tags_[i].second], buf.data(), static_cast<uint32_t>(size));
+  }
+  return {digestString(digestTags.lists_[1], context[1]), digestString(digestTags.lists_[0], context[0])};
+}
 #else
-std::string Converter::computeExifDigest(bool) {
+Converter::Digests Converter::computeExifDigests() const {
   return {};
 }
 #endif
 
 void Converter::writeExifDigest() {
+  writeExifDigest(computeExifDigests());
+}
+
+void Converter::writeExifDigest([[maybe_unused]] const Digests& digests) {
 #ifdef EXV_HAVE_XMP_TOOLKIT
-  (*xmpData_)["Xmp.tiff.NativeDigest"] = computeExifDigest(true);
-  (*xmpData_)["Xmp.exif.NativeDigest"] = computeExifDigest(false);
+  (*xmpData_)["Xmp.tiff.NativeDigest"] = digests.first;
+  (*xmpData_)["Xmp.exif.NativeDigest"] = digests.second;
 #endif
 }
 
@@ -1284,7 +1413,8 @@ void Converter::syncExifWithXmp() {
   auto td = xmpData_->findKey(XmpKey("Xmp.tiff.NativeDigest"));
   auto ed = xmpData_->findKey(XmpKey("Xmp.exif.NativeDigest"));
   if (td != xmpData_->end() && ed != xmpData_->end()) {
-    if (td->value().toString() == computeExifDigest(true) && ed->value().toString() == computeExifDigest(false)) {
+    const auto digests = computeExifDigests();
+    if (td->value().toString() == digests.first && ed->value().toString() == digests.second) {
       // We have both digests and the values match
       // XMP is up-to-date, we should update Exif
       setOverwrite(true);
@@ -1299,8 +1429,9 @@ void Converter::syncExifWithXmp() {
     setOverwrite(true);
     setErase(false);
 
+    // Converting to XMP leaves the Exif data, and so its digests, as they are
     cnvToXmp();
-    writeExifDigest();
+    writeExifDigest(digests);
     return;
   }
   // We don't have both digests, it is probably the first conversion to XMP
@@ -1320,6 +1451,12 @@ void copyExifToXmp(const ExifData& exifData, XmpData& xmpData) {
   converter.cnvToXmp();
 }
 
+uint64_t copyExifToXmp(const ExifData& exifData, XmpData& xmpData, uint64_t since) {
+  Converter converter(const_cast<ExifData&>(exifData), xmpData);
+  converter.cnvToXmp(since);
+  return exifData.generation();
+}
+
 /// \todo not used internally. We should at least have unit tests for this.
 void moveExifToXmp(ExifData& exifData, XmpData& xmpData) {
   Converter converter(exifData, xmpData);
@@ -1332,6 +1469,12 @@ void copyXmpToExif(const XmpData& xmpData, ExifData& exifData) {
   converter.cnvFromXmp();
 }
 
+uint64_t copyXmpToExif(const XmpData& xmpData, ExifData& exifData, uint64_t since) {
+  Converter converter(exifData, const_cast<XmpData&>(xmpData));
+  converter.cnvFromXmp(since);
+  return xmpData.generation();
+}
+
 /// \todo not used internally. We should at least have unit tests for this.
 void moveXmpToExif(XmpData& xmpData, ExifData& exifData) {
   Converter converter(exifData, xmpData);
@@ -1354,6 +1497,17 @@ void copyIptcToXmp(const IptcData& iptcData, XmpData& xmpData, const char* iptcC
   converter.cnvToXmp();
 }
 
+uint64_t copyIptcToXmp(const IptcData& iptcData, XmpData& xmpData, const char* iptcCharset, uint64_t since) {
+  if (!iptcCharset)
+    iptcCharset = iptcData.detectCharset();
+  if (!iptcCharset)
+    iptcCharset = "ISO-8859-1";
+
+  Converter converter(const_cast<IptcData&>(iptcData), xmpData, iptcCharset);
+  converter.cnvToXmp(since);
+  return iptcData.generation();
+}
+
 /// \todo not used internally. We should at least have unit tests for this.
 void moveIptcToXmp(IptcData& iptcData, XmpData& xmpData, const char* iptcCharset) {
   if (!iptcCharset)
@@ -1370,6 +1524,12 @@ void copyXmpToIptc(const XmpData& xmpData, IptcData& iptcData) {
   converter.cnvFromXmp();
 }
 
+uint64_t copyXmpToIptc(const XmpData& xmpData, IptcData& iptcData, uint64_t since) {
+  Converter converter(iptcData, const_cast<XmpData&>(xmpData));
+  converter.cnvFromXmp(since);
+  return xmpData.generation();
+}
+
 /// \todo not used internally. We should at least have unit tests for this.
 void moveXmpToIptc(XmpData& xmpData, IptcData& iptcData) {
   Converter converter(iptcData, xmpData);
@@ -448,6 +448,7 @@ Exifdatum& ExifData::operator[](const std::string& key) {
   ExifKey exifKey(key);
   auto pos = findKey(exifKey);
   if (pos == end()) {
+    changes_.touch(exifKey.key());
     return exifMetadata_.emplace_back(exifKey);
   }
   return *pos;
@@ -458,39 +459,73 @@ void ExifData::add(const ExifKey& key, const Value* pValue) {
 }
 
 void ExifData::add(const Exifdatum& exifdatum) {
+  // A makernote tag must not end up before the deferred tags it may duplicate
+  if (deferred_ && isMakerIfd(exifdatum.ifdId()))
+    expand();
   // allow duplicates
+  changes_.touch(exifdatum.key());
   exifMetadata_.push_back(exifdatum);
 }
 
 ExifData::const_iterator ExifData::findKey(const ExifKey& key) const {
+  if (deferred_ && isMakerIfd(key.ifdId()))
+    expand();
   return std::find_if(exifMetadata_.begin(), exifMetadata_.end(), FindExifdatumByKey(key.key()));
 }
 
 ExifData::iterator ExifData::findKey(const ExifKey& key) {
-  return std::find_if(exifMetadata_.begin(), exifMetadata_.end(), FindExifdatumByKey(key.key()));
+  if (deferred_ && isMakerIfd(key.ifdId()))
+    expand();
+  auto pos = std::find_if(exifMetadata_.begin(), exifMetadata_.end(), FindExifdatumByKey(key.key()));
+  if (pos != exifMetadata_.end())
+    changes_.touch(key.key());
+  return pos;
 }
 
 void ExifData::clear() {
   exifMetadata_.clear();
+  deferred_ = nullptr;
+  changes_.touchAll();
 }
 
 void ExifData::sortByKey() {
+  expand();
   exifMetadata_.sort(cmpMetadataByKey);
 }
 
 void ExifData::sortByTag() {
+  expand();
   exifMetadata_.sort(cmpMetadataByTag);
 }
 
+void ExifData::expand() const {
+  if (!deferred_)
+    return;
+  auto deferred = std::move(deferred_);
+  deferred_ = nullptr;
+  deferred(exifMetadata_);
+}
+
+void ExifData::eraseIfd(IfdId ifdId) {
+  if (isMakerIfd(ifdId))
+    expand();
+  exifMetadata_.remove_if(FindExifdatum(ifdId));
+  changes_.touchAll();
+}
+
 ExifData::iterator ExifData::erase(ExifData::iterator beg, ExifData::iterator end) {
+  for (auto pos = beg; pos != end; ++pos)
+    changes_.touch(pos->key());
   return exifMetadata_.erase(beg, end);
 }
 
 ExifData::iterator ExifData::erase(ExifData::iterator pos) {
+  changes_.touch(pos->key());
   return exifMetadata_.erase(pos);
 }
 
-DecodeParams::DecodeParams(size_t max_recursion_depth) : max_recursion_depth_(max_recursion_depth) {
+DecodeParams::DecodeParams(size_t max_recursion_depth, bool lazy_makernotes, bool native_xmp) :
+    max_recursion_depth_(max_recursion_depth), lazy_makernotes_(lazy_makernotes), native_xmp_(native_xmp) {
 }
 
 ByteOrder ExifParser::decode(ExifData& exifData, const byte* pData, size_t size, const DecodeParams& dp) {
@@ -542,7 +577,11 @@ WriteMethod ExifParser::encode(Blob& blob, const byte* pData, size_t size, ByteO
       "Exif.Canon.AFFineRotation",
   };
   for (auto&& filteredIfd0Tag : filteredIfd0Tags) {
-    auto pos = exifData.findKey(ExifKey(filteredIfd0Tag));
+    ExifKey key(filteredIfd0Tag);
+    // Don't expand a deferred makernote for this, see below
+    if (exifData.deferred_ && isMakerIfd(key.ifdId()))
+      continue;
+    auto pos = exifData.findKey(key);
     if (pos != exifData.end()) {
 #ifdef EXIV2_DEBUG_MESSAGES
       std::cerr << "Warning: Exif tag " << pos->key() << " not encoded\n";
@@ -561,7 +600,7 @@ WriteMethod ExifParser::encode(Blob& blob, const byte* pData, size_t size, ByteO
 #ifdef EXIV2_DEBUG_MESSAGES
     std::cerr << "Warning: Exif IFD " << filteredIfd << " not encoded\n";
 #endif
-    eraseIfd(exifData, filteredIfd);
+    exifData.eraseIfd(filteredIfd);
   }
 
   // IPTC and XMP are stored elsewhere, not in the Exif APP1 segment.
@@ -573,6 +612,12 @@ WriteMethod ExifParser::encode(Blob& blob, const byte* pData, size_t size, ByteO
   TiffHeader header(byteOrder, 0x00000008, false);
   WriteMethod wm = TiffParserWorker::encode(mio1, pData, size, exifData, emptyIptc, emptyXmp, Tag::root,
                                             TiffMapping::findEncoder, &header, nullptr);
+  if (wm == wmIntrusive && exifData.deferred_) {
+    // Intrusive writing expands a deferred makernote. Expand it here and start
+    // over, so that the tags synthesized from it are filtered as well.
+    exifData.expand();
+    return encode(blob, pData, size, byteOrder, exifData);
+  }
   if (mio1.size() <= 65527) {
     append(blob, mio1.mmap(), mio1.size());
     return wm;
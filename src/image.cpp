@@ -111,13 +111,14 @@ constexpr Registry registry[] = {
 // needs to be before bmff because some ftyp files are handled as qt and
 // the rest should fall through to bmff
 #ifdef EXV_ENABLE_VIDEO
-    {ImageType::qtime, newQTimeInstance, isQTimeType, amRead, amNone, amRead, amNone},
+    {ImageType::qtime, newQTimeInstance, isQTimeType, amRead, amNone, amReadWrite, amNone},
     {ImageType::asf, newAsfInstance, isAsfType, amRead, amNone, amRead, amNone},
     {ImageType::riff, newRiffInstance, isRiffType, amRead, amNone, amRead, amNone},
     {ImageType::mkv, newMkvInstance, isMkvType, amRead, amNone, amRead, amNone},
 #endif  // EXV_ENABLE_VIDEO
 #ifdef EXV_ENABLE_BMFF
-    {ImageType::bmff, newBmffInstance, isBmffType, amRead, amRead, amRead, amNone},
+    // CR3 and JPEG XL files are BMFF too, but only HEIF and AVIF items can be written
+    {ImageType::bmff, newBmffInstance, isBmffType, amReadWrite, amRead, amReadWrite, amNone},
 #endif  // EXV_ENABLE_BMFF
 };
 
@@ -644,6 +645,10 @@ void Image::writeXmpFromPacket(bool) {
 }
 #endif
 
+void Image::lazyMakernotes(bool flag) {
+  lazyMakernotes_ = flag;
+}
+
 void Image::clearComment() {
   comment_.erase();
 }
@@ -729,6 +734,10 @@ bool Image::writeXmpFromPacket() const {
   return writeXmpFromPacket_;
 }
 
+bool Image::lazyMakernotes() const {
+  return lazyMakernotes_;
+}
+
 const NativePreviewList& Image::nativePreviews() const {
   return nativePreviews_;
 }
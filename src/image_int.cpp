@@ -1,13 +1,71 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "image_int.hpp"
+#include "basicio.hpp"
 
+#include <chrono>
 #include <cstddef>
 #include <string>
 
+#ifdef EXV_ENABLE_FILESYSTEM
+#include <filesystem>
+namespace fs = std::filesystem;
+#if !defined(_WIN32) && __has_include(<sys/stat.h>) && __has_include(<unistd.h>)
+#include <sys/stat.h>
+#include <unistd.h>
+#define EXV_KEEP_FILE_OWNER
+#endif
+#endif
+
 namespace Exiv2::Internal {
 [[nodiscard]] std::string indent(size_t i) {
   return std::string(2 * i, ' ');
 }
 
+namespace {
+#ifdef EXV_ENABLE_FILESYSTEM
+//! Temporary file, which is removed unless it has been transferred to its target
+class TempFileIo : public FileIo {
+ public:
+  using FileIo::FileIo;
+  ~TempFileIo() override {
+    close();
+    std::error_code ec;
+    fs::remove(path(), ec);
+  }
+};
+#endif
+}  // namespace
+
+std::unique_ptr<BasicIo> createTemporary([[maybe_unused]] const BasicIo& io) {
+#ifdef EXV_ENABLE_FILESYSTEM
+  if (dynamic_cast<const FileIo*>(&io)) {
+    std::error_code ec;
+    const fs::path path(io.path());
+    // Renaming over a symbolic link or one of several hard links would detach the file from them
+    if (fs::is_regular_file(fs::symlink_status(path, ec)) && fs::hard_link_count(path, ec) == 1) {
+      const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+      auto tempIo = std::make_unique<TempFileIo>(stringFormat("{}.{}.exiv2tmp", io.path(), stamp));
+      // The file which replaces io gets its owner and its permissions, else it is written in place
+      const auto perms = fs::status(path, ec).permissions();
+      bool keep = !ec && tempIo->open("w+b") == 0;
+#ifdef EXV_KEEP_FILE_OWNER
+      struct stat orig{};
+      struct stat temp{};
+      keep = keep && ::stat(path.c_str(), &orig) == 0 && ::stat(tempIo->path().c_str(), &temp) == 0 &&
+             ((orig.st_uid == temp.st_uid && orig.st_gid == temp.st_gid) ||
+              ::chown(tempIo->path().c_str(), orig.st_uid, orig.st_gid) == 0);
+#endif
+      if (keep) {
+        fs::permissions(tempIo->path(), perms, ec);
+        keep = !ec;
+      }
+      if (keep)
+        return tempIo;
+    }
+  }
+#endif
+  return std::make_unique<MemIo>();
+}
+
 }  // namespace Exiv2::Internal
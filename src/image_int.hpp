@@ -10,6 +10,7 @@
 #include "slice.hpp"  // for Slice
 
 #include <cstddef>  // for size_t
+#include <memory>
 #include <ostream>  // for ostream, basic_ostream::put
 #include <string>
 
@@ -25,6 +26,10 @@
 
 // *****************************************************************************
 // namespace extensions
+namespace Exiv2 {
+class BasicIo;
+}
+
 namespace Exiv2::Internal {
 // *****************************************************************************
 // class definitions
@@ -99,6 +104,15 @@ constexpr auto binaryToString(Slice<T>&& sl) noexcept {
 /// @brief indent output for kpsRecursive in \em printStructure() \em .
 std::string indent(size_t i);
 
+/*!
+  @brief Return the IO to write a new image to, which is then transferred to \em io.
+
+  That is a temporary file next to \em io if it is a file which can be replaced by
+  renaming the temporary file, so that image data is not held in memory. The
+  temporary file gets the permissions and the owner of \em io. Else a MemIo.
+ */
+std::unique_ptr<BasicIo> createTemporary(const BasicIo& io);
+
 }  // namespace Exiv2::Internal
 
 #endif  // #ifndef IMAGE_INT_HPP_
@@ -211,6 +211,7 @@ Iptcdatum& IptcData::operator[](const std::string& key) {
   IptcKey iptcKey(key);
   auto pos = findKey(iptcKey);
   if (pos == end()) {
+    changes_.touch(iptcKey.key());
     return iptcMetadata_.emplace_back(iptcKey);
   }
   return *pos;
@@ -241,6 +242,7 @@ int IptcData::add(const Iptcdatum& iptcDatum) {
     return 6;
   }
   // allow duplicates
+  changes_.touch(iptcDatum.key());
   iptcMetadata_.push_back(iptcDatum);
   return 0;
 }
@@ -250,7 +252,7 @@ IptcData::const_iterator IptcData::findKey(const IptcKey& key) const {
 }
 
 IptcData::iterator IptcData::findKey(const IptcKey& key) {
-  return std::find_if(iptcMetadata_.begin(), iptcMetadata_.end(), FindIptcdatum(key.tag(), key.record()));
+  return findId(key.tag(), key.record());
 }
 
 IptcData::const_iterator IptcData::findId(uint16_t dataset, uint16_t record) const {
@@ -258,7 +260,10 @@ IptcData::const_iterator IptcData::findId(uint16_t dataset, uint16_t record) con
 }
 
 IptcData::iterator IptcData::findId(uint16_t dataset, uint16_t record) {
-  return std::find_if(iptcMetadata_.begin(), iptcMetadata_.end(), FindIptcdatum(dataset, record));
+  auto pos = std::find_if(iptcMetadata_.begin(), iptcMetadata_.end(), FindIptcdatum(dataset, record));
+  if (pos != iptcMetadata_.end())
+    changes_.touch(pos->key());
+  return pos;
 }
 
 /// \todo not used internally. At least we should test it
@@ -272,6 +277,7 @@ void IptcData::sortByTag() {
 }
 
 IptcData::iterator IptcData::erase(IptcData::iterator pos) {
+  changes_.touch(pos->key());
   return iptcMetadata_.erase(pos);
 }
 
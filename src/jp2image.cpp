@@ -315,7 +315,7 @@ void Jp2Image::readMetadata() {
 #ifdef EXIV2_DEBUG_MESSAGES
                 std::cout << "Exiv2::Jp2Image::readMetadata: Exif header found at position " << pos << '\n';
 #endif
-                const DecodeParams dp(max_recursion_depth_);
+                const DecodeParams dp(max_recursion_depth_, lazyMakernotes());
                 ByteOrder bo = TiffParser::decode(exifData(), iptcData(), xmpData(), rawData.c_data(pos),
                                                   rawData.size() - pos, dp);
                 setByteOrder(bo);
@@ -191,7 +191,7 @@ void JpegBase::readMetadata() {
 
     if (!foundExifData && marker == app1_ && size >= 8  // prevent out-of-bounds read in memcmp on next line
         && buf.cmpBytes(2, exifId_.data(), 6) == 0) {
-      const DecodeParams dp(max_recursion_depth_);
+      const DecodeParams dp(max_recursion_depth_, lazyMakernotes());
       ByteOrder bo = ExifParser::decode(exifData_, buf.c_data(8), size - 8, dp);
       setByteOrder(bo);
       if (size > 8 && byteOrder() == invalidByteOrder) {
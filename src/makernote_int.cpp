@@ -39,12 +39,6 @@ namespace fs = std::filesystem;
 
 // *****************************************************************************
 namespace {
-// Todo: Can be generalized further - get any tag as a string/long/...
-//! Get the Value for a tag within a particular group
-const Exiv2::Value* getExifValue(Exiv2::Internal::TiffComponent* pRoot, uint16_t tag, Exiv2::IfdId group);
-//! Get the model name from tag Exif.Image.Model
-std::string getExifModel(Exiv2::Internal::TiffComponent* pRoot);
-
 //! Nikon en/decryption function
 void ncrypt(Exiv2::byte* pData, uint32_t size, uint32_t count, uint32_t serial);
 }  // namespace
@@ -907,7 +901,7 @@ constexpr NikonArrayIdx nikonArrayIdx[] = {
     {0x00b7, "0101", 84, 1, NA},  // tag 0xb7 in sample image metadata for each version
 };
 
-int nikonSelector(uint16_t tag, const byte* pData, size_t size, TiffComponent* /*pRoot*/) {
+int nikonSelector(uint16_t tag, const byte* pData, size_t size, MnContext& /*context*/) {
   if (size < 4)
     return -1;
 
@@ -917,7 +911,7 @@ int nikonSelector(uint16_t tag, const byte* pData, size_t size, TiffComponent* /
   return -1;
 }
 
-DataBuf nikonCrypt(uint16_t tag, const byte* pData, size_t size, TiffComponent* pRoot) {
+DataBuf nikonCrypt(uint16_t tag, const byte* pData, size_t size, MnContext& context) {
   DataBuf buf;
 
   if (size < 4)
@@ -927,23 +921,19 @@ DataBuf nikonCrypt(uint16_t tag, const byte* pData, size_t size, TiffComponent*
     return buf;
 
   // Find Exif.Nikon3.ShutterCount
-  TiffFinder finder(0x00a7, IfdId::nikon3Id);
-  pRoot->accept(finder);
-  auto te = dynamic_cast<const TiffEntryBase*>(finder.result());
-  if (!te || !te->pValue() || te->pValue()->count() == 0)
+  auto value = context.value(0x00a7, IfdId::nikon3Id);
+  if (!value || value->count() == 0)
     return buf;
-  auto count = te->pValue()->toUint32();
+  auto count = value->toUint32();
 
   // Find Exif.Nikon3.SerialNumber
-  finder.init(0x001d, IfdId::nikon3Id);
-  pRoot->accept(finder);
-  te = dynamic_cast<const TiffEntryBase*>(finder.result());
-  if (!te || !te->pValue() || te->pValue()->count() == 0)
+  value = context.value(0x001d, IfdId::nikon3Id);
+  if (!value || value->count() == 0)
     return buf;
   bool ok(false);
-  auto serial = stringTo<uint32_t>(te->pValue()->toString(), ok);
+  auto serial = stringTo<uint32_t>(value->toString(), ok);
   if (!ok) {
-    std::string model = getExifModel(pRoot);
+    std::string model = context.model();
     if (model.empty())
       return buf;
     if (Internal::contains(model, "D50")) {
@@ -958,8 +948,8 @@ DataBuf nikonCrypt(uint16_t tag, const byte* pData, size_t size, TiffComponent*
   return buf;
 }
 
-int sonyCsSelector(uint16_t /*tag*/, const byte* /*pData*/, size_t /*size*/, TiffComponent* pRoot) {
-  std::string model = getExifModel(pRoot);
+int sonyCsSelector(uint16_t /*tag*/, const byte* /*pData*/, size_t /*size*/, MnContext& context) {
+  std::string model = context.model();
   if (model.empty())
     return -1;
   int idx = 0;
@@ -968,32 +958,32 @@ int sonyCsSelector(uint16_t /*tag*/, const byte* /*pData*/, size_t /*size*/, Tif
   }
   return idx;
 }
-int sony2010eSelector(uint16_t /*tag*/, const byte* /*pData*/, size_t /*size*/, TiffComponent* pRoot) {
+int sony2010eSelector(uint16_t /*tag*/, const byte* /*pData*/, size_t /*size*/, MnContext& context) {
   static constexpr const char* models[] = {
       "SLT-A58",   "SLT-A99",  "ILCE-3000", "ILCE-3500", "NEX-3N",    "NEX-5R",   "NEX-5T",
       "NEX-6",     "VG30E",    "VG900",     "DSC-RX100", "DSC-RX1",   "DSC-RX1R", "DSC-HX300",
       "DSC-HX50V", "DSC-TX30", "DSC-WX60",  "DSC-WX200", "DSC-WX300",
   };
-  return Exiv2::find(models, getExifModel(pRoot)) ? 0 : -1;
+  return Exiv2::find(models, context.model()) ? 0 : -1;
 }
 
-int sony2FpSelector(uint16_t /*tag*/, const byte* /*pData*/, size_t /*size*/, TiffComponent* pRoot) {
+int sony2FpSelector(uint16_t /*tag*/, const byte* /*pData*/, size_t /*size*/, MnContext& context) {
   // Not valid for models beginning
-  std::string model = getExifModel(pRoot);
+  std::string model = context.model();
   for (auto str : {"SLT-", "HV", "ILCA-"})
     if (model.starts_with(str))
       return -1;
   return 0;
 }
 
-int sonyMisc2bSelector(uint16_t /*tag*/, const byte* /*pData*/, size_t /*size*/, TiffComponent* pRoot) {
+int sonyMisc2bSelector(uint16_t /*tag*/, const byte* /*pData*/, size_t /*size*/, MnContext& context) {
   // From Exiftool: https://github.com/exiftool/exiftool/blob/master/lib/Image/ExifTool/Sony.pm
   // >  First byte must be 9 or 12 or 13 or 15 or 16 and 4th byte must be 2 (deciphered)
 
   // Get the value from the image format that is being used
-  auto value = getExifValue(pRoot, 0x9404, Exiv2::IfdId::sony1Id);
+  auto value = context.value(0x9404, IfdId::sony1Id);
   if (!value) {
-    value = getExifValue(pRoot, 0x9404, Exiv2::IfdId::sony2Id);
+    value = context.value(0x9404, IfdId::sony2Id);
     if (!value)
       return -1;
   }
@@ -1013,14 +1003,14 @@ int sonyMisc2bSelector(uint16_t /*tag*/, const byte* /*pData*/, size_t /*size*/,
   }
   return -1;
 }
-int sonyMisc3cSelector(uint16_t /*tag*/, const byte* /*pData*/, size_t /*size*/, TiffComponent* pRoot) {
+int sonyMisc3cSelector(uint16_t /*tag*/, const byte* /*pData*/, size_t /*size*/, MnContext& context) {
   // For condition, see Exiftool (Tag 9400c):
   // https://github.com/exiftool/exiftool/blob/2200871d9cef988051d2a99d67df3bda6cbb30a8/lib/Image/ExifTool/Sony.pm#L1826
 
   // Get the value from the image format that is being used
-  auto value = getExifValue(pRoot, 0x9400, Exiv2::IfdId::sony1Id);
+  auto value = context.value(0x9400, IfdId::sony1Id);
   if (!value) {
-    value = getExifValue(pRoot, 0x9400, Exiv2::IfdId::sony2Id);
+    value = context.value(0x9400, IfdId::sony2Id);
     if (!value)
       return -1;
   }
@@ -1051,21 +1041,6 @@ int sonyMisc3cSelector(uint16_t /*tag*/, const byte* /*pData*/, size_t /*size*/,
 // *****************************************************************************
 // local definitions
 namespace {
-const Exiv2::Value* getExifValue(Exiv2::Internal::TiffComponent* pRoot, uint16_t tag, Exiv2::IfdId group) {
-  Exiv2::Internal::TiffFinder finder(tag, group);
-  if (!pRoot)
-    return nullptr;
-  pRoot->accept(finder);
-  auto te = dynamic_cast<const Exiv2::Internal::TiffEntryBase*>(finder.result());
-  return (!te || !te->pValue()) ? nullptr : te->pValue();
-}
-
-std::string getExifModel(Exiv2::Internal::TiffComponent* pRoot) {
-  // Lookup the Exif.Image.Model tag
-  const auto value = getExifValue(pRoot, 0x0110, Exiv2::IfdId::ifd0Id);
-  return (!value || value->count() == 0) ? std::string() : value->toString();
-}
-
 void ncrypt(Exiv2::byte* pData, uint32_t size, uint32_t count, uint32_t serial) {
   static const Exiv2::byte xlat[2][256] = {
       {0xc1, 0xbf, 0x6d, 0x0d, 0x59, 0xc5, 0x13, 0x9d, 0x83, 0x61, 0x6b, 0x4f, 0xc7, 0x7f, 0x3d, 0x3d, 0x53, 0x59, 0xe3,
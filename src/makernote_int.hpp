@@ -18,7 +18,7 @@ namespace Exiv2 {
 enum class IfdId : uint32_t;
 namespace Internal {
 class IoWrapper;
-class TiffComponent;
+class MnContext;
 class TiffIfdMakernote;
 // *****************************************************************************
 // function prototypes
@@ -605,10 +605,10 @@ std::unique_ptr<TiffIfdMakernote> newCasio2Mn2(uint16_t tag, IfdId group, IfdId
   @param tag Tag number of the binary array
   @param pData Pointer to the raw array data.
   @param size Size of the array data.
-  @param pRoot Pointer to the root component of the TIFF tree.
+  @param context Access to the TIFF tree.
   @return An index into the array set, -1 if no match was found.
  */
-int sonyCsSelector(uint16_t tag, const byte* pData, size_t size, TiffComponent* pRoot);
+int sonyCsSelector(uint16_t tag, const byte* pData, size_t size, MnContext& context);
 
 /*!
     @brief Function to select cfg + def of the Sony 2010 Miscellaneous Information complex binary array.
@@ -616,10 +616,10 @@ int sonyCsSelector(uint16_t tag, const byte* pData, size_t size, TiffComponent*
     @param tag Tag number of the binary array
     @param pData Pointer to the raw array data.
     @param size Size of the array data.
-    @param pRoot Pointer to the root component of the TIFF tree.
+    @param context Access to the TIFF tree.
     @return An index into the array set, -1 if no match was found.
 */
-int sony2010eSelector(uint16_t tag, const byte* pData, size_t size, TiffComponent* pRoot);
+int sony2010eSelector(uint16_t tag, const byte* pData, size_t size, MnContext& context);
 
 /*!
     @brief Function to select cfg + def of the Sony2Fp (tag 9402) complex binary array.
@@ -627,10 +627,10 @@ int sony2010eSelector(uint16_t tag, const byte* pData, size_t size, TiffComponen
     @param tag Tag number of the binary array
     @param pData Pointer to the raw array data.
     @param size Size of the array data.
-    @param pRoot Pointer to the root component of the TIFF tree.
+    @param context Access to the TIFF tree.
     @return An index into the array set, -1 if no match was found.
 */
-int sony2FpSelector(uint16_t tag, const byte* pData, size_t size, TiffComponent* pRoot);
+int sony2FpSelector(uint16_t tag, const byte* pData, size_t size, MnContext& context);
 
 /*!
     @brief Function to select cfg + def of the SonyMisc2b (tag 9404b) complex binary array.
@@ -638,10 +638,10 @@ int sony2FpSelector(uint16_t tag, const byte* pData, size_t size, TiffComponent*
     @param tag Tag number of the binary array
     @param pData Pointer to the raw array data.
     @param size Size of the array data.
-    @param pRoot Pointer to the root component of the TIFF tree.
+    @param context Access to the TIFF tree.
     @return An index into the array set, -1 if no match was found.
 */
-int sonyMisc2bSelector(uint16_t tag, const byte* pData, size_t size, TiffComponent* pRoot);
+int sonyMisc2bSelector(uint16_t tag, const byte* pData, size_t size, MnContext& context);
 
 /*!
     @brief Function to select cfg + def of the SonyMisc3c (tag 9400) complex binary array.
@@ -649,10 +649,10 @@ int sonyMisc2bSelector(uint16_t tag, const byte* pData, size_t size, TiffCompone
     @param tag Tag number of the binary array
     @param pData Pointer to the raw array data.
     @param size Size of the array data.
-    @param pRoot Pointer to the root component of the TIFF tree.
+    @param context Access to the TIFF tree.
     @return An index into the array set, -1 if no match was found.
 */
-int sonyMisc3cSelector(uint16_t tag, const byte* pData, size_t size, TiffComponent* pRoot);
+int sonyMisc3cSelector(uint16_t tag, const byte* pData, size_t size, MnContext& context);
 
 /*!
   @brief Function to select cfg + def of a Nikon complex binary array.
@@ -660,10 +660,10 @@ int sonyMisc3cSelector(uint16_t tag, const byte* pData, size_t size, TiffCompone
   @param tag Tag number of the binary array
   @param pData Pointer to the raw array data.
   @param size Size of the array data.
-  @param pRoot Pointer to the root component of the TIFF tree.
+  @param context Access to the TIFF tree.
   @return An index into the array set, -1 if no match was found.
  */
-int nikonSelector(uint16_t tag, const byte* pData, size_t size, TiffComponent* pRoot);
+int nikonSelector(uint16_t tag, const byte* pData, size_t size, MnContext& context);
 
 /*!
   @brief Encrypt and decrypt Nikon data.
@@ -677,11 +677,11 @@ int nikonSelector(uint16_t tag, const byte* pData, size_t size, TiffComponent* p
   @param tag Tag number of the binary array
   @param pData Pointer to the start of the data to en/decrypt.
   @param size Size of the data buffer.
-  @param pRoot Pointer to the root element of the composite.
+  @param context Access to the TIFF tree.
   @return En/decrypted data. Ownership of the memory is passed to the caller.
           The buffer may be empty in case no decryption was needed.
  */
-DataBuf nikonCrypt(uint16_t tag, const byte* pData, size_t size, TiffComponent* pRoot);
+DataBuf nikonCrypt(uint16_t tag, const byte* pData, size_t size, MnContext& context);
 
 }  // namespace Internal
 }  // namespace Exiv2
@@ -28,9 +28,13 @@
 #include "helper_functions.hpp"
 
 // + standard includes
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
+#include <map>
+#include <numeric>
+#include <vector>
 // *****************************************************************************
 // class member definitions
 namespace Exiv2::Internal {
@@ -626,12 +630,119 @@ void MatroskaVideo::readMetadata() {
   xmpData_["Xmp.video.FileSize"] = io_->size() / bytesMB;
   xmpData_["Xmp.video.MimeType"] = mimeType();
 
-  while (continueTraversing_)
-    decodeBlock();
+  // The EBML header, then the segment through its SeekHead or, without one, up to the first cluster
+  uint64_t id = 0;
+  uint64_t size = 0;
+  if (readElementHeader(*io_, id, size)) {
+    const size_t end = io_->tell() + std::min<uint64_t>(size, io_->size() - io_->tell());
+    while (continueTraversing_ && io_->tell() < end)
+      decodeBlock();
+  }
+  const size_t segment = io_->tell();
+  if (continueTraversing_ && !decodeIndexedElements()) {
+    io_->seek(segment, BasicIo::beg);
+    while (continueTraversing_)
+      decodeBlock();
+  }
 
   xmpData_["Xmp.video.AspectRatio"] = getAspectRatio(width_, height_);
 }
 
+bool MatroskaVideo::readElementHeader(BasicIo& io, uint64_t& id, uint64_t& size) {
+  byte buf[8];
+  for (auto value : {&id, &size}) {
+    if (io.read(buf, 1) != 1)
+      return false;
+    const uint32_t length = findBlockSize(buf[0]);  // 0-8
+    if (length == 0 || io.read(buf + 1, length - 1) != length - 1)
+      return false;
+    *value = returnTagValue(buf, length);
+  }
+  return true;
+}
+
+bool MatroskaVideo::decodeIndexedElements() {
+  // A SeekHead larger than this indexes the clusters, too; the linear scan is cheaper then
+  const uint64_t maxSeekHeadSize = 1024 * 1024;
+
+  uint64_t id = 0;
+  uint64_t size = 0;
+  if (!readElementHeader(*io_, id, size) || id != SegmentHeader)
+    return false;
+  const size_t segment = io_->tell();
+
+  // The position of each indexed element in the file. A SeekHead may refer to a second one.
+  std::map<uint64_t, size_t> index;
+  std::vector<size_t> seekHeads{segment};
+  for (size_t i = 0; i < seekHeads.size() && i < 2; ++i) {
+    io_->seek(seekHeads[i], BasicIo::beg);
+    if (!readElementHeader(*io_, id, size) || id != SeekHead || size > maxSeekHeadSize ||
+        size > io_->size() - io_->tell())
+      break;
+    DataBuf data(size);
+    io_->readOrThrow(data.data(), data.size(), ErrorCode::kerCorruptedMetadata);
+
+    MemIo seekHead(data.c_data(), data.size());
+    while (readElementHeader(seekHead, id, size) && size <= seekHead.size() - seekHead.tell()) {
+      const size_t seekEnd = seekHead.tell() + size;
+      if (id != Seek) {
+        seekHead.seek(seekEnd, BasicIo::beg);
+        continue;
+      }
+      uint64_t target = 0;
+      uint64_t position = 0;
+      bool hasPosition = false;
+      while (seekHead.tell() < seekEnd && readElementHeader(seekHead, id, size) && size <= seekEnd - seekHead.tell()) {
+        if ((id != SeekID && id != SeekPosition) || size == 0 || size > 8) {
+          seekHead.seek(size, BasicIo::cur);
+          continue;
+        }
+        byte buf[8];
+        seekHead.read(buf, size);
+        if (id == SeekID && findBlockSize(buf[0]) == size) {
+          target = returnTagValue(buf, size);
+        } else if (id == SeekPosition) {
+          position = std::accumulate(buf, buf + size, uint64_t{0}, [](uint64_t v, byte b) { return (v << 8) | b; });
+          hasPosition = true;
+        }
+      }
+      if (target && hasPosition && position < io_->size() - segment) {
+        index.try_emplace(target, segment + position);
+        if (target == SeekHead && std::find(seekHeads.begin(), seekHeads.end(), segment + position) == seekHeads.end())
+          seekHeads.push_back(segment + position);
+      }
+      seekHead.seek(seekEnd, BasicIo::beg);
+    }
+  }
+  if (!index.count(Info) || !index.count(Tracks))
+    return false;
+
+  // Check the elements before decoding any, in the order of the file
+  std::vector<std::pair<size_t, size_t>> elements;
+  for (auto element : {Info, Tracks, Tags}) {
+    auto it = index.find(element);
+    if (it == index.end())
+      continue;
+    io_->seek(it->second, BasicIo::beg);
+    if (!readElementHeader(*io_, id, size) || id != element) {
+      if (element != Tags)
+        return false;
+      continue;
+    }
+    elements.emplace_back(it->second, io_->tell() + std::min<uint64_t>(size, io_->size() - io_->tell()));
+  }
+  std::sort(elements.begin(), elements.end());
+
+  for (auto [start, end] : elements) {
+    io_->seek(start, BasicIo::beg);
+    continueTraversing_ = true;
+    while (continueTraversing_ && io_->tell() < end)
+      decodeBlock();
+  }
+  continueTraversing_ = false;
+  return true;
+}
+
 void MatroskaVideo::decodeBlock() {
   byte buf[8];
   io_->read(buf, 1);
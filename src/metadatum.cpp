@@ -32,4 +32,37 @@ bool cmpMetadataByKey(const Metadatum& lhs, const Metadatum& rhs) {
   return lhs.key() < rhs.key();
 }
 
+ChangeLog& ChangeLog::operator=(const ChangeLog& rhs) {
+  if (this != &rhs)
+    touchAll();
+  return *this;
+}
+
+void ChangeLog::touch(const std::string& key) {
+  ++generation_;
+  if (recording_)
+    changed_[key] = generation_;
+  else
+    allChanged_ = generation_;
+}
+
+void ChangeLog::touchAll() {
+  allChanged_ = ++generation_;
+  changed_.clear();
+}
+
+uint64_t ChangeLog::generation() const {
+  recording_ = true;
+  return generation_;
+}
+
+std::vector<std::string> ChangeLog::changedSince(uint64_t since) const {
+  std::vector<std::string> keys;
+  for (const auto& [key, generation] : changed_) {
+    if (generation > since)
+      keys.push_back(key);
+  }
+  return keys;
+}
+
 }  // namespace Exiv2
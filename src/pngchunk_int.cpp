@@ -24,6 +24,7 @@
 #include <cstdio>
 #include <cstring>
 #include <iostream>
+#include <limits>
 #include <string>
 
 /*
@@ -48,9 +49,10 @@ void PngChunk::decodeIHDRChunk(const DataBuf& data, uint32_t* outWidth, uint32_t
   *outHeight = data.read_uint32(4, bigEndian);
 }
 
-void PngChunk::decodeTXTChunk(Image* pImage, const DataBuf& data, TxtChunkType type, const DecodeParams& dp) {
+void PngChunk::decodeTXTChunk(Image* pImage, const DataBuf& data, TxtChunkType type, const DecodeParams& dp,
+                              size_t maxSize) {
   DataBuf key = keyTXTChunk(data);
-  DataBuf arr = parseTXTChunk(data, key.size(), type);
+  DataBuf arr = parseTXTChunk(data, key.size(), type, maxSize);
 
 #ifdef EXIV2_DEBUG_MESSAGES
   std::cout << "Exiv2::PngChunk::decodeTXTChunk: TXT chunk data: " << std::string(arr.c_str(), arr.size()) << '\n';
@@ -59,13 +61,13 @@ void PngChunk::decodeTXTChunk(Image* pImage, const DataBuf& data, TxtChunkType t
     parseChunkContent(pImage, key.c_data(), key.size(), arr, dp);
 }
 
-DataBuf PngChunk::decodeTXTChunk(const DataBuf& data, TxtChunkType type) {
+DataBuf PngChunk::decodeTXTChunk(const DataBuf& data, TxtChunkType type, size_t maxSize) {
   DataBuf key = keyTXTChunk(data);
 
 #ifdef EXIV2_DEBUG_MESSAGES
   std::cout << "Exiv2::PngChunk::decodeTXTChunk: TXT chunk key: " << std::string(key.c_str(), key.size()) << '\n';
 #endif
-  return parseTXTChunk(data, key.size(), type);
+  return parseTXTChunk(data, key.size(), type, maxSize);
 }
 
 DataBuf PngChunk::keyTXTChunk(const DataBuf& data, bool stripHeader) {
@@ -81,7 +83,7 @@ DataBuf PngChunk::keyTXTChunk(const DataBuf& data, bool stripHeader) {
   return {data.c_data() + offset, std::distance(data.begin(), it) - offset};
 }
 
-DataBuf PngChunk::parseTXTChunk(const DataBuf& data, size_t keysize, TxtChunkType type) {
+DataBuf PngChunk::parseTXTChunk(const DataBuf& data, size_t keysize, TxtChunkType type, size_t maxSize) {
   DataBuf arr;
 
   if (type == zTXt_Chunk) {
@@ -104,7 +106,7 @@ DataBuf PngChunk::parseTXTChunk(const DataBuf& data, size_t keysize, TxtChunkTyp
       const byte* compressedText = data.c_data(keysize + nullSeparators);
       enforce(compressedTextSize < data.size(), ErrorCode::kerCorruptedMetadata);
 
-      zlibUncompress(compressedText, static_cast<uint32_t>(compressedTextSize), arr);
+      zlibUncompress(compressedText, compressedTextSize, arr, maxSize);
     }
   } else if (type == tEXt_Chunk) {
     enforce(data.size() >= Safe::add(keysize, std::size_t{1}), ErrorCode::kerCorruptedMetadata);
@@ -166,7 +168,7 @@ DataBuf PngChunk::parseTXTChunk(const DataBuf& data, size_t keysize, TxtChunkTyp
 #endif
 
         // the compressed text comes after the translated keyword, but isn't null terminated
-        zlibUncompress(text, textsize, arr);
+        zlibUncompress(text, textsize, arr, maxSize);
       }
     }
   } else {
@@ -333,35 +335,50 @@ std::string PngChunk::makeMetadataChunk(std::string_view metadata, MetadataId ty
 
 }  // PngChunk::makeMetadataChunk
 
-void PngChunk::zlibUncompress(const byte* compressedText, unsigned int compressedTextSize, DataBuf& arr) {
-  uLongf uncompressedLen = compressedTextSize * 2;  // just a starting point
-  int zlibResult = Z_BUF_ERROR;
-  int dos = 0;
+void PngChunk::zlibUncompress(const byte* compressedText, size_t compressedTextSize, DataBuf& arr, size_t maxSize) {
+  if (!zlibInflate(compressedText, compressedTextSize, arr, maxSize)) {
+    throw Error(ErrorCode::kerFailedToReadImageData);
+  }
+}  // PngChunk::zlibUncompress
 
-  while (zlibResult == Z_BUF_ERROR) {
-    arr.alloc(uncompressedLen);
-    zlibResult = uncompress(arr.data(), &uncompressedLen, compressedText, compressedTextSize);
-    if (zlibResult == Z_OK) {
-      arr.resize(uncompressedLen);
-    } else if (zlibResult == Z_BUF_ERROR) {
-      // the uncompressedArray needs to be larger
-      uncompressedLen *= 2;
-      // DoS protection. can't be bigger than 64k
-      if (uncompressedLen > 131072) {
-        if (++dos > 1)
-          break;
-        uncompressedLen = 131072;
-      }
-    } else {
-      // something bad happened
-      throw Error(ErrorCode::kerFailedToReadImageData);
+bool PngChunk::zlibInflate(const byte* compressed, size_t compressedSize, DataBuf& arr, size_t maxSize) {
+  z_stream stream{};
+  if (inflateInit(&stream) != Z_OK)
+    return false;
+
+  // zlib counts in uInt, feed it the input and the output in pieces of at most that
+  constexpr size_t maxPiece = std::numeric_limits<uInt>::max();
+  stream.next_in = const_cast<byte*>(compressed);  // zlib does not write to the input
+  size_t unread = compressedSize;
+  size_t out = 0;
+  arr.alloc(std::min(std::max(Safe::add(compressedSize, compressedSize), size_t{1024}), maxSize));
+
+  int zlibResult = Z_OK;
+  while (zlibResult == Z_OK) {
+    if (out == arr.size()) {
+      if (out >= maxSize)
+        break;
+      arr.resize(std::min(Safe::add(out, out), maxSize));
     }
+    if (stream.avail_in == 0) {
+      stream.avail_in = static_cast<uInt>(std::min(unread, maxPiece));
+      unread -= stream.avail_in;
+    }
+    const auto avail = static_cast<uInt>(std::min(arr.size() - out, maxPiece));
+    stream.next_out = arr.data(out);
+    stream.avail_out = avail;
+    zlibResult = inflate(&stream, Z_NO_FLUSH);
+    out += avail - stream.avail_out;
   }
+  inflateEnd(&stream);
 
-  if (zlibResult != Z_OK) {
-    throw Error(ErrorCode::kerFailedToReadImageData);
+  if (zlibResult != Z_STREAM_END) {
+    arr.reset();
+    return false;
   }
-}  // PngChunk::zlibUncompress
+  arr.resize(out);
+  return true;
+}  // PngChunk::zlibInflate
 
 std::string PngChunk::zlibCompress(std::string_view text) {
   auto compressedLen = static_cast<uLongf>(text.size() * 2);  // just a starting point
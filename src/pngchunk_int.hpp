@@ -51,8 +51,10 @@ class PngChunk {
     @param pImage    Pointer to the image to hold the metadata
     @param data      PNG Chunk data buffer.
     @param type      PNG Chunk TXT type.
+    @param maxSize   Maximum size of the uncompressed text.
   */
-  static void decodeTXTChunk(Image* pImage, const DataBuf& data, TxtChunkType type, const DecodeParams& dp);
+  static void decodeTXTChunk(Image* pImage, const DataBuf& data, TxtChunkType type, const DecodeParams& dp,
+                             size_t maxSize);
 
   /*!
    @brief Decode PNG tEXt, zTXt, or iTXt chunk data from \em pImage passed by data buffer
@@ -60,8 +62,9 @@ class PngChunk {
 
    @param data      PNG Chunk data buffer.
    @param type      PNG Chunk TXT type.
+   @param maxSize   Maximum size of the uncompressed text.
    */
-  static DataBuf decodeTXTChunk(const DataBuf& data, TxtChunkType type);
+  static DataBuf decodeTXTChunk(const DataBuf& data, TxtChunkType type, size_t maxSize);
 
   /*!
     @brief Return PNG TXT chunk key as data buffer.
@@ -81,12 +84,19 @@ class PngChunk {
   */
   static std::string makeMetadataChunk(std::string_view metadata, MetadataId type);
 
+  /*!
+    @brief Inflate zlib data in one pass to \em arr, which grows as the output does.
+    @return false if the data is corrupt or inflates to more than \em maxSize bytes,
+            \em arr is then empty.
+   */
+  static bool zlibInflate(const byte* compressed, size_t compressedSize, DataBuf& arr, size_t maxSize);
+
  private:
   /*!
     @brief Parse PNG Text chunk to determine type and extract content.
            Supported Chunk types are tTXt, zTXt, and iTXt.
    */
-  static DataBuf parseTXTChunk(const DataBuf& data, size_t keysize, TxtChunkType type);
+  static DataBuf parseTXTChunk(const DataBuf& data, size_t keysize, TxtChunkType type, size_t maxSize);
 
   /*!
     @brief Parse PNG chunk contents to extract metadata container and assign it to image.
@@ -124,8 +134,9 @@ class PngChunk {
 
   /*!
     @brief Wrapper around zlib to uncompress a PNG chunk content.
+    @throw Error if the content is corrupt or uncompresses to more than \em maxSize bytes.
    */
-  static void zlibUncompress(const byte* compressedText, unsigned int compressedTextSize, DataBuf& arr);
+  static void zlibUncompress(const byte* compressedText, size_t compressedTextSize, DataBuf& arr, size_t maxSize);
 
   /*!
     @brief Wrapper around zlib to compress a PNG chunk content.
@@ -19,9 +19,16 @@
 #include "types.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 namespace {
 // Signature from front of PNG file
@@ -71,33 +78,24 @@ std::string PngImage::mimeType() const {
   return "image/png";
 }
 
-static bool zlibToDataBuf(const byte* bytes, uLongf length, DataBuf& result) {
-  uLongf uncompressedLen = length;  // just a starting point
-  int zlibResult = Z_BUF_ERROR;
+void PngImage::setMaxInflatedSize(size_t size) {
+  maxInflatedSize_ = size;
+}
 
-  while (zlibResult == Z_BUF_ERROR) {
-    result.alloc(uncompressedLen);
-    zlibResult = uncompress(result.data(), &uncompressedLen, bytes, length);
-    // if result buffer is large than necessary, redo to fit perfectly.
-    if (zlibResult == Z_OK && uncompressedLen < result.size()) {
-      result.reset();
+size_t PngImage::maxInflatedSize() const {
+  return maxInflatedSize_;
+}
 
-      result.alloc(uncompressedLen);
-      zlibResult = uncompress(result.data(), &uncompressedLen, bytes, length);
-    }
-    if (zlibResult == Z_BUF_ERROR) {
-      // the uncompressed buffer needs to be larger
-      result.reset();
+void PngImage::setVerifyChunks(bool flag) {
+  verifyChunks_ = flag;
+}
 
-      // Sanity - never bigger than 16mb
-      if (uncompressedLen > 16 * 1024 * 1024)
-        zlibResult = Z_DATA_ERROR;
-      else
-        uncompressedLen *= 2;
-    }
-  }
+bool PngImage::verifyChunks() const {
+  return verifyChunks_;
+}
 
-  return zlibResult == Z_OK;
+const std::vector<PngChunkCheck>& PngImage::chunkChecks() const {
+  return chunkChecks_;
 }
 
 static bool zlibToCompressed(const byte* bytes, uLongf length, DataBuf& result) {
@@ -295,9 +293,8 @@ void PngImage::printStructure(std::ostream& out, PrintStructureOption option, si
           bGood = tEXtToDataBuf(data.c_data(name_l), dataOffset - name_l, dataBuf);
         }
         if (zTXt || iCCP) {
-          enforce(dataOffset - name_l - 1 <= std::numeric_limits<uLongf>::max(), ErrorCode::kerCorruptedMetadata);
-          bGood = zlibToDataBuf(data.c_data(name_l + 1), static_cast<uLongf>(dataOffset - name_l - 1),
-                                dataBuf);  // +1 = 'compressed' flag
+          bGood = PngChunk::zlibInflate(data.c_data(name_l + 1), dataOffset - name_l - 1, dataBuf,
+                                        maxInflatedSize_);  // +1 = 'compressed' flag
         }
         if (iTXt) {
           bGood = (3 <= dataOffset) && (start < dataOffset - 3);  // good if not a nul chunk
@@ -354,7 +351,7 @@ void PngImage::printStructure(std::ostream& out, PrintStructureOption option, si
           }
 
           if (bDesc && iTXt) {
-            DataBuf decoded = PngChunk::decodeTXTChunk(buff, PngChunk::iTXt_Chunk);
+            DataBuf decoded = PngChunk::decodeTXTChunk(buff, PngChunk::iTXt_Chunk, maxInflatedSize_);
             out.write(decoded.c_str(), decoded.size());
             bLF = true;
           }
@@ -376,6 +373,128 @@ void PngImage::printStructure(std::ostream& out, PrintStructureOption option, si
   }
 }
 
+namespace {
+//! A chunk of a PNG image, as listed by indexChunks()
+struct PngChunkEntry {
+  std::array<char, 4> type_;  //!< Chunk type
+  size_t offset_;             //!< Offset of the chunk, its length field, in the file
+  uint32_t length_;           //!< Size of the chunk data
+  uint32_t crc_;              //!< CRC of the chunk as stored in the file
+
+  [[nodiscard]] std::string_view type() const {
+    return {type_.data(), type_.size()};
+  }
+  //! Offset of the end of the chunk, after its CRC
+  [[nodiscard]] size_t end() const {
+    return offset_ + 12 + length_;
+  }
+};
+
+/*!
+  @brief List the chunks of a PNG image from the current position of \em io,
+         after the signature, up to IEND, which is the last entry. Chunk data is
+         skipped and the CRC of a chunk is read together with the header of the
+         next one. The CRC of IEND is 0 if the file ends before it.
+  @param io      The image.
+  @param visitor Called with each chunk as soon as its header is read, before
+                 its CRC is known and the next chunk is looked at. It may move
+                 the position of \em io.
+  @throw Error if a chunk does not fit in the file or the file ends before IEND.
+ */
+std::vector<PngChunkEntry> indexChunks(BasicIo& io, const std::function<void(const PngChunkEntry&)>& visitor = {}) {
+  const size_t imgSize = io.size();
+  std::vector<PngChunkEntry> chunks;
+  std::array<byte, 12> buf{};  // CRC of a chunk and the header of the next one
+  size_t pos = io.tell();
+  size_t bufRead = io.read(buf.data() + 4, 8) + 4;
+
+  while (true) {
+    if (io.error())
+      throw Error(ErrorCode::kerFailedToReadImageData);
+    if (bufRead != buf.size())
+      throw Error(ErrorCode::kerInputDataReadFailed);
+    if (!chunks.empty())
+      chunks.back().crc_ = getULong(buf.data(), bigEndian);
+
+    PngChunkEntry chunk{};
+    chunk.offset_ = pos;
+    chunk.length_ = getULong(buf.data() + 4, bigEndian);
+    std::copy_n(buf.begin() + 8, 4, chunk.type_.begin());
+    pos += 8;
+    if (chunk.length_ > 0x7FFFFFFF || chunk.length_ > imgSize - pos)
+      throw Error(ErrorCode::kerFailedToReadImageData);
+    pos += chunk.length_;
+    chunks.push_back(chunk);
+    if (visitor)
+      visitor(chunk);
+
+    if (io.seek(pos, BasicIo::beg) != 0)
+      throw Error(ErrorCode::kerFailedToReadImageData);
+    if (chunk.type() == "IEND") {
+      if (io.read(buf.data(), 4) == 4)
+        chunks.back().crc_ = getULong(buf.data(), bigEndian);
+      return chunks;
+    }
+    bufRead = io.read(buf.data(), buf.size());
+    pos += 4;
+  }
+}
+
+/*!
+  @brief Compute the CRC of each chunk over its type and data, which are in \em data,
+         the mapped image. Chunks are cut in pieces of at most 1 MB, which are checked
+         on as many threads as there are cores and combined with crc32_combine(). Below
+         8 MB in all, starting the threads costs more than it saves and the pieces are
+         checked on this thread.
+ */
+std::vector<uint32_t> chunkCrcs(const byte* data, const std::vector<PngChunkEntry>& chunks) {
+  constexpr size_t pieceSize = 1024 * 1024;
+  constexpr size_t parallelSize = 8 * pieceSize;
+  struct Piece {
+    size_t chunk_;
+    size_t offset_;
+    size_t size_;
+    uLong crc_;
+  };
+  std::vector<Piece> pieces;
+  size_t total = 0;
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    const size_t end = chunks[i].offset_ + 8 + chunks[i].length_;
+    for (size_t pos = chunks[i].offset_ + 4; pos < end; pos += pieceSize)
+      pieces.push_back({i, pos, std::min(pieceSize, end - pos), 0});
+    total += 4 + chunks[i].length_;
+  }
+
+  std::atomic<size_t> next{0};
+  const auto check = [&] {
+    for (size_t i = next++; i < pieces.size(); i = next++)
+      pieces[i].crc_ = crc32(crc32(0L, Z_NULL, 0), data + pieces[i].offset_, static_cast<uInt>(pieces[i].size_));
+  };
+  std::vector<std::thread> workers;
+  const size_t threads =
+      total < parallelSize ? 1 : std::min<size_t>(std::thread::hardware_concurrency(), pieces.size());
+  try {
+    while (workers.size() + 1 < threads)
+      workers.emplace_back(check);
+  } catch (const std::system_error&) {
+    // The pieces left are checked on this thread
+  }
+  check();
+  for (auto& worker : workers)
+    worker.join();
+
+  std::vector<uint32_t> crcs(chunks.size());
+  for (const auto& piece : pieces) {
+    auto& crc = crcs[piece.chunk_];
+    if (piece.offset_ == chunks[piece.chunk_].offset_ + 4)
+      crc = static_cast<uint32_t>(piece.crc_);
+    else
+      crc = static_cast<uint32_t>(crc32_combine(crc, piece.crc_, static_cast<z_off_t>(piece.size_)));
+  }
+  return crcs;
+}
+}  // namespace
+
 static void readChunk(DataBuf& buffer, BasicIo& io) {
 #ifdef EXIV2_DEBUG_MESSAGES
   std::cout << "Exiv2::PngImage::readMetadata: Position: " << io.tell() << '\n';
@@ -401,78 +520,68 @@ void PngImage::readMetadata() {
     throw Error(ErrorCode::kerNotAnImage, "PNG");
   }
   clearMetadata();
+  chunkChecks_.clear();
 
-  const size_t imgSize = io_->size();
-  DataBuf cheaderBuf(8);  // Chunk header: 4 bytes (data size) + 4 bytes (chunk type).
-  const DecodeParams dp(max_recursion_depth_);
-
-  while (!io_->eof()) {
-    readChunk(cheaderBuf, *io_);  // Read chunk header.
-
-    // Decode chunk data length.
-    uint32_t chunkLength = cheaderBuf.read_uint32(0, Exiv2::bigEndian);
-    if (chunkLength > imgSize - io_->tell()) {
-      throw Exiv2::Error(ErrorCode::kerFailedToReadImageData);
-    }
+  const DecodeParams dp(max_recursion_depth_, lazyMakernotes());
 
-    std::string chunkType(cheaderBuf.c_str(4), 4);
+  const auto chunks = indexChunks(*io_, [&](const PngChunkEntry& chunk) {
+    const auto chunkType = chunk.type();
 #ifdef EXIV2_DEBUG_MESSAGES
-    std::cout << "Exiv2::PngImage::readMetadata: chunk type: " << chunkType << " length: " << chunkLength << '\n';
+    std::cout << "Exiv2::PngImage::readMetadata: chunk type: " << chunkType << " length: " << chunk.length_ << '\n';
 #endif
 
     /// \todo analyse remaining chunks of the standard
     // Perform a chunk triage for item that we need.
-    if (chunkType == "IEND" || chunkType == "IHDR" || chunkType == "tEXt" || chunkType == "zTXt" ||
-        chunkType == "eXIf" || chunkType == "iTXt" || chunkType == "iCCP") {
-      DataBuf chunkData(chunkLength);
-      if (chunkLength > 0) {
-        readChunk(chunkData, *io_);  // Extract chunk data.
-      }
+    if (chunkType != "IHDR" && chunkType != "tEXt" && chunkType != "zTXt" && chunkType != "eXIf" &&
+        chunkType != "iTXt" && chunkType != "iCCP") {
+      return;
+    }
+    const uint32_t chunkLength = chunk.length_;
+    DataBuf chunkData(chunkLength);
+    if (chunkLength > 0) {
+      io_->seek(chunk.offset_ + 8, BasicIo::beg);
+      readChunk(chunkData, *io_);  // Extract chunk data.
+    }
 
-      if (chunkType == "IEND") {
-        return;  // Last chunk found: we stop parsing.
-      }
-      if (chunkType == "IHDR" && chunkData.size() >= 8) {
-        PngChunk::decodeIHDRChunk(chunkData, &pixelWidth_, &pixelHeight_);
-      } else if (chunkType == "tEXt") {
-        PngChunk::decodeTXTChunk(this, chunkData, PngChunk::tEXt_Chunk, dp);
-      } else if (chunkType == "zTXt") {
-        PngChunk::decodeTXTChunk(this, chunkData, PngChunk::zTXt_Chunk, dp);
-      } else if (chunkType == "iTXt") {
-        PngChunk::decodeTXTChunk(this, chunkData, PngChunk::iTXt_Chunk, dp);
-      } else if (chunkType == "eXIf") {
-        ByteOrder bo = TiffParser::decode(exifData(), iptcData(), xmpData(), chunkData.c_data(), chunkData.size(), dp);
-        setByteOrder(bo);
-      } else if (chunkType == "iCCP") {
-        // The ICC profile name can vary from 1-79 characters.
-        uint32_t iccOffset = 0;
-        do {
-          enforce(iccOffset < 80 && iccOffset < chunkLength, Exiv2::ErrorCode::kerCorruptedMetadata);
-        } while (chunkData.read_uint8(iccOffset++) != 0x00);
-
-        profileName_ = std::string(chunkData.c_str(), iccOffset - 1);
-        ++iccOffset;  // +1 = 'compressed' flag
-        enforce(iccOffset <= chunkLength, Exiv2::ErrorCode::kerCorruptedMetadata);
-
-        zlibToDataBuf(chunkData.c_data(iccOffset), static_cast<uLongf>(chunkLength - iccOffset), iccProfile_);
+    if (chunkType == "IHDR" && chunkData.size() >= 8) {
+      PngChunk::decodeIHDRChunk(chunkData, &pixelWidth_, &pixelHeight_);
+    } else if (chunkType == "tEXt") {
+      PngChunk::decodeTXTChunk(this, chunkData, PngChunk::tEXt_Chunk, dp, maxInflatedSize_);
+    } else if (chunkType == "zTXt") {
+      PngChunk::decodeTXTChunk(this, chunkData, PngChunk::zTXt_Chunk, dp, maxInflatedSize_);
+    } else if (chunkType == "iTXt") {
+      PngChunk::decodeTXTChunk(this, chunkData, PngChunk::iTXt_Chunk, dp, maxInflatedSize_);
+    } else if (chunkType == "eXIf") {
+      ByteOrder bo = TiffParser::decode(exifData(), iptcData(), xmpData(), chunkData.c_data(), chunkData.size(), dp);
+      setByteOrder(bo);
+    } else if (chunkType == "iCCP") {
+      // The ICC profile name can vary from 1-79 characters.
+      uint32_t iccOffset = 0;
+      do {
+        enforce(iccOffset < 80 && iccOffset < chunkLength, Exiv2::ErrorCode::kerCorruptedMetadata);
+      } while (chunkData.read_uint8(iccOffset++) != 0x00);
+
+      profileName_ = std::string(chunkData.c_str(), iccOffset - 1);
+      ++iccOffset;  // +1 = 'compressed' flag
+      enforce(iccOffset <= chunkLength, Exiv2::ErrorCode::kerCorruptedMetadata);
+
+      PngChunk::zlibInflate(chunkData.c_data(iccOffset), chunkLength - iccOffset, iccProfile_, maxInflatedSize_);
 #ifdef EXIV2_DEBUG_MESSAGES
-        std::cout << "Exiv2::PngImage::readMetadata: profile name: " << profileName_ << '\n';
-        std::cout << "Exiv2::PngImage::readMetadata: iccProfile.size_ (uncompressed) : " << iccProfile_.size() << '\n';
+      std::cout << "Exiv2::PngImage::readMetadata: profile name: " << profileName_ << '\n';
+      std::cout << "Exiv2::PngImage::readMetadata: iccProfile.size_ (uncompressed) : " << iccProfile_.size() << '\n';
 #endif
-      }
-
-      // Set chunkLength to 0 in case we have read a supported chunk type. Otherwise, we need to seek the
-      // file to the next chunk position.
-      chunkLength = 0;
     }
+  });
 
-    // Move to the next chunk: chunk data size + 4 CRC bytes.
-#ifdef EXIV2_DEBUG_MESSAGES
-    std::cout << "Exiv2::PngImage::readMetadata: Seek to offset: " << chunkLength + 4 << '\n';
-#endif
-    io_->seek(chunkLength + 4, BasicIo::cur);
-    if (io_->error() || io_->eof()) {
+  if (verifyChunks_) {
+    const byte* data = io_->mmap();
+    if (io_->error())
       throw Error(ErrorCode::kerFailedToReadImageData);
+    const auto crcs = chunkCrcs(data, chunks);
+    chunkChecks_.reserve(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+      const auto& chunk = chunks[i];
+      chunkChecks_.push_back({std::string(chunk.type()), chunk.offset_, chunk.length_, chunk.crc_, crcs[i]});
     }
   }
 }  // PngImage::readMetadata
@@ -482,11 +591,11 @@ void PngImage::writeMetadata() {
     throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
   }
   IoCloser closer(*io_);
-  MemIo tempIo;
+  auto tempIo = createTemporary(*io_);
 
-  doWriteMetadata(tempIo);  // may throw
+  doWriteMetadata(*tempIo);  // may throw
   io_->close();
-  io_->transfer(tempIo);  // may throw
+  io_->transfer(*tempIo);  // may throw
 
 }  // PngImage::writeMetadata
 
@@ -504,67 +613,77 @@ void PngImage::doWriteMetadata(BasicIo& outIo) {
   if (!isPngType(*io_, true)) {
     throw Error(ErrorCode::kerNoImageInInputData);
   }
+  const auto chunks = indexChunks(*io_);
+  const byte* data = io_->mmap();
+  if (io_->error())
+    throw Error(ErrorCode::kerFailedToReadImageData);
+  // The file may end within the CRC of IEND
+  if (chunks.back().end() > io_->size())
+    throw Error(ErrorCode::kerInputDataReadFailed);
 
   // Write PNG Signature.
   if (outIo.write(pngSignature.data(), 8) != 8)
     throw Error(ErrorCode::kerImageWriteFailed);
 
-  DataBuf cheaderBuf(8);  // Chunk header : 4 bytes (data size) + 4 bytes (chunk type).
-
-  while (!io_->eof()) {
-    // Read chunk header.
-    size_t bufRead = io_->read(cheaderBuf.data(), 8);
-    if (io_->error())
-      throw Error(ErrorCode::kerFailedToReadImageData);
-    if (bufRead != 8)
-      throw Error(ErrorCode::kerInputDataReadFailed);
-
-    // Decode chunk data length.
-
-    uint32_t dataOffset = cheaderBuf.read_uint32(0, Exiv2::bigEndian);
-    if (dataOffset > 0x7FFFFFFF)
-      throw Exiv2::Error(ErrorCode::kerFailedToReadImageData);
-
-    // Read whole chunk : Chunk header + Chunk data (not fixed size - can be null) + CRC (4 bytes).
-
-    DataBuf chunkBuf(8 + dataOffset + 4);  // Chunk header (8 bytes) + Chunk data + CRC (4 bytes).
-    std::copy(cheaderBuf.begin(), cheaderBuf.end(), chunkBuf.begin());  // Copy header.
-    bufRead = io_->read(chunkBuf.data(8), dataOffset + 4);              // Extract chunk data + CRC
-    if (io_->error())
-      throw Error(ErrorCode::kerFailedToReadImageData);
-    if (bufRead != dataOffset + 4)
-      throw Error(ErrorCode::kerInputDataReadFailed);
+  // Chunks which are kept are copied as they are, CRCs included, a run of them at a time
+  size_t runStart = 0;
+  size_t runEnd = 0;
+  const auto copyRun = [&] {
+    const size_t size = runEnd - runStart;
+    if (size == 0)
+      return;
+    size_t written = 0;
+#ifdef EXV_ENABLE_FILESYSTEM
+    auto file = dynamic_cast<FileIo*>(&outIo);
+    auto source = dynamic_cast<const FileIo*>(io_.get());
+    if (file && source)
+      written = file->write(*source, data + runStart, size);
+    else
+#endif
+      written = outIo.write(data + runStart, size);
+    if (written != size)
+      throw Error(ErrorCode::kerImageWriteFailed);
+    runStart = runEnd;
+  };
+  const auto keep = [&](const PngChunkEntry& chunk) {
+    if (chunk.offset_ != runEnd) {
+      copyRun();
+      runStart = chunk.offset_;
+    }
+    runEnd = chunk.end();
+  };
 
-    const std::string szChunk(cheaderBuf.begin() + 4, cheaderBuf.end());
+  for (const auto& chunk : chunks) {
+    const auto szChunk = chunk.type();
 
     if (szChunk == "IEND") {
       // Last chunk found: we write it and done.
 #ifdef EXIV2_DEBUG_MESSAGES
-      std::cout << "Exiv2::PngImage::doWriteMetadata: Write IEND chunk (length: " << dataOffset << ")\n";
+      std::cout << "Exiv2::PngImage::doWriteMetadata: Write IEND chunk (length: " << chunk.length_ << ")\n";
 #endif
-      if (outIo.write(chunkBuf.data(), chunkBuf.size()) != chunkBuf.size())
-        throw Error(ErrorCode::kerImageWriteFailed);
+      keep(chunk);
+      copyRun();
       return;
     }
     if (szChunk == "eXIf" || szChunk == "iCCP") {
       // do nothing (strip): Exif metadata is written following IHDR
       // together with the ICC profile as fresh eXIf and iCCP chunks
 #ifdef EXIV2_DEBUG_MESSAGES
-      std::cout << "Exiv2::PngImage::doWriteMetadata: strip " << szChunk << " chunk (length: " << dataOffset << ")"
+      std::cout << "Exiv2::PngImage::doWriteMetadata: strip " << szChunk << " chunk (length: " << chunk.length_ << ")"
                 << '\n';
 #endif
     } else if (szChunk == "IHDR") {
 #ifdef EXIV2_DEBUG_MESSAGES
-      std::cout << "Exiv2::PngImage::doWriteMetadata: Write IHDR chunk (length: " << dataOffset << ")\n";
+      std::cout << "Exiv2::PngImage::doWriteMetadata: Write IHDR chunk (length: " << chunk.length_ << ")\n";
 #endif
-      if (outIo.write(chunkBuf.data(), chunkBuf.size()) != chunkBuf.size())
-        throw Error(ErrorCode::kerImageWriteFailed);
+      keep(chunk);
+      copyRun();
 
       // Write all updated metadata here, just after IHDR.
       if (!comment_.empty()) {
         // Update Comment data to a new PNG chunk
-        std::string chunk = PngChunk::makeMetadataChunk(comment_, mdComment);
-        if (outIo.write(reinterpret_cast<const byte*>(chunk.data()), chunk.size()) != chunk.size()) {
+        std::string newChunk = PngChunk::makeMetadataChunk(comment_, mdComment);
+        if (outIo.write(reinterpret_cast<const byte*>(newChunk.data()), newChunk.size()) != newChunk.size()) {
           throw Error(ErrorCode::kerImageWriteFailed);
         }
       }
@@ -600,8 +719,8 @@ void PngImage::doWriteMetadata(BasicIo& outIo) {
         DataBuf newPsData = Photoshop::setIptcIrb(nullptr, 0, iptcData_);
         if (!newPsData.empty()) {
           std::string rawIptc(newPsData.c_str(), newPsData.size());
-          std::string chunk = PngChunk::makeMetadataChunk(rawIptc, mdIptc);
-          if (outIo.write(reinterpret_cast<const byte*>(chunk.data()), chunk.size()) != chunk.size()) {
+          std::string newChunk = PngChunk::makeMetadataChunk(rawIptc, mdIptc);
+          if (outIo.write(reinterpret_cast<const byte*>(newChunk.data()), newChunk.size()) != newChunk.size()) {
             throw Error(ErrorCode::kerImageWriteFailed);
           }
         }
@@ -645,36 +764,35 @@ void PngImage::doWriteMetadata(BasicIo& outIo) {
       }
       if (!xmpPacket_.empty()) {
         // Update XMP data to a new PNG chunk
-        std::string chunk = PngChunk::makeMetadataChunk(xmpPacket_, mdXmp);
-        if (outIo.write(reinterpret_cast<const byte*>(chunk.data()), chunk.size()) != chunk.size()) {
+        std::string newChunk = PngChunk::makeMetadataChunk(xmpPacket_, mdXmp);
+        if (outIo.write(reinterpret_cast<const byte*>(newChunk.data()), newChunk.size()) != newChunk.size()) {
           throw Error(ErrorCode::kerImageWriteFailed);
         }
       }
     } else if (szChunk == "tEXt" || szChunk == "zTXt" || szChunk == "iTXt") {
+      const DataBuf chunkBuf(data + chunk.offset_, chunk.end() - chunk.offset_);
       DataBuf key = PngChunk::keyTXTChunk(chunkBuf, true);
       if (!key.empty() && (compare("Raw profile type exif", key) || compare("Raw profile type APP1", key) ||
                            compare("Raw profile type iptc", key) || compare("Raw profile type xmp", key) ||
                            compare("XML:com.adobe.xmp", key) || compare("Description", key))) {
 #ifdef EXIV2_DEBUG_MESSAGES
-        std::cout << "Exiv2::PngImage::doWriteMetadata: strip " << szChunk << " chunk (length: " << dataOffset << ")"
-                  << '\n';
+        std::cout << "Exiv2::PngImage::doWriteMetadata: strip " << szChunk << " chunk (length: " << chunk.length_
+                  << ")" << '\n';
 #endif
       } else {
 #ifdef EXIV2_DEBUG_MESSAGES
-        std::cout << "Exiv2::PngImage::doWriteMetadata: write " << szChunk << " chunk (length: " << dataOffset << ")"
-                  << '\n';
+        std::cout << "Exiv2::PngImage::doWriteMetadata: write " << szChunk << " chunk (length: " << chunk.length_
+                  << ")" << '\n';
 #endif
-        if (outIo.write(chunkBuf.c_data(), chunkBuf.size()) != chunkBuf.size())
-          throw Error(ErrorCode::kerImageWriteFailed);
+        keep(chunk);
       }
     } else {
       // Write all others chunk as well.
 #ifdef EXIV2_DEBUG_MESSAGES
-      std::cout << "Exiv2::PngImage::doWriteMetadata:  copy " << szChunk << " chunk (length: " << dataOffset << ")"
+      std::cout << "Exiv2::PngImage::doWriteMetadata:  copy " << szChunk << " chunk (length: " << chunk.length_ << ")"
                 << '\n';
 #endif
-      if (outIo.write(chunkBuf.c_data(), chunkBuf.size()) != chunkBuf.size())
-        throw Error(ErrorCode::kerImageWriteFailed);
+      keep(chunk);
     }
   }
 
@@ -21,6 +21,11 @@
 #include <cstring>
 #include <limits>
 
+#ifdef EXV_ENABLE_FILESYSTEM
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+
 namespace {
 using namespace Exiv2;
 using Exiv2::byte;
@@ -31,6 +36,9 @@ DataBuf decodeHex(const byte* src, size_t srcSize);
 /// @brief Decode a Base64 string.
 DataBuf decodeBase64(const std::string& src);
 
+/// @brief Size of the data that decodeBase64() returns for a Base64 string, without decoding it.
+size_t decodeBase64Size(const std::string& src);
+
 /// AI7 thumbnails are decoded into a contiguous RGB buffer before being
 /// wrapped as PNM. Keep that temporary allocation bounded.
 constexpr size_t maxAi7ThumbnailSize = 256UL * 1024UL * 1024UL;
@@ -44,6 +52,56 @@ DataBuf decodeAi7Thumbnail(const DataBuf& src, size_t expectedSize);
 /// @brief Create a PNM image from raw RGB data.
 DataBuf makePnm(size_t width, size_t height, const DataBuf& rgb);
 
+#ifdef EXV_ENABLE_FILESYSTEM
+/// Identifies a preview index
+constexpr std::array<byte, 8> previewIndexMagic{'E', 'X', 'V', '2', 'P', 'I', 'D', 'X'};
+
+/// Version of the preview index format
+constexpr uint32_t previewIndexVersion = 1;
+
+/// Number of bytes at the beginning of a file that a preview index hashes
+constexpr size_t previewIndexHashSize = 64 * 1024;
+
+/// @brief Size, modification time and a hash of the beginning of a file.
+struct FileStamp {
+  uint64_t size_{};
+  uint64_t modified_{};
+  uint64_t hash_{};
+};
+
+/// @brief Get the stamp of the file at \em path, return false if the file can't be read.
+bool fileStamp(const std::string& path, FileStamp& stamp);
+
+/// @brief Reads the fields of a preview index, throws if it is too short.
+class IndexReader {
+ public:
+  IndexReader(const byte* data, size_t size) : data_(data), size_(size) {
+  }
+
+  /// @brief Read a little endian unsigned integer of \em n bytes.
+  uint64_t uint(size_t n);
+
+  /// @brief Read a string with a 16 bit size.
+  std::string string();
+
+  /// @brief Return true if all data has been read.
+  [[nodiscard]] bool done() const {
+    return pos_ == size_;
+  }
+
+ private:
+  const byte* data_;
+  size_t size_;
+  size_t pos_{0};
+};
+
+/// @brief Append a little endian unsigned integer of \em n bytes to \em blob.
+void appendUint(Blob& blob, uint64_t x, size_t n);
+
+/// @brief Append a string with a 16 bit size to \em blob.
+void appendString(Blob& blob, const std::string& s);
+#endif
+
 /*!
   Base class for image loaders. Provides virtual methods for reading properties
   and DataBuf.
@@ -73,6 +131,16 @@ class Loader {
   //! Get a buffer that contains the preview image
   [[nodiscard]] virtual DataBuf getData() const = 0;
 
+  //! Size of the buffer that getData() returns, determined without creating the buffer where possible
+  [[nodiscard]] virtual size_t dataSize() const {
+    return size_;
+  }
+
+  //! Get the location of a preview image that getData() copies from image_.io() in one piece
+  [[nodiscard]] virtual bool getLocation(size_t& /*offset*/, size_t& /*size*/) const {
+    return false;
+  }
+
   //! Read preview image dimensions when they are not available directly
   virtual bool readDimensions() {
     return true;
@@ -129,10 +197,19 @@ class LoaderNative : public Loader {
   //! Get a buffer that contains the preview image
   [[nodiscard]] DataBuf getData() const override;
 
+  //! Size of the preview image, only filtered previews are decoded to determine it
+  [[nodiscard]] size_t dataSize() const override;
+
+  //! Get the location of an unfiltered preview image
+  [[nodiscard]] bool getLocation(size_t& offset, size_t& size) const override;
+
   //! Read preview image dimensions
   bool readDimensions() override;
 
  protected:
+  //! Read the dimensions of the preview image in a buffer
+  bool readDimensions(const byte* pData, size_t size);
+
   //! Native preview information
   NativePreview nativePreview_;
 };
@@ -152,6 +229,9 @@ class LoaderExifJpeg : public Loader {
   //! Get a buffer that contains the preview image
   [[nodiscard]] DataBuf getData() const override;
 
+  //! Get the location of the preview image
+  [[nodiscard]] bool getLocation(size_t& offset, size_t& size) const override;
+
   //! Read preview image dimensions
   bool readDimensions() override;
 
@@ -217,7 +297,13 @@ class LoaderTiff : public Loader {
   //! Get a buffer that contains the preview image
   [[nodiscard]] DataBuf getData() const override;
 
+  //! Size of the TIFF image that getData() creates, without copying the image data
+  [[nodiscard]] size_t dataSize() const override;
+
  protected:
+  //! Copy the TIFF image tags of the preview image to a new IFD0
+  [[nodiscard]] ExifData previewTags() const;
+
   //! Name of the group that contains the preview image
   const char* group_;
 
@@ -257,8 +343,8 @@ class LoaderXmpJpeg : public Loader {
   bool readDimensions() override;
 
  protected:
-  //! Preview image data
-  DataBuf preview_;
+  //! Base64 encoded preview image, decoded by getData()
+  std::string base64_;
 };
 
 //! Function to create new LoaderXmpJpeg
@@ -358,11 +444,8 @@ LoaderNative::LoaderNative(PreviewId id, const Image& image, int parIdx) : Loade
   width_ = nativePreview_.width_;
   height_ = nativePreview_.height_;
   valid_ = true;
-  if (nativePreview_.filter_.empty()) {
+  if (nativePreview_.filter_.empty())
     size_ = nativePreview_.size_;
-  } else {
-    size_ = getData().size();
-  }
 }
 
 Loader::UniquePtr createLoaderNative(PreviewId id, const Image& image, int parIdx) {
@@ -437,18 +520,53 @@ DataBuf LoaderNative::getData() const {
   throw Error(ErrorCode::kerErrorMessage, "Invalid native preview filter: ", nativePreview_.filter_);
 }
 
+size_t LoaderNative::dataSize() const {
+  if (!valid())
+    return 0;
+  if (!nativePreview_.filter_.empty())
+    return getData().size();
+  if (image_.io().size() < nativePreview_.position_ + nativePreview_.size_)
+    return 0;
+  return size_;
+}
+
+bool LoaderNative::getLocation(size_t& offset, size_t& size) const {
+  if (!valid() || !nativePreview_.filter_.empty())
+    return false;
+  offset = nativePreview_.position_;
+  size = nativePreview_.size_;
+  return true;
+}
+
 bool LoaderNative::readDimensions() {
   if (!valid())
     return false;
   if (width_ != 0 || height_ != 0)
     return true;
 
-  const DataBuf data = getData();
-  if (data.empty())
+  if (!nativePreview_.filter_.empty()) {
+    const DataBuf data = getData();
+    return !data.empty() && readDimensions(data.c_data(), data.size());
+  }
+
+  // read an unfiltered preview in place
+  BasicIo& io = image_.io();
+  if (io.open() != 0) {
+    throw Error(ErrorCode::kerDataSourceOpenFailed, io.path(), strError());
+  }
+  IoCloser closer(io);
+  if (io.size() < nativePreview_.position_ + nativePreview_.size_) {
+#ifndef SUPPRESS_WARNINGS
+    EXV_WARNING << "Invalid native preview position or size.\n";
+#endif
     return false;
+  }
+  return nativePreview_.size_ != 0 && readDimensions(io.mmap() + nativePreview_.position_, nativePreview_.size_);
+}
 
+bool LoaderNative::readDimensions(const byte* pData, size_t size) {
   try {
-    auto image = ImageFactory::open(data.c_data(), data.size());
+    auto image = ImageFactory::open(pData, size);
     if (!image)
       return false;
     image->readMetadata();
@@ -519,6 +637,14 @@ DataBuf LoaderExifJpeg::getData() const {
   return {base + offset_, size_};
 }
 
+bool LoaderExifJpeg::getLocation(size_t& offset, size_t& size) const {
+  if (!valid())
+    return false;
+  offset = offset_;
+  size = size_;
+  return true;
+}
+
 bool LoaderExifJpeg::readDimensions() {
   if (!valid())
     return false;
@@ -689,13 +815,11 @@ PreviewProperties LoaderTiff::getProperties() const {
   return prop;
 }
 
-DataBuf LoaderTiff::getData() const {
-  const ExifData& exifData = image_.exifData();
-
+ExifData LoaderTiff::previewTags() const {
   ExifData preview;
 
   // copy tags
-  for (auto&& pos : exifData) {
+  for (auto&& pos : image_.exifData()) {
     if (pos.groupName() == group_) {
       /*
          Write only the necessary TIFF image tags
@@ -711,6 +835,17 @@ DataBuf LoaderTiff::getData() const {
     }
   }
 
+  // Fix compression value in the CR2 IFD2 image
+  if (0 == strcmp(group_, "Image2") && image_.mimeType() == "image/x-canon-cr2") {
+    preview["Exif.Image.Compression"] = std::uint16_t{1};
+  }
+
+  return preview;
+}
+
+DataBuf LoaderTiff::getData() const {
+  ExifData preview = previewTags();
+
   auto& dataValue = const_cast<Value&>(preview["Exif.Image." + offsetTag_].value());
 
   if (dataValue.sizeDataArea() == 0) {
@@ -758,11 +893,6 @@ DataBuf LoaderTiff::getData() const {
     }
   }
 
-  // Fix compression value in the CR2 IFD2 image
-  if (0 == strcmp(group_, "Image2") && image_.mimeType() == "image/x-canon-cr2") {
-    preview["Exif.Image.Compression"] = std::uint16_t{1};
-  }
-
   // write new image
   MemIo mio;
   IptcData emptyIptc;
@@ -771,6 +901,47 @@ DataBuf LoaderTiff::getData() const {
   return {mio.mmap(), mio.size()};
 }
 
+size_t LoaderTiff::dataSize() const {
+  ExifData preview = previewTags();
+
+  auto& dataValue = const_cast<Value&>(preview["Exif.Image." + offsetTag_].value());
+  auto& sizes = preview["Exif.Image." + sizeTag_];
+
+  // size of the image data that getData() puts into the data area
+  size_t imageSize = dataValue.sizeDataArea();
+  if (imageSize == 0) {
+    if (sizes.count() != dataValue.count())
+      return getData().size();  // without image data
+    if (sizes.count() == 1) {
+      uint32_t offset = dataValue.toUint32(0);
+      uint32_t size = sizes.toUint32(0);
+      if (Safe::add(offset, size) > static_cast<uint32_t>(image_.io().size()))
+        return getData().size();  // without image data
+      imageSize = size;
+    } else {
+      Internal::enforce(size_ <= image_.io().size(), ErrorCode::kerCorruptedMetadata);
+      imageSize = size_;
+    }
+  }
+
+  // The layout of the TIFF structure doesn't depend on the image data. Encode it with a
+  // one byte placeholder and sizes that match it, then swap in the size of the image data.
+  const byte placeholder = 0;
+  dataValue.setDataArea(&placeholder, 1);
+  auto counts = Value::create(sizes.typeId());
+  std::string placeholderSizes = "1";
+  for (size_t i = 1; i < sizes.count(); ++i)
+    placeholderSizes += " 0";
+  counts->read(placeholderSizes);
+  sizes.setValue(counts.get());
+
+  MemIo mio;
+  IptcData emptyIptc;
+  XmpData emptyXmp;
+  TiffParser::encode(mio, nullptr, 0, Exiv2::littleEndian, preview, emptyIptc, emptyXmp);
+  return mio.size() - 2 + imageSize + (imageSize & 1);
+}
+
 LoaderXmpJpeg::LoaderXmpJpeg(PreviewId id, const Image& image, int parIdx) : Loader(id, image) {
   (void)parIdx;
 
@@ -799,8 +970,8 @@ LoaderXmpJpeg::LoaderXmpJpeg(PreviewId id, const Image& image, int parIdx) : Loa
 
   width_ = widthDatum->toUint32();
   height_ = heightDatum->toUint32();
-  preview_ = decodeBase64(imageDatum->toString());
-  size_ = preview_.size();
+  base64_ = imageDatum->toString();
+  size_ = decodeBase64Size(base64_);
   valid_ = true;
 }
 
@@ -818,7 +989,7 @@ PreviewProperties LoaderXmpJpeg::getProperties() const {
 DataBuf LoaderXmpJpeg::getData() const {
   if (!valid())
     return {};
-  return {preview_.c_data(), preview_.size()};
+  return decodeBase64(base64_);
 }
 
 bool LoaderXmpJpeg::readDimensions() {
@@ -883,23 +1054,31 @@ DataBuf decodeHex(const byte* src, size_t srcSize) {
 
 const char encodeBase64Table[64 + 1] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-DataBuf decodeBase64(const std::string& src) {
-  DataBuf dest;
-  // create decoding table
-  unsigned long invalid = 64;
-  auto decodeBase64Table = std::vector<unsigned long>(256, invalid);
+constexpr unsigned long invalidBase64 = 64;
+
+std::vector<unsigned long> makeDecodeBase64Table() {
+  auto decodeBase64Table = std::vector<unsigned long>(256, invalidBase64);
   for (unsigned long i = 0; i < 64; i++)
     decodeBase64Table[static_cast<unsigned char>(encodeBase64Table[i])] = i;
+  return decodeBase64Table;
+}
 
-  // calculate dest size
-  auto validSrcSize = static_cast<unsigned long>(
-      std::count_if(src.begin(), src.end(), [&](unsigned char c) { return decodeBase64Table.at(c) != invalid; }));
+size_t decodeBase64Size(const std::string& src) {
+  static const auto decodeBase64Table = makeDecodeBase64Table();
+  auto validSrcSize = static_cast<unsigned long>(std::count_if(
+      src.begin(), src.end(), [&](unsigned char c) { return decodeBase64Table.at(c) != invalidBase64; }));
   if (validSrcSize > ULONG_MAX / 3)
-    return dest;  // avoid integer overflow
-  const unsigned long destSize = (validSrcSize * 3) / 4;
+    return 0;  // avoid integer overflow
+  return (validSrcSize * 3) / 4;
+}
+
+DataBuf decodeBase64(const std::string& src) {
+  static const auto decodeBase64Table = makeDecodeBase64Table();
+  const unsigned long invalid = invalidBase64;
 
   // allocate dest buffer
-  dest = DataBuf(destSize);
+  const unsigned long destSize = decodeBase64Size(src);
+  DataBuf dest(destSize);
 
   // decode
   for (unsigned long srcPos = 0, destPos = 0; destPos < destSize;) {
@@ -981,6 +1160,58 @@ DataBuf makePnm(size_t width, size_t height, const DataBuf& rgb) {
   return dest;
 }
 
+#ifdef EXV_ENABLE_FILESYSTEM
+bool fileStamp(const std::string& path, FileStamp& stamp) {
+  std::error_code ec;
+  const auto modified = fs::last_write_time(path, ec);
+  if (ec)
+    return false;
+  FileIo file(path);
+  if (file.open() != 0)
+    return false;
+  stamp.size_ = file.size();
+  stamp.modified_ = static_cast<uint64_t>(modified.time_since_epoch().count());
+
+  // FNV-1a
+  DataBuf buf(std::min<size_t>(stamp.size_, previewIndexHashSize));
+  const size_t n = file.read(buf.data(), buf.size());
+  stamp.hash_ = 14695981039346656037ULL;
+  for (size_t i = 0; i < n; i++) {
+    stamp.hash_ ^= buf.read_uint8(i);
+    stamp.hash_ *= 1099511628211ULL;
+  }
+  return n == buf.size();
+}
+
+uint64_t IndexReader::uint(size_t n) {
+  Internal::enforce(n <= size_ - pos_, ErrorCode::kerCorruptedMetadata);
+  uint64_t x = 0;
+  for (size_t i = 0; i < n; i++)
+    x |= static_cast<uint64_t>(data_[pos_ + i]) << (8 * i);
+  pos_ += n;
+  return x;
+}
+
+std::string IndexReader::string() {
+  const auto n = static_cast<size_t>(uint(2));
+  Internal::enforce(n <= size_ - pos_, ErrorCode::kerCorruptedMetadata);
+  std::string s(reinterpret_cast<const char*>(data_ + pos_), n);
+  pos_ += n;
+  return s;
+}
+
+void appendUint(Blob& blob, uint64_t x, size_t n) {
+  for (size_t i = 0; i < n; i++)
+    blob.push_back(static_cast<byte>(x >> (8 * i)));
+}
+
+void appendString(Blob& blob, const std::string& s) {
+  Internal::enforce(s.size() <= std::numeric_limits<uint16_t>::max(), ErrorCode::kerCorruptedMetadata);
+  appendUint(blob, s.size(), 2);
+  blob.insert(blob.end(), s.begin(), s.end());
+}
+#endif
+
 }  // namespace
 
 // *****************************************************************************
@@ -990,36 +1221,79 @@ PreviewImage::PreviewImage(PreviewProperties properties, DataBuf&& data) :
     properties_(std::move(properties)), preview_(std::move(data)) {
 }
 
-PreviewImage::PreviewImage(const PreviewImage& rhs) : properties_(rhs.properties_), preview_(rhs.pData(), rhs.size()) {
+#ifdef EXV_ENABLE_FILESYSTEM
+PreviewImage::PreviewImage(PreviewProperties properties, std::shared_ptr<FileIo> source, const byte* mapped,
+                           size_t offset, size_t size) :
+    properties_(std::move(properties)),
+    source_(std::move(source)),
+    pView_(mapped + offset),
+    offset_(offset),
+    viewSize_(size) {
+}
+#endif
+
+PreviewImage::PreviewImage(const PreviewImage& rhs) :
+    properties_(rhs.properties_),
+    preview_(rhs.preview_.c_data(), rhs.preview_.size()),
+#ifdef EXV_ENABLE_FILESYSTEM
+    source_(rhs.source_),
+#endif
+    pView_(rhs.pView_),
+    offset_(rhs.offset_),
+    viewSize_(rhs.viewSize_) {
 }
 
 PreviewImage& PreviewImage::operator=(const PreviewImage& rhs) {
   if (this == &rhs)
     return *this;
   properties_ = rhs.properties_;
-  preview_ = DataBuf(rhs.pData(), rhs.size());
+  preview_ = DataBuf(rhs.preview_.c_data(), rhs.preview_.size());
+#ifdef EXV_ENABLE_FILESYSTEM
+  source_ = rhs.source_;
+#endif
+  pView_ = rhs.pView_;
+  offset_ = rhs.offset_;
+  viewSize_ = rhs.viewSize_;
   return *this;
 }
 
 #ifdef EXV_ENABLE_FILESYSTEM
 size_t PreviewImage::writeFile(const std::string& path) const {
   std::string name = path + extension();
-  // Todo: Creating a DataBuf here unnecessarily copies the memory
-  DataBuf buf(pData(), size());
-  return Exiv2::writeFile(buf, name);
+  FileIo file(name);
+  if (file.open("wb") != 0) {
+    throw Error(ErrorCode::kerFileOpenFailed, name, "wb", strError());
+  }
+  return writeTo(file);
 }
 #endif
 
+size_t PreviewImage::writeTo(BasicIo& io) const {
+#ifdef EXV_ENABLE_FILESYSTEM
+  if (auto file = dynamic_cast<FileIo*>(&io); file && source_)
+    return file->write(*source_, pView_, viewSize_);
+#endif
+  return io.write(pData(), size());
+}
+
 DataBuf PreviewImage::copy() const {
   return {pData(), size()};
 }
 
 const byte* PreviewImage::pData() const {
-  return preview_.c_data();
+  return pView_ ? pView_ : preview_.c_data();
 }
 
 uint32_t PreviewImage::size() const {
-  return static_cast<uint32_t>(preview_.size());
+  return static_cast<uint32_t>(pView_ ? viewSize_ : preview_.size());
+}
+
+bool PreviewImage::isView() const {
+  return pView_ != nullptr;
+}
+
+size_t PreviewImage::offset() const {
+  return offset_;
 }
 
 const std::string& PreviewImage::mimeType() const {
@@ -1052,8 +1326,7 @@ PreviewPropertiesList PreviewManager::getPreviewProperties() const {
     auto loader = Loader::create(id, image_);
     if (loader && loader->readDimensions()) {
       PreviewProperties props = loader->getProperties();
-      DataBuf buf = loader->getData();  // #16 getPreviewImage()
-      props.size_ = buf.size();         //     update the size
+      props.size_ = loader->dataSize();  // #16 size of the buffer from getPreviewImage()
       list.push_back(std::move(props));
     }
   }
@@ -1072,4 +1345,116 @@ PreviewImage PreviewManager::getPreviewImage(const PreviewProperties& properties
 
   return {properties, std::move(buf)};
 }
+
+PreviewImage PreviewManager::getPreviewView(const PreviewProperties& properties) const {
+#ifdef EXV_ENABLE_FILESYSTEM
+  auto loader = Loader::create(properties.id_, image_);
+  size_t offset = 0;
+  size_t size = 0;
+  if (!loader || !loader->getLocation(offset, size) || size == 0 || !dynamic_cast<const FileIo*>(&image_.io()))
+    return getPreviewImage(properties);
+
+  // Map the file separately and once, the views must not depend on the state of image_.io()
+  if (!source_) {
+    auto source = std::make_shared<FileIo>(image_.io().path());
+    if (source->open() != 0) {
+      throw Error(ErrorCode::kerDataSourceOpenFailed, source->path(), strError());
+    }
+    mapped_ = source->size() > 0 ? source->mmap() : nullptr;
+    source_ = std::move(source);
+  }
+  if (!mapped_ || Safe::add(offset, size) > source_->size())
+    return getPreviewImage(properties);
+  return {properties, source_, mapped_, offset, size};
+#else
+  return getPreviewImage(properties);
+#endif
+}
+
+#ifdef EXV_ENABLE_FILESYSTEM
+DataBuf PreviewManager::getPreviewIndex() const {
+  const auto& path = image_.io().path();
+  FileStamp stamp;
+  if (!dynamic_cast<const FileIo*>(&image_.io()) || !fileStamp(path, stamp)) {
+    throw Error(ErrorCode::kerDataSourceOpenFailed, path, strError());
+  }
+
+  Blob blob(previewIndexMagic.begin(), previewIndexMagic.end());
+  appendUint(blob, previewIndexVersion, 4);
+  appendUint(blob, stamp.size_, 8);
+  appendUint(blob, stamp.modified_, 8);
+  appendUint(blob, stamp.hash_, 8);
+  const auto list = getPreviewProperties();
+  appendUint(blob, list.size(), 4);
+  for (auto&& properties : list) {
+    auto loader = Loader::create(properties.id_, image_);
+    size_t offset = 0;
+    size_t size = 0;
+    const bool inPlace = loader && loader->getLocation(offset, size) && size == properties.size_;
+    appendUint(blob, static_cast<uint32_t>(properties.id_), 4);
+    appendUint(blob, inPlace, 1);
+    appendUint(blob, inPlace ? offset : 0, 8);
+    appendUint(blob, properties.size_, 8);
+    appendUint(blob, properties.width_, 8);
+    appendUint(blob, properties.height_, 8);
+    appendString(blob, properties.mimeType_);
+    appendString(blob, properties.extension_);
+  }
+  return {blob.data(), blob.size()};
+}
+
+PreviewIndex::PreviewIndex(const byte* data, size_t size) {
+  Internal::enforce(size >= previewIndexMagic.size() &&
+                        std::equal(previewIndexMagic.begin(), previewIndexMagic.end(), data),
+                    ErrorCode::kerCorruptedMetadata);
+  IndexReader reader(data + previewIndexMagic.size(), size - previewIndexMagic.size());
+  Internal::enforce(reader.uint(4) == previewIndexVersion, ErrorCode::kerCorruptedMetadata);
+  fileSize_ = reader.uint(8);
+  modified_ = reader.uint(8);
+  hash_ = reader.uint(8);
+  const auto count = reader.uint(4);
+  for (uint64_t i = 0; i < count; i++) {
+    PreviewProperties properties;
+    properties.id_ = static_cast<PreviewId>(reader.uint(4));
+    inPlace_.push_back(reader.uint(1) != 0);
+    offsets_.push_back(reader.uint(8));
+    properties.size_ = static_cast<size_t>(reader.uint(8));
+    properties.width_ = static_cast<size_t>(reader.uint(8));
+    properties.height_ = static_cast<size_t>(reader.uint(8));
+    properties.mimeType_ = reader.string();
+    properties.extension_ = reader.string();
+    properties_.push_back(std::move(properties));
+  }
+  Internal::enforce(reader.done(), ErrorCode::kerCorruptedMetadata);
+}
+
+bool PreviewIndex::matches(const std::string& path) const {
+  FileStamp stamp;
+  return fileStamp(path, stamp) && stamp.size_ == fileSize_ && stamp.modified_ == modified_ && stamp.hash_ == hash_;
+}
+
+const PreviewPropertiesList& PreviewIndex::getPreviewProperties() const {
+  return properties_;
+}
+
+PreviewImage PreviewIndex::getPreviewImage(const std::string& path, const PreviewProperties& properties) const {
+  auto pos = std::find_if(properties_.begin(), properties_.end(),
+                          [&](const auto& entry) { return entry.id_ == properties.id_; });
+  if (pos == properties_.end())
+    return {properties, DataBuf()};
+  const auto idx = static_cast<size_t>(pos - properties_.begin());
+  if (!inPlace_[idx] || pos->size_ == 0)
+    return {*pos, DataBuf()};
+
+  auto source = std::make_shared<FileIo>(path);
+  if (source->open() != 0) {
+    throw Error(ErrorCode::kerDataSourceOpenFailed, path, strError());
+  }
+  const auto offset = offsets_[idx];
+  if (offset > source->size() || pos->size_ > source->size() - offset)
+    return {*pos, DataBuf()};
+  const byte* mapped = source->mmap();
+  return {*pos, std::move(source), mapped, static_cast<size_t>(offset), pos->size_};
+}
+#endif
 }  // namespace Exiv2
@@ -13,6 +13,7 @@
 #include "xmp_exiv2.hpp"
 
 #include <iostream>
+#include <unordered_map>
 
 namespace {
 //! Struct used in the lookup table for pretty print functions
@@ -4949,6 +4950,7 @@ bool XmpPropertyInfo::operator==(const std::string& name) const {
 }
 
 XmpProperties::NsRegistry XmpProperties::nsRegistry_;
+uint64_t XmpProperties::nsGeneration_ = 0;
 std::mutex& XmpProperties::getMutex() {
   static std::mutex m;
   return m;
@@ -5011,6 +5013,7 @@ void XmpProperties::registerNsUnlocked(const std::string& ns, const std::string&
   xn.xmpPropertyInfo_ = nullptr;
   xn.desc_ = "";
   nsRegistry_[ns2] = xn;
+  ++nsGeneration_;
 }
 
 void XmpProperties::unregisterNs(const std::string& ns) {
@@ -5028,6 +5031,7 @@ void XmpProperties::unregisterNsNoLock(const std::string& ns, LifetimeKey) {
     delete[] i->second.prefix_;
     delete[] i->second.ns_;
     nsRegistry_.erase(i);
+    ++nsGeneration_;
   }
 }
 
@@ -5179,15 +5183,16 @@ const XmpNsInfo* XmpProperties::nsInfoUnlocked(const std::string& prefix, const
 }
 
 void XmpProperties::registeredNamespaces(Exiv2::Dictionary& nsDict) {
+  // registerNs() takes the lock of the toolkit's namespace bindings, which comes before ours
+  for (auto&& i : xmpNsInfo) {
+    Exiv2::XmpParser::registerNs(i.ns_, i.prefix_);
+  }
   // Lock must be held for the duration of registry iteration
   XmpLock lock;
   registeredNamespacesUnlocked(nsDict, lock);
 }
 
 void XmpProperties::registeredNamespacesUnlocked(Exiv2::Dictionary& nsDict, const XmpLock& lock) {
-  for (auto&& i : xmpNsInfo) {
-    Exiv2::XmpParser::registerNsImpl(i.ns_, i.prefix_);
-  }
   Exiv2::XmpParser::registeredNamespacesUnlocked(nsDict, lock);
 }
 
@@ -5219,6 +5224,76 @@ std::ostream& XmpProperties::printPropertyUnlocked(std::ostream& os, const std::
   return fct(os, value, nullptr);
 }
 
+namespace {
+//! Hash for the lookup of std::string keys by std::string_view
+struct StringHash {
+  using is_transparent = void;
+  size_t operator()(std::string_view s) const noexcept {
+    return std::hash<std::string_view>{}(s);
+  }
+};
+
+/*!
+  @brief Pool of the prefix and property strings of XmpKeys. Keys point to
+         the pooled copy instead of owning one, so the keys of a packet, and
+         of all packets with the same properties, share their strings. Each
+         entry also records the namespace registry generation its prefix was
+         last validated against, plus one (0 if it never was).
+
+  Entries never move and are never removed. Once the pool is full, new
+  strings are not pooled and keys own their copy. Guarded by the Giant Lock.
+ */
+class KeyStringPool {
+ public:
+  //! Pooled string and registry generation stamp
+  using Entry = std::pair<const std::string, uint64_t>;
+
+  //! Return the entry for \em s, nullptr if it is not pooled
+  Entry* find(std::string_view s) {
+    auto i = strings_.find(s);
+    return i == strings_.end() ? nullptr : &*i;
+  }
+  //! Return the entry for \em s, add it if there is room, else return nullptr
+  Entry* intern(std::string_view s) {
+    if (auto entry = find(s))
+      return entry;
+    if (strings_.size() >= capacity_)
+      return nullptr;
+    return &*strings_.try_emplace(std::string(s), 0).first;
+  }
+
+ private:
+  static constexpr size_t capacity_ = 8192;  //!< Maximum number of pooled strings
+  std::unordered_map<std::string, uint64_t, StringHash, std::equal_to<>> strings_;
+};
+
+//! The pool of the process. Never destroyed, keys may outlive static destruction.
+KeyStringPool& keyStringPool() {
+  static auto pool = new KeyStringPool;
+  return *pool;
+}
+
+//! A prefix or property of an XmpKey: a pooled string, or an own (short string optimized) copy
+class KeyPart {
+ public:
+  KeyPart() = default;
+  //! Constructor, refers to \em entry if there is one, else copies \em s
+  KeyPart(std::string_view s, const KeyStringPool::Entry* entry) {
+    if (entry)
+      pooled_ = &entry->first;
+    else
+      own_ = s;
+  }
+  [[nodiscard]] const std::string& str() const {
+    return pooled_ ? *pooled_ : own_;
+  }
+
+ private:
+  const std::string* pooled_{};  //!< Pooled string, if any
+  std::string own_;              //!< Own copy if the string is not pooled
+};
+}  // namespace
+
 //! @brief Internal Pimpl structure with private members and data of class XmpKey.
 struct XmpKey::Impl {
   Impl() = default;                                                                             //!< Default constructor
@@ -5234,12 +5309,20 @@ struct XmpKey::Impl {
   */
   void decomposeKey(const std::string& key);  //!< Mysterious magic
   void decomposeKeyUnlocked(const std::string& key, const XmpProperties::XmpLock&);
+  /*!
+    @brief Set prefix and property. The prefix is validated against the
+           namespace registry unless the pool has it validated against the
+           current registry already.
+
+    @throw Error if the prefix is not known.
+  */
+  void setUnlocked(std::string_view prefix, std::string_view property, const XmpProperties::XmpLock&);
 
   // DATA
   static constexpr auto familyName_ = "Xmp";  //!< "Xmp"
 
-  std::string prefix_;    //!< Prefix
-  std::string property_;  //!< Property name
+  KeyPart prefix_;    //!< Prefix
+  KeyPart property_;  //!< Property name
 };
 
 //! @brief Constructor for Internal Pimpl structure XmpKey::Impl::Impl
@@ -5248,12 +5331,26 @@ XmpKey::Impl::Impl(const std::string& prefix, const std::string& property) :
 }
 
 XmpKey::Impl::Impl(const std::string& prefix, const std::string& property, const XmpProperties::XmpLock& lock) {
-  // Validate prefix unlocked (must hold lock)
-  if (XmpProperties::nsUnlocked(prefix, lock).empty())
-    throw Error(ErrorCode::kerNoNamespaceForPrefix, prefix);
+  setUnlocked(prefix, property, lock);
+}
 
-  property_ = property;
-  prefix_ = prefix;
+void XmpKey::Impl::setUnlocked(std::string_view prefix, std::string_view property,
+                               const XmpProperties::XmpLock& lock) {
+  auto& pool = keyStringPool();
+  auto entry = pool.find(prefix);
+  const uint64_t stamp = XmpProperties::nsGeneration_ + 1;
+  if (!entry || entry->second != stamp) {
+    // Validate prefix unlocked (must hold lock)
+    const std::string p(prefix);
+    if (XmpProperties::nsUnlocked(p, lock).empty())
+      throw Error(ErrorCode::kerNoNamespaceForPrefix, p);
+    if (!entry)
+      entry = pool.intern(prefix);
+    if (entry)
+      entry->second = stamp;
+  }
+  prefix_ = KeyPart(prefix, entry);
+  property_ = KeyPart(property, pool.intern(property));
 }
 
 XmpKey::XmpKey(const std::string& key) : p_(std::make_unique<Impl>()) {
@@ -5292,7 +5389,12 @@ XmpKey* XmpKey::clone_() const {
 }
 
 std::string XmpKey::key() const {
-  return std::string(Exiv2::XmpKey::Impl::familyName_) + "." + p_->prefix_ + "." + p_->property_;
+  const auto& prefix = p_->prefix_.str();
+  const auto& property = p_->property_.str();
+  std::string key;
+  key.reserve(std::char_traits<char>::length(Impl::familyName_) + prefix.size() + property.size() + 2);
+  key.append(Impl::familyName_).append(1, '.').append(prefix).append(1, '.').append(property);
+  return key;
 }
 
 const char* XmpKey::familyName() const {
@@ -5300,11 +5402,11 @@ const char* XmpKey::familyName() const {
 }
 
 std::string XmpKey::groupName() const {
-  return p_->prefix_;
+  return p_->prefix_.str();
 }
 
 std::string XmpKey::tagName() const {
-  return p_->property_;
+  return p_->property_.str();
 }
 
 std::string XmpKey::tagLabel() const {
@@ -5329,7 +5431,7 @@ uint16_t XmpKey::tag() const {
 
 std::string XmpKey::ns() const {
   XmpProperties::XmpLock lock;
-  return XmpProperties::nsUnlocked(p_->prefix_, lock);
+  return XmpProperties::nsUnlocked(p_->prefix_.str(), lock);
 }
 
 //! @cond IGNORE
@@ -5347,19 +5449,14 @@ void XmpKey::Impl::decomposeKeyUnlocked(const std::string& key, const XmpPropert
   pos1 = key.find('.', pos0);
   if (pos1 == std::string::npos)
     throw Error(ErrorCode::kerInvalidKey, key);
-  std::string prefix = key.substr(pos0, pos1 - pos0);
+  const auto prefix = std::string_view(key).substr(pos0, pos1 - pos0);
   if (prefix.empty())
     throw Error(ErrorCode::kerInvalidKey, key);
-  std::string property = key.substr(pos1 + 1);
+  const auto property = std::string_view(key).substr(pos1 + 1);
   if (property.empty())
     throw Error(ErrorCode::kerInvalidKey, key);
 
-  // Validate prefix unlocked (must hold lock)
-  if (XmpProperties::nsUnlocked(prefix, lock).empty())
-    throw Error(ErrorCode::kerNoNamespaceForPrefix, prefix);
-
-  property_ = std::move(property);
-  prefix_ = std::move(prefix);
+  setUnlocked(prefix, property, lock);
 }  // XmpKey::Impl::decomposeKeyUnlocked
 
 // *************************************************************************
@@ -231,7 +231,7 @@ void PsdImage::readResourceBlock(uint16_t resourceId, uint32_t resourceSize) {
       io_->read(rawExif.data(), rawExif.size());
       if (io_->error() || io_->eof())
         throw Error(ErrorCode::kerFailedToReadImageData);
-      const DecodeParams dp(max_recursion_depth_);
+      const DecodeParams dp(max_recursion_depth_, lazyMakernotes());
       ByteOrder bo = ExifParser::decode(exifData_, rawExif.c_data(), rawExif.size(), dp);
       setByteOrder(bo);
       if (!rawExif.empty() && byteOrder() == invalidByteOrder) {
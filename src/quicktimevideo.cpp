@@ -32,9 +32,15 @@
 #include "tags.hpp"
 #include "tags_int.hpp"
 // + standard includes
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <set>
 #include <string>
+#include <vector>
 // *****************************************************************************
 // class member definitions
 namespace Exiv2::Internal {
@@ -530,6 +536,281 @@ static bool dataIgnoreList(Exiv2::DataBuf& buf) {
 
   return false;
 }
+
+//! The UUID of the uuid atom which holds XMP, BE7ACFCB-97A9-42E8-9C71-999491E3AFAC
+static constexpr byte xmpUuid[] = {0xbe, 0x7a, 0xcf, 0xcb, 0x97, 0xa9, 0x42, 0xe8,
+                                   0x9c, 0x71, 0x99, 0x94, 0x91, 0xe3, 0xaf, 0xac};
+
+//! A top level atom of a QuickTime file
+struct QTimeAtom {
+  uint64_t pos_;      //!< Position of the atom in the file
+  uint64_t size_;     //!< Size of the atom, header included
+  uint64_t hdrSize_;  //!< Size of the header
+  std::string type_;  //!< Atom type, e.g. "moov"
+  bool toEnd_;        //!< The atom extends to the end of the file
+};
+
+//! The top level atoms of the file \em io
+static std::vector<QTimeAtom> topLevelAtoms(BasicIo& io) {
+  std::vector<QTimeAtom> atoms;
+  const uint64_t fileSize = io.size();
+  uint64_t pos = 0;
+  while (pos < fileSize) {
+    byte hdr[16];
+    io.seek(static_cast<int64_t>(pos), BasicIo::beg);
+    enforce(fileSize - pos >= 8 && io.read(hdr, 8) == 8, ErrorCode::kerCorruptedMetadata);
+    QTimeAtom atom{pos, getULong(hdr, bigEndian), 8, std::string(reinterpret_cast<const char*>(hdr + 4), 4), false};
+    if (atom.size_ == 1) {
+      enforce(fileSize - pos >= 16 && io.read(hdr + 8, 8) == 8, ErrorCode::kerCorruptedMetadata);
+      atom.size_ = getULongLong(hdr + 8, bigEndian);
+      atom.hdrSize_ = 16;
+    } else if (atom.size_ == 0) {
+      atom.size_ = fileSize - pos;
+      atom.toEnd_ = true;
+    }
+    enforce(atom.size_ >= atom.hdrSize_ && atom.size_ <= fileSize - pos, ErrorCode::kerCorruptedMetadata);
+    pos += atom.size_;
+    atoms.push_back(std::move(atom));
+  }
+  return atoms;
+}
+
+//! Append an atom of type \em type with the payload \em data of \em size bytes to \em out
+static void appendAtom(Blob& out, const char* type, const byte* data, size_t size) {
+  enforce(size <= std::numeric_limits<uint32_t>::max() - 8, ErrorCode::kerImageWriteFailed);
+  byte hdr[8];
+  ul2Data(hdr, static_cast<uint32_t>(size + 8), bigEndian);
+  std::copy_n(type, 4, hdr + 4);
+  out.insert(out.end(), hdr, hdr + 8);
+  if (size > 0)
+    out.insert(out.end(), data, data + size);
+}
+
+//! The size of the atom at \em pos of \em buf which ends at \em end, at least 8
+static size_t atomSize(const byte* buf, size_t pos, size_t end) {
+  enforce(end - pos >= 8, ErrorCode::kerCorruptedMetadata);
+  const size_t size = getULong(buf + pos, bigEndian);
+  enforce(size >= 8 && size <= end - pos, ErrorCode::kerCorruptedMetadata);
+  return size;
+}
+
+/*!
+  @brief Add \em delta to the chunk offsets in the stco and co64 atoms among
+      the atoms from \em pos to \em end of \em buf which are at least \em from.
+ */
+static void shiftChunkOffsets(Blob& buf, size_t pos, size_t end, uint64_t from, int64_t delta) {
+  while (pos < end) {
+    const size_t size = atomSize(buf.data(), pos, end);
+    const std::string type(reinterpret_cast<const char*>(buf.data() + pos + 4), 4);
+    if (type == "trak" || type == "mdia" || type == "minf" || type == "stbl") {
+      shiftChunkOffsets(buf, pos + 8, pos + size, from, delta);
+    } else if ((type == "stco" || type == "co64") && size >= 16) {
+      const size_t entrySize = type == "stco" ? 4 : 8;
+      const size_t count = getULong(buf.data() + pos + 12, bigEndian);
+      enforce(count <= (size - 16) / entrySize, ErrorCode::kerCorruptedMetadata);
+      for (byte* entry = buf.data() + pos + 16; entry != buf.data() + pos + 16 + count * entrySize;
+           entry += entrySize) {
+        uint64_t offset = entrySize == 4 ? getULong(entry, bigEndian) : getULongLong(entry, bigEndian);
+        if (offset < from)
+          continue;
+        offset += delta;
+        if (entrySize == 4) {
+          if (offset > std::numeric_limits<uint32_t>::max())
+            throw Error(ErrorCode::kerErrorMessage, "Chunk offset out of range of the stco atom");
+          ul2Data(entry, static_cast<uint32_t>(offset), bigEndian);
+        } else {
+          ull2Data(entry, offset, bigEndian);
+        }
+      }
+    }
+    pos += size;
+  }
+}
+
+/*!
+  @brief Return the payload of the user data atom \em data of \em size bytes,
+      updated with the text atoms for the properties of \em xmpData and the
+      XMP packet \em packet. Other atoms are kept as they are.
+ */
+static Blob updateUserData(const byte* data, size_t size, const XmpData& xmpData, const std::string& packet) {
+  Blob out;
+  std::set<std::string> written;
+  // A text atom: the size and the language code of the text, then the text
+  const auto text = [&](const char* type, const std::string& key, uint16_t language) {
+    auto value = xmpData.findKey(XmpKey(key));
+    if (value == xmpData.end() || written.count(key))
+      return;
+    const std::string str = value->toString();
+    if (str.empty() || str.size() > std::numeric_limits<uint16_t>::max())
+      return;
+    Blob payload(4);
+    us2Data(payload.data(), static_cast<uint16_t>(str.size()), bigEndian);
+    us2Data(payload.data() + 2, language, bigEndian);
+    payload.insert(payload.end(), str.begin(), str.end());
+    appendAtom(out, type, payload.data(), payload.size());
+    written.insert(key);
+  };
+  // The key of a text atom, whose type starts with the copyright sign
+  const auto textKey = [](const byte* type) -> const char* {
+    if (type[0] != 0xa9)
+      return nullptr;
+    const std::string voc{' ', static_cast<char>(type[1]), static_cast<char>(type[2]), static_cast<char>(type[3])};
+    auto tag = Exiv2::find(userDataReferencetags, voc);
+    return tag && tag->voc_ == voc ? tag->label_ : nullptr;
+  };
+  const uint16_t undetermined = 0x55c4;
+
+  size_t pos = 0;
+  while (size - pos >= 8) {
+    const size_t atomSize = getULong(data + pos, bigEndian);
+    if (atomSize < 8 || atomSize > size - pos)
+      break;
+    const byte* type = data + pos + 4;
+    if (auto key = textKey(type)) {
+      const uint16_t language = atomSize >= 12 ? getUShort(data + pos + 10, bigEndian) : undetermined;
+      text(reinterpret_cast<const char*>(type), key, language);
+    } else if (!std::equal(type, type + 4, "XMP_")) {
+      out.insert(out.end(), data + pos, data + pos + atomSize);
+    }
+    pos += atomSize;
+  }
+  for (const auto& tag : userDataReferencetags) {
+    if (tag.voc_[0] == ' ') {
+      const char type[] = {'\xa9', tag.voc_[1], tag.voc_[2], tag.voc_[3]};
+      text(type, tag.label_, undetermined);
+    }
+  }
+  if (!packet.empty())
+    appendAtom(out, "XMP_", reinterpret_cast<const byte*>(packet.data()), packet.size());
+  // What follows the last atom, like the 32 bit zero which may end the user data
+  out.insert(out.end(), data + pos, data + size);
+  return out;
+}
+
+//! The payload of an atom of the moov atom, in memory
+struct AtomSlice {
+  const byte* data_;
+  size_t size_;
+};
+
+//! The 32 bit value at \em pos of \em atom
+static uint32_t readUInt32(const AtomSlice& atom, size_t pos) {
+  enforce(pos <= atom.size_ && atom.size_ - pos >= 4, ErrorCode::kerCorruptedMetadata);
+  return getULong(atom.data_ + pos, bigEndian);
+}
+
+//! The payload of the first atom of type \em type in \em parent, if there is one
+static std::optional<AtomSlice> childAtom(const AtomSlice& parent, const char* type) {
+  for (size_t pos = 0; pos < parent.size_;) {
+    const size_t size = atomSize(parent.data_, pos, parent.size_);
+    if (std::equal(type, type + 4, parent.data_ + pos + 4))
+      return AtomSlice{parent.data_ + pos + 8, size - 8};
+    pos += size;
+  }
+  return std::nullopt;
+}
+
+//! The most samples of a telemetry track, a larger count is taken for a corrupted sample table
+constexpr size_t maxTelemetrySamples = 1 << 24;
+
+/*!
+  @brief The telemetry track of the trak atom \em trak of the video \em io,
+      if it is a timed metadata track in one of the known formats.
+ */
+static std::optional<TelemetryTrack> telemetryTrack(BasicIo& io, const AtomSlice& trak) {
+  const auto mdia = childAtom(trak, "mdia");
+  const auto minf = mdia ? childAtom(*mdia, "minf") : std::nullopt;
+  const auto stbl = minf ? childAtom(*minf, "stbl") : std::nullopt;
+  const auto stsd = stbl ? childAtom(*stbl, "stsd") : std::nullopt;
+  if (!stsd || stsd->size_ < 16)
+    return std::nullopt;
+  // The format of the first sample description
+  std::string format(reinterpret_cast<const char*>(stsd->data_ + 12), 4);
+  if (format != "gpmd" && format != "camm" && format != "rtmd")
+    return std::nullopt;
+
+  const auto tkhd = childAtom(trak, "tkhd");
+  const auto mdhd = childAtom(*mdia, "mdhd");
+  const auto stts = childAtom(*stbl, "stts");
+  const auto stsc = childAtom(*stbl, "stsc");
+  const auto stsz = childAtom(*stbl, "stsz");
+  auto chunkOffsets = childAtom(*stbl, "stco");
+  const size_t offsetSize = chunkOffsets ? 4 : 8;
+  if (!chunkOffsets)
+    chunkOffsets = childAtom(*stbl, "co64");
+  if (!tkhd || !mdhd || !stts || !stsc || !stsz || !chunkOffsets || tkhd->size_ < 1 || mdhd->size_ < 1)
+    return std::nullopt;
+  const uint32_t trackId = readUInt32(*tkhd, tkhd->data_[0] == 1 ? 20 : 12);
+  const uint32_t timeScale = std::max(1U, readUInt32(*mdhd, mdhd->data_[0] == 1 ? 20 : 12));
+
+  // The samples, chunk by chunk
+  const uint32_t sampleSize = readUInt32(*stsz, 4);
+  const size_t count = readUInt32(*stsz, 8);
+  enforce(count <= maxTelemetrySamples, ErrorCode::kerCorruptedMetadata);
+  enforce(sampleSize != 0 || (stsz->size_ - 12) / 4 >= count, ErrorCode::kerCorruptedMetadata);
+  const size_t chunks = readUInt32(*chunkOffsets, 4);
+  enforce((chunkOffsets->size_ - 8) / offsetSize >= chunks, ErrorCode::kerCorruptedMetadata);
+  const size_t runs = readUInt32(*stsc, 4);
+  enforce((stsc->size_ - 8) / 12 >= runs, ErrorCode::kerCorruptedMetadata);
+  const uint64_t fileSize = io.size();
+
+  std::vector<TelemetryTrack::Entry> entries;
+  entries.reserve(count);
+  for (size_t run = 0; run < runs && entries.size() < count; ++run) {
+    const size_t firstChunk = readUInt32(*stsc, 8 + 12 * run);
+    const uint32_t samplesPerChunk = readUInt32(*stsc, 12 + 12 * run);
+    const size_t lastChunk = run + 1 < runs ? readUInt32(*stsc, 8 + 12 * (run + 1)) - size_t{1} : chunks;
+    enforce(firstChunk >= 1 && lastChunk <= chunks, ErrorCode::kerCorruptedMetadata);
+    for (size_t chunk = firstChunk; chunk <= lastChunk && entries.size() < count; ++chunk) {
+      const byte* pos = chunkOffsets->data_ + 8 + (chunk - 1) * offsetSize;
+      uint64_t offset = offsetSize == 4 ? getULong(pos, bigEndian) : getULongLong(pos, bigEndian);
+      for (uint32_t i = 0; i < samplesPerChunk && entries.size() < count; ++i) {
+        const uint32_t size = sampleSize != 0 ? sampleSize : readUInt32(*stsz, 12 + 4 * entries.size());
+        enforce(offset <= fileSize && size <= fileSize - offset, ErrorCode::kerCorruptedMetadata);
+        entries.push_back({offset, size, 0, 0});
+        offset += size;
+      }
+    }
+  }
+
+  // The times of the samples, from the durations in the time-to-sample table
+  const size_t timeRuns = readUInt32(*stts, 4);
+  enforce((stts->size_ - 8) / 8 >= timeRuns, ErrorCode::kerCorruptedMetadata);
+  uint64_t time = 0;
+  auto entry = entries.begin();
+  for (size_t run = 0; run < timeRuns; ++run) {
+    const uint32_t samples = readUInt32(*stts, 8 + 8 * run);
+    const uint32_t duration = readUInt32(*stts, 12 + 8 * run);
+    for (uint32_t i = 0; i < samples && entry != entries.end(); ++i, ++entry) {
+      entry->time_ = time;
+      entry->duration_ = duration;
+      time += duration;
+    }
+  }
+  for (; entry != entries.end(); ++entry)
+    entry->time_ = time;
+  return TelemetryTrack(io, std::move(format), trackId, timeScale, std::move(entries));
+}
+
+/*!
+  @brief The telemetry track of the Novatek gps atom \em gps of the video
+      \em io: a header of 8 bytes, then the position and the size of the GPS
+      data of each second.
+ */
+static TelemetryTrack novatekTrack(BasicIo& io, const AtomSlice& gps) {
+  const uint64_t fileSize = io.size();
+  std::vector<TelemetryTrack::Entry> entries;
+  for (size_t pos = 8; pos + 8 <= gps.size_; pos += 8) {
+    const uint32_t offset = readUInt32(gps, pos);
+    const uint32_t size = readUInt32(gps, pos + 4);
+    if (offset == 0 || size == 0)
+      continue;
+    enforce(offset <= fileSize && size <= fileSize - offset, ErrorCode::kerCorruptedMetadata);
+    entries.push_back({offset, size, 1, entries.size()});
+  }
+  return TelemetryTrack(io, "gps ", 0, 1, std::move(entries));
+}
+
 }  // namespace Exiv2::Internal
 
 namespace Exiv2 {
@@ -545,6 +826,184 @@ std::string QuickTimeVideo::mimeType() const {
 }
 
 void QuickTimeVideo::writeMetadata() {
+  if (io_->open() != 0)
+    throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
+  IoCloser closer(*io_);
+  if (!isQTimeType(*io_, false)) {
+    if (io_->error() || io_->eof())
+      throw Error(ErrorCode::kerFailedToReadImageData);
+    throw Error(ErrorCode::kerNotAnImage, "QuickTime");
+  }
+  const uint64_t fileSize = io_->size();
+  const auto atoms = topLevelAtoms(*io_);
+  auto moov = std::find_if(atoms.begin(), atoms.end(), [](const QTimeAtom& atom) { return atom.type_ == "moov"; });
+  if (moov == atoms.end())
+    throw Error(ErrorCode::kerCorruptedMetadata);
+  enforce(moov->size_ <= std::numeric_limits<uint32_t>::max(), ErrorCode::kerCorruptedMetadata);
+
+  // ISO base media files (MP4) keep the XMP packet in a uuid atom at the top level, QuickTime files
+  // in the user data of the movie
+  bool isoBrand = false;
+  auto ftyp = std::find_if(atoms.begin(), atoms.end(), [](const QTimeAtom& atom) { return atom.type_ == "ftyp"; });
+  if (ftyp != atoms.end() && ftyp->size_ >= ftyp->hdrSize_ + 4) {
+    byte brand[4];
+    io_->seek(static_cast<int64_t>(ftyp->pos_ + ftyp->hdrSize_), BasicIo::beg);
+    isoBrand = io_->read(brand, 4) == 4 && !std::equal(brand, brand + 4, "qt  ");
+  }
+
+  // The XMP packet, without the properties of the movie
+  if (!writeXmpFromPacket()) {
+    XmpData packetData;
+    for (const auto& xmp : xmpData_) {
+      if (xmp.groupName() != "video" && xmp.groupName() != "audio")
+        packetData.add(xmp);
+    }
+    if (XmpParser::encode(xmpPacket_, packetData) > 1) {
+#ifndef SUPPRESS_WARNINGS
+      EXV_ERROR << "Failed to encode XMP metadata." << '\n';
+#endif
+    }
+  }
+
+  // The new moov atom, with the user data updated. That of a QuickTime file holds the XMP packet.
+  const std::string userDataPacket = isoBrand ? std::string() : xmpPacket_;
+  DataBuf payload(static_cast<size_t>(moov->size_ - moov->hdrSize_));
+  io_->seek(static_cast<int64_t>(moov->pos_ + moov->hdrSize_), BasicIo::beg);
+  io_->readOrThrow(payload.data(), payload.size(), ErrorCode::kerFailedToReadImageData);
+  Blob movie;
+  bool hasUserData = false;
+  for (size_t pos = 0; pos < payload.size();) {
+    const size_t size = atomSize(payload.c_data(), pos, payload.size());
+    const byte* atom = payload.c_data(pos);
+    if (std::equal(atom + 4, atom + 8, "cmov"))
+      throw Error(ErrorCode::kerWritingImageFormatUnsupported, "QuickTime with a compressed movie");
+    if (std::equal(atom + 4, atom + 8, "udta") && !hasUserData) {
+      hasUserData = true;
+      const Blob userData = updateUserData(atom + 8, size - 8, xmpData_, userDataPacket);
+      if (!userData.empty())
+        appendAtom(movie, "udta", userData.data(), userData.size());
+    } else {
+      movie.insert(movie.end(), atom, atom + size);
+    }
+    pos += size;
+  }
+  if (!hasUserData) {
+    const Blob userData = updateUserData(nullptr, 0, xmpData_, userDataPacket);
+    if (!userData.empty())
+      appendAtom(movie, "udta", userData.data(), userData.size());
+  }
+
+  // XMP in a uuid atom at the top level: that of an ISO file is written again after the moov atom,
+  // that of a QuickTime file would shadow the packet in the user data
+  std::vector<uint64_t> xmpUuids;
+  for (const auto& atom : atoms) {
+    byte uuid[16];
+    if (atom.type_ != "uuid" || atom.size_ < atom.hdrSize_ + 16)
+      continue;
+    io_->seek(static_cast<int64_t>(atom.pos_ + atom.hdrSize_), BasicIo::beg);
+    if (io_->read(uuid, 16) == 16 && std::equal(uuid, uuid + 16, xmpUuid))
+      xmpUuids.push_back(atom.pos_);
+  }
+
+  // The room for the moov atom: its own, and that of the free and XMP atoms after it
+  auto next = std::next(moov);
+  while (next != atoms.end() && !next->toEnd_ &&
+         (next->type_ == "free" || next->type_ == "skip" ||
+          std::find(xmpUuids.begin(), xmpUuids.end(), next->pos_) != xmpUuids.end()))
+    ++next;
+  const uint64_t room = (next == atoms.end() ? fileSize : next->pos_) - moov->pos_;
+  const bool atEnd = next == atoms.end();
+  const bool mediaFollows = std::any_of(next, atoms.end(), [](const QTimeAtom& atom) {
+    return atom.type_ == "mdat" || atom.type_ == "moof" || atom.toEnd_;
+  });
+  // The XMP atoms outside of the room, which become free atoms when the moov atom is written there
+  std::vector<uint64_t> xmpUuidsLeft;
+  std::copy_if(xmpUuids.begin(), xmpUuids.end(), std::back_inserter(xmpUuidsLeft),
+               [&](uint64_t pos) { return pos < moov->pos_ || pos >= moov->pos_ + room; });
+
+  const auto write = [](BasicIo& io, uint64_t pos, const byte* data, size_t size) {
+    io.seek(static_cast<int64_t>(pos), BasicIo::beg);
+    if (io.write(data, size) != size)
+      throw Error(ErrorCode::kerImageWriteFailed);
+  };
+  const byte freeType[] = {'f', 'r', 'e', 'e'};
+  movie.insert(movie.begin(), 8, 0);
+  std::copy_n("moov", 4, movie.begin() + 4);
+  enforce(movie.size() <= std::numeric_limits<uint32_t>::max(), ErrorCode::kerImageWriteFailed);
+  ul2Data(movie.data(), static_cast<uint32_t>(movie.size()), bigEndian);
+  const size_t moovSize = movie.size();
+  if (isoBrand && !xmpPacket_.empty()) {
+    Blob uuid(std::begin(xmpUuid), std::end(xmpUuid));
+    uuid.insert(uuid.end(), xmpPacket_.begin(), xmpPacket_.end());
+    appendAtom(movie, "uuid", uuid.data(), uuid.size());
+  }
+  if (movie.size() < room && room - movie.size() < 8 && atEnd)
+    appendAtom(movie, "free", nullptr, 0);
+
+  if (movie.size() == room || movie.size() + 8 <= room || atEnd) {
+    // In place, with a free atom for the rest of the room
+    write(*io_, moov->pos_, movie.data(), movie.size());
+    if (movie.size() < room) {
+      enforce(room - movie.size() <= std::numeric_limits<uint32_t>::max(), ErrorCode::kerImageWriteFailed);
+      byte hdr[8];
+      ul2Data(hdr, static_cast<uint32_t>(room - movie.size()), bigEndian);
+      std::copy_n(freeType, 4, hdr + 4);
+      write(*io_, moov->pos_ + movie.size(), hdr, 8);
+    }
+  } else if (!mediaFollows) {
+    // At the end of the file, the old moov atom becomes a free atom
+    write(*io_, fileSize, movie.data(), movie.size());
+    write(*io_, moov->pos_ + 4, freeType, 4);
+    xmpUuidsLeft = xmpUuids;
+  } else {
+    // Rewrite the file, the media data moves by the difference in size. Movie fragments
+    // may refer to it by absolute offsets, which are not adjusted.
+    if (std::any_of(next, atoms.end(), [](const QTimeAtom& atom) { return atom.type_ == "moof"; }))
+      throw Error(ErrorCode::kerWritingImageFormatUnsupported, "Fragmented QuickTime");
+    const auto delta = static_cast<int64_t>(movie.size()) - static_cast<int64_t>(room);
+    shiftChunkOffsets(movie, 8, moovSize, moov->pos_, delta);
+    for (auto& pos : xmpUuidsLeft) {
+      if (pos > moov->pos_)
+        pos += delta;
+    }
+    auto tempIo = createTemporary(*io_);
+    const byte* data = io_->mmap();
+    if (io_->error())
+      throw Error(ErrorCode::kerFailedToReadImageData);
+    const auto copy = [&](uint64_t start, uint64_t end) {
+      const auto size = static_cast<size_t>(end - start);
+      size_t written = 0;
+#ifdef EXV_ENABLE_FILESYSTEM
+      auto file = dynamic_cast<FileIo*>(tempIo.get());
+      auto source = dynamic_cast<const FileIo*>(io_.get());
+      if (file && source)
+        written = file->write(*source, data + start, size);
+      else
+#endif
+        written = tempIo->write(data + start, size);
+      if (written != size)
+        throw Error(ErrorCode::kerImageWriteFailed);
+    };
+    copy(0, moov->pos_);
+    if (tempIo->write(movie.data(), movie.size()) != movie.size())
+      throw Error(ErrorCode::kerImageWriteFailed);
+    copy(moov->pos_ + room, fileSize);
+    for (auto pos : xmpUuidsLeft)
+      write(*tempIo, pos + 4, freeType, 4);
+    io_->close();
+    io_->transfer(*tempIo);  // may throw
+    return;
+  }
+  for (auto pos : xmpUuidsLeft)
+    write(*io_, pos + 4, freeType, 4);
+}  // QuickTimeVideo::writeMetadata
+
+void QuickTimeVideo::setSummarizeSampleTables(bool flag) {
+  summarizeSampleTables_ = flag;
+}
+
+bool QuickTimeVideo::summarizeSampleTables() const {
+  return summarizeSampleTables_;
 }
 
 void QuickTimeVideo::readMetadata() {
@@ -562,6 +1021,9 @@ void QuickTimeVideo::readMetadata() {
   clearMetadata();
   continueTraversing_ = true;
   height_ = width_ = 1;
+  mdhdDuration_ = 0;
+  moovPos_ = 0;
+  moovSize_ = 0;
 
   xmpData_["Xmp.video.FileSize"] = static_cast<double>(io_->size()) / 1048576.0;
   xmpData_["Xmp.video.MimeType"] = mimeType();
@@ -610,7 +1072,11 @@ void QuickTimeVideo::decodeBlock(size_t recursion_depth, std::string const& ente
 
   // std::cerr<<"Tag=>"<<buf.data()<<"     size=>"<<size-hdrsize << '\n';
   const auto newsize = static_cast<size_t>(size - hdrsize);
-  if (ignoreList(buf)) {
+  if (recursion_depth == 0 && equalsQTimeTag(buf, "moov")) {
+    moovPos_ = io_->tell();
+    moovSize_ = newsize;
+  }
+  if (ignoreList(buf) && !(summarizeSampleTables_ && equalsQTimeTag(buf, "stsz"))) {
     discard(newsize);
     return;
   }
@@ -632,7 +1098,10 @@ void QuickTimeVideo::tagDecoder(Exiv2::DataBuf& buf, size_t size, size_t recursi
   enforce(recursion_depth < max_recursion_depth_, Exiv2::ErrorCode::kerCorruptedMetadata);
   assert(buf.size() > 4);
 
-  if (ignoreList(buf))
+  if (summarizeSampleTables_ && equalsQTimeTag(buf, "stsz"))
+    sampleSizeDecoder(size);
+
+  else if (ignoreList(buf))
     discard(size);
 
   else if (dataIgnoreList(buf)) {
@@ -668,7 +1137,7 @@ void QuickTimeVideo::tagDecoder(Exiv2::DataBuf& buf, size_t size, size_t recursi
     sampleDesc(size);
 
   else if (equalsQTimeTag(buf, "stts"))
-    timeToSampleDecoder();
+    timeToSampleDecoder(size);
 
   else if (equalsQTimeTag(buf, "pnot"))
     previewTagDecoder(size);
@@ -697,6 +1166,16 @@ void QuickTimeVideo::tagDecoder(Exiv2::DataBuf& buf, size_t size, size_t recursi
       discard(size);
   }
 
+  else if (equalsQTimeTag(buf, "uuid") && size >= 16) {
+    // Adobe stores XMP in a uuid atom at the top level of MP4 files
+    byte uuid[16];
+    io_->readOrThrow(uuid, 16);
+    if (std::equal(uuid, uuid + 16, xmpUuid))
+      xmpPacketDecoder(size - 16);
+    else
+      discard(size - 16);
+  }
+
   else if (equalsQTimeTag(buf, "dcom")) {
     xmpData_["Xmp.video.Compressor"] = readString(*io_, size);
   }
@@ -712,6 +1191,27 @@ void QuickTimeVideo::tagDecoder(Exiv2::DataBuf& buf, size_t size, size_t recursi
   }
 }  // QuickTimeVideo::tagDecoder
 
+void QuickTimeVideo::xmpPacketDecoder(size_t size) {
+  enforce(size <= io_->size() - io_->tell(), Exiv2::ErrorCode::kerCorruptedMetadata);
+  xmpPacket_.assign(size, '\0');
+  io_->readOrThrow(reinterpret_cast<byte*>(xmpPacket_.data()), size);
+  XmpData xmpData;
+  const DecodeParams dp(max_recursion_depth_);
+  if (XmpParser::decode(xmpData, xmpPacket_, dp)) {
+#ifndef SUPPRESS_WARNINGS
+    EXV_WARNING << "Failed to decode XMP metadata.\n";
+#endif
+  }
+  // A file may hold a packet both in the user data and in a uuid atom, the one read last wins
+  for (const auto& xmp : xmpData) {
+    auto pos = xmpData_.findKey(XmpKey(xmp.key()));
+    if (pos == xmpData_.end())
+      xmpData_.add(xmp);
+    else
+      *pos = xmp;
+  }
+}  // QuickTimeVideo::xmpPacketDecoder
+
 void QuickTimeVideo::discard(size_t size) {
   size_t cur_pos = io_->tell();
   io_->seek(cur_pos + size, BasicIo::beg);
@@ -900,6 +1400,9 @@ void QuickTimeVideo::userDataDecoder(size_t outer_size, size_t recursion_depth)
         xmpData_[_(tv->label_)] = buf.data();
     }
 
+    else if (equalsQTimeTag(buf, "XMP_"))
+      xmpPacketDecoder(size - 8);
+
     else if (tv) {
       io_->readOrThrow(buf.data(), 4);
       xmpData_[_(tv->label_)] = readString(*io_, size - 12);
@@ -909,6 +1412,8 @@ void QuickTimeVideo::userDataDecoder(size_t outer_size, size_t recursion_depth)
       tagDecoder(buf, size - 8, recursion_depth + 1);
 
     enforce(io_->tell() <= loop_start_pos + size, Exiv2::ErrorCode::kerCorruptedMetadata);
+    // Decoders of containers, like meta, may stop before the end of the atom
+    io_->seek(loop_start_pos + size, BasicIo::beg);
   }
 
   io_->seek(start_pos + outer_size, BasicIo::beg);
@@ -1156,20 +1661,23 @@ void QuickTimeVideo::setMediaStream(size_t atom_size) {
   io_->seek(current_position, BasicIo::beg);
 }  // QuickTimeVideo::setMediaStream
 
-void QuickTimeVideo::timeToSampleDecoder() {
-  DataBuf buf(4 + 1);
-  io_->readOrThrow(buf.data(), 4);
-  io_->readOrThrow(buf.data(), 4);
+void QuickTimeVideo::timeToSampleDecoder(size_t size) {
+  if (summarizeSampleTables_ || size < 8) {
+    discard(size);
+    return;
+  }
+  // The whole table in one read, the entries are pairs of sample count and sample duration
+  DataBuf buf(size);
+  io_->readOrThrow(buf.data(), size);
+  const size_t noOfEntries = std::min<size_t>(buf.read_uint32(4, bigEndian), (size - 8) / 8);
   uint64_t totalframes = 0;
   uint64_t timeOfFrames = 0;
-  const uint32_t noOfEntries = buf.read_uint32(0, bigEndian);
 
-  for (uint32_t i = 0; i < noOfEntries; i++) {
-    io_->readOrThrow(buf.data(), 4);
-    const uint64_t temp = buf.read_uint32(0, bigEndian);
-    totalframes = Safe::add(totalframes, temp);
-    io_->readOrThrow(buf.data(), 4);
-    timeOfFrames = Safe::add(timeOfFrames, temp * buf.read_uint32(0, bigEndian));
+  const byte* entries = buf.c_data(8);
+  for (const byte* entry = entries; entry != entries + 8 * noOfEntries; entry += 8) {
+    const uint64_t temp = getULong(entry, bigEndian);
+    totalframes += temp;
+    timeOfFrames = Safe::add(timeOfFrames, temp * getULong(entry + 4, bigEndian));
   }
   if (currentStream_ == Video) {
     if (timeOfFrames == 0)
@@ -1179,6 +1687,20 @@ void QuickTimeVideo::timeToSampleDecoder() {
   }
 }  // QuickTimeVideo::timeToSampleDecoder
 
+void QuickTimeVideo::sampleSizeDecoder(size_t size) {
+  const size_t cur_pos = io_->tell();
+  // Version and flags, the sample size if all samples have the same size, and the sample count
+  if (currentStream_ == Video && size >= 12) {
+    DataBuf buf(12);
+    io_->readOrThrow(buf.data(), buf.size());
+    const uint64_t totalframes = buf.read_uint32(8, bigEndian);
+    if (mdhdDuration_ != 0)
+      xmpData_["Xmp.video.FrameRate"] = static_cast<double>(totalframes) * static_cast<double>(mdhdTimeScale_) /
+                                        static_cast<double>(mdhdDuration_);
+  }
+  io_->seek(Safe::add(cur_pos, size), BasicIo::beg);
+}  // QuickTimeVideo::sampleSizeDecoder
+
 void QuickTimeVideo::sampleDesc(size_t size) {
   DataBuf buf(100);
   size_t cur_pos = io_->tell();
@@ -1186,7 +1708,9 @@ void QuickTimeVideo::sampleDesc(size_t size) {
   io_->readOrThrow(buf.data(), 4);
   const uint32_t noOfEntries = buf.read_uint32(0, bigEndian);
 
-  for (uint32_t i = 0; i < noOfEntries; i++) {
+  // The descriptions of a track are usually all alike, the summary decodes the first one
+  const uint32_t decodedEntries = summarizeSampleTables_ ? std::min(noOfEntries, 1U) : noOfEntries;
+  for (uint32_t i = 0; i < decodedEntries; i++) {
     if (currentStream_ == Video)
       imageDescDecoder();
     else if (currentStream_ == Audio)
@@ -1443,6 +1967,7 @@ void QuickTimeVideo::mediaHeaderDecoder(size_t size) {
         mdhdTimeScale_ = time_scale;
         break;
       case MediaDuration:
+        mdhdDuration_ = buf.read_uint32(0, bigEndian);
         if (currentStream_ == Video)
           xmpData_["Xmp.video.MediaDuration"] = time_scale ? buf.read_uint32(0, bigEndian) / time_scale : 0;
         else if (currentStream_ == Audio)
@@ -1601,6 +2126,79 @@ void QuickTimeVideo::movieHeaderDecoder(size_t size) {
   io_->readOrThrow(buf.data(), size % 4);
 }  // QuickTimeVideo::movieHeaderDecoder
 
+std::vector<TelemetryTrack> QuickTimeVideo::telemetryTracks() const {
+  std::vector<TelemetryTrack> tracks;
+  if (moovSize_ == 0)
+    return tracks;
+  if (io_->open() != 0)
+    throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
+  IoCloser closer(*io_);
+  enforce(moovPos_ <= io_->size() && moovSize_ <= io_->size() - moovPos_, ErrorCode::kerCorruptedMetadata);
+  DataBuf moov(moovSize_);
+  io_->seek(static_cast<int64_t>(moovPos_), BasicIo::beg);
+  io_->readOrThrow(moov.data(), moov.size(), ErrorCode::kerFailedToReadImageData);
+
+  const AtomSlice movie{moov.c_data(), moov.size()};
+  for (size_t pos = 0; pos < movie.size_;) {
+    const size_t size = atomSize(movie.data_, pos, movie.size_);
+    const AtomSlice atom{movie.data_ + pos + 8, size - 8};
+    if (std::equal(movie.data_ + pos + 4, movie.data_ + pos + 8, "trak")) {
+      if (auto track = telemetryTrack(*io_, atom))
+        tracks.push_back(std::move(*track));
+    } else if (std::equal(movie.data_ + pos + 4, movie.data_ + pos + 8, "udta")) {
+      if (auto gps = childAtom(atom, "gps "))
+        tracks.push_back(novatekTrack(*io_, *gps));
+    }
+    pos += size;
+  }
+  return tracks;
+}  // QuickTimeVideo::telemetryTracks
+
+TelemetryTrack::TelemetryTrack(BasicIo& io, std::string format, uint32_t trackId, uint32_t timeScale,
+                               std::vector<Entry> entries) :
+    io_(&io), format_(std::move(format)), trackId_(trackId), timeScale_(timeScale), entries_(std::move(entries)) {
+}
+
+TelemetrySample TelemetryTrack::sample(size_t index) const {
+  const Entry& entry = entries_.at(index);
+  // An IO which is not open is opened for this sample only
+  std::optional<IoCloser> closer;
+  if (!io_->isopen()) {
+    if (io_->open() != 0)
+      throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
+    closer.emplace(*io_);
+  }
+  TelemetrySample sample;
+  sample.time_ = static_cast<double>(entry.time_) / timeScale_;
+  sample.duration_ = static_cast<double>(entry.duration_) / timeScale_;
+  sample.offset_ = entry.offset_;
+  sample.data_.alloc(entry.size_);
+  io_->seek(static_cast<int64_t>(entry.offset_), BasicIo::beg);
+  if (entry.size_ > 0)
+    io_->readOrThrow(sample.data_.data(), entry.size_, ErrorCode::kerCorruptedMetadata);
+  return sample;
+}
+
+TelemetryTrack::const_iterator TelemetryTrack::begin() const {
+  return {this, 0};
+}
+
+TelemetryTrack::const_iterator TelemetryTrack::end() const {
+  return {this, entries_.size()};
+}
+
+TelemetryTrack::const_iterator::const_iterator(const TelemetryTrack* track, size_t index) :
+    track_(track), index_(index) {
+  if (index_ < track_->size())
+    sample_ = track_->sample(index_);
+}
+
+TelemetryTrack::const_iterator& TelemetryTrack::const_iterator::operator++() {
+  ++index_;
+  sample_ = index_ < track_->size() ? track_->sample(index_) : TelemetrySample();
+  return *this;
+}
+
 Image::UniquePtr newQTimeInstance(BasicIo::UniquePtr io, const ImageCtorParams& params) {
   auto image = std::make_unique<QuickTimeVideo>(std::move(io), params);
   if (!image->good()) {
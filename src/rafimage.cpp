@@ -346,7 +346,7 @@ void RafImage::readMetadata() {
     io_->read(tiff.data(), tiff.size());
 
     if (!io_->error() && !io_->eof()) {
-      const DecodeParams dp(max_recursion_depth_);
+      const DecodeParams dp(max_recursion_depth_, lazyMakernotes());
       TiffParser::decode(exifData_, iptcData_, xmpData_, tiff.c_data(), tiff.size(), dp);
     }
   }
@@ -410,7 +410,7 @@ bool RiffVideo::equal(const std::string& str1, const std::string& str2) {
   return Internal::upper(str1) == str2;
 }
 
-void RiffVideo::readList(const HeaderReader& header_) {
+bool RiffVideo::readList(const HeaderReader& header_) {
   std::string chunk_type = readStringTag(io_);
 
 #ifdef EXIV2_DEBUG_MESSAGES
@@ -418,11 +418,15 @@ void RiffVideo::readList(const HeaderReader& header_) {
            << "(" << io_->tell() << "/" << io_->size() << ")" << '\n';
 #endif
 
-  if (equal(chunk_type, CHUNK_ID_INFO))
+  if (equal(chunk_type, CHUNK_ID_INFO)) {
     readInfoListChunk(header_.getSize());
-  else if (equal(chunk_type, CHUNK_ID_MOVI)) {
+    return false;
+  }
+  if (equal(chunk_type, CHUNK_ID_MOVI)) {
     readMoviList(header_.getSize());
+    return false;
   }
+  return true;
 }
 
 void RiffVideo::readChunk(const HeaderReader& header_) {
@@ -465,11 +469,19 @@ void RiffVideo::readChunk(const HeaderReader& header_) {
 
 void RiffVideo::decodeBlocks() {
   do {
-    if (HeaderReader header(io_); equal(header.getId(), CHUNK_ID_LIST)) {
-      readList(header);
+    HeaderReader header(io_);
+    // Chunks are word aligned. Each one is left at its end, whatever its decoder read, so that the
+    // payloads of movi, idx1, indx, JUNK and AVIX are skipped with a single seek.
+    const uint64_t end = io_->tell() + header.getSize() + (header.getSize() & 1);
+    if (equal(header.getId(), CHUNK_ID_LIST)) {
+      if (readList(header))
+        continue;  // The chunks of the list follow
     } else {
       readChunk(header);
     }
+    if (end > io_->size())
+      break;
+    io_->seekOrThrow(end, BasicIo::beg, ErrorCode::kerFailedToReadImageData);
   } while (!io_->eof() && io_->tell() < io_->size());
 }  // RiffVideo::decodeBlock
 
@@ -655,22 +667,26 @@ void RiffVideo::StreamName(uint64_t size_) const {
 }
 
 void RiffVideo::readInfoListChunk(uint64_t size_) {
-  uint64_t current_size = DWORD;
+  // Larger values are skipped rather than read into memory
+  const uint64_t maxValueSize = 1024 * 1024;
+  const uint64_t end = io_->tell() - DWORD + size_;
 
   // Add the elements to a temporary table first, so that we can check
   // for duplicates before adding them to xmpData_.
   std::map<std::string, std::string> table;
-  while (current_size < size_) {
+  while (io_->tell() + DWORD * 2 <= end) {
     std::string type = readStringTag(io_);
-    size_t size = readDWORDTag(io_);
-    std::string content = readStringTag(io_, size);
-    if (auto it = Internal::infoTags.find(type); it != Internal::infoTags.end()) {
+    uint64_t size = readDWORDTag(io_);
+    const uint64_t next = io_->tell() + size + (size & 1);
+    if (auto it = Internal::infoTags.find(type); it != Internal::infoTags.end() && size <= maxValueSize) {
+      std::string content = readStringTag(io_, static_cast<size_t>(size));
       // Check that it isn't a duplicate.
       Internal::enforce(table.find(it->second) == table.end(), ErrorCode::kerCorruptedMetadata);
       table[it->second] = content;
     }
-    current_size += DWORD * 2;
-    current_size += size;
+    if (next > end)
+      break;
+    io_->seekOrThrow(next, BasicIo::beg, ErrorCode::kerFailedToReadImageData);
   }
   // Copy the elements from the temporary table to xmpData_.
   for (const auto& it : table) {
@@ -94,7 +94,7 @@ void Rw2Image::readMetadata() {
     throw Error(ErrorCode::kerNotAnImage, "RW2");
   }
   clearMetadata();
-  const DecodeParams dp(max_recursion_depth_);
+  const DecodeParams dp(max_recursion_depth_, lazyMakernotes());
   ByteOrder bo = Rw2Parser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), io_->size(), dp);
   setByteOrder(bo);
 
@@ -2305,8 +2305,7 @@ constexpr TagInfo SonyMakerNote::tagInfo2010e_[] = {
 };
 
 // https://github.com/Exiv2/exiv2/pull/906#issuecomment-504338797
-static DataBuf sonyTagCipher(uint16_t /* tag */, const byte* bytes, size_t size, const TiffComponent* /*object*/,
-                             bool bDecipher) {
+static DataBuf sonyTagCipher(uint16_t /* tag */, const byte* bytes, size_t size, bool bDecipher) {
   DataBuf b(bytes, size);  // copy the data
 
   // initialize the code table
@@ -2330,11 +2329,11 @@ static DataBuf sonyTagCipher(uint16_t /* tag */, const byte* bytes, size_t size,
   return b;
 }
 
-DataBuf sonyTagDecipher(uint16_t tag, const byte* bytes, size_t size, TiffComponent* object) {
-  return sonyTagCipher(tag, bytes, size, object, true);
+DataBuf sonyTagDecipher(uint16_t tag, const byte* bytes, size_t size, MnContext& /*context*/) {
+  return sonyTagCipher(tag, bytes, size, true);
 }
-DataBuf sonyTagEncipher(uint16_t tag, const byte* bytes, size_t size, TiffComponent* object) {
-  return sonyTagCipher(tag, bytes, size, object, false);
+DataBuf sonyTagEncipher(uint16_t tag, const byte* bytes, size_t size, MnContext& /*context*/) {
+  return sonyTagCipher(tag, bytes, size, false);
 }
 
 }  // namespace Exiv2::Internal
@@ -149,8 +149,8 @@ class SonyMakerNote {
 
 };  // class SonyMakerNote
 
-DataBuf sonyTagDecipher(uint16_t, const byte*, size_t, TiffComponent*);
-DataBuf sonyTagEncipher(uint16_t, const byte*, size_t, TiffComponent*);
+DataBuf sonyTagDecipher(uint16_t, const byte*, size_t, MnContext&);
+DataBuf sonyTagEncipher(uint16_t, const byte*, size_t, MnContext&);
 
 }  // namespace Internal
 }  // namespace Exiv2
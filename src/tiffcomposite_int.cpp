@@ -65,6 +65,25 @@ int IoWrapper::putb(byte data) {
   return io_.putb(data);
 }
 
+size_t IoWrapper::writeImage(const byte* pData, size_t wcount) {
+#ifdef EXV_ENABLE_FILESYSTEM
+  auto file = dynamic_cast<FileIo*>(&io_);
+  auto source = dynamic_cast<const FileIo*>(pSource_);
+  if (file && source) {
+    if (!wroteHeader_ && wcount > 0) {
+      io_.write(pHeader_, size_);
+      wroteHeader_ = true;
+    }
+    return file->write(*source, pData, wcount);
+  }
+#endif
+  return write(pData, wcount);
+}
+
+void IoWrapper::setSource(const BasicIo& source) {
+  pSource_ = &source;
+}
+
 void IoWrapper::setTarget(int id, size_t target) {
   if (target > std::numeric_limits<uint32_t>::max()) {
     throw Error(ErrorCode::kerOffsetOutOfRange);
@@ -374,6 +393,69 @@ size_t ArrayDef::size(uint16_t tag, IfdId group) const {
   return count_ * TypeInfo::typeSize(typeId);
 }
 
+MnContext::MnContext(TiffComponent* pRoot) : pRoot_(pRoot) {
+}
+
+MnContext::~MnContext() = default;
+
+const Value* MnContext::value(uint16_t tag, IfdId group) {
+  auto pos = values_.find({tag, group});
+  if (pos != values_.end()) {
+    ++counters_.cached_;
+    return pos->second.get();
+  }
+  if (pRoot_) {
+    ++counters_.searches_;
+    TiffFinder finder(tag, group);
+    pRoot_->accept(finder);
+    auto te = dynamic_cast<const TiffEntryBase*>(finder.result());
+    // Keep a copy, the encoder may replace the value of the entry
+    if (te && te->pValue())
+      return values_.try_emplace({tag, group}, te->pValue()->clone()).first->second.get();
+  }
+  ++misses_;
+  return nullptr;
+}
+
+std::string MnContext::ifd0String(uint16_t tag) {
+  auto value = this->value(tag, IfdId::ifd0Id);
+  return (!value || value->count() == 0) ? std::string() : value->toString();
+}
+
+std::string MnContext::make() {
+  return ifd0String(0x010f);
+}
+
+std::string MnContext::model() {
+  return ifd0String(0x0110);
+}
+
+std::string MnContext::firmware() {
+  return ifd0String(0x0131);
+}
+
+int MnContext::select(CfgSelFct cfgSelFct, uint16_t tag, const byte* pData, size_t size) {
+  uint32_t version = 0;
+  if (pData)
+    std::memcpy(&version, pData, std::min<size_t>(size, sizeof(version)));
+  const Selection selection{cfgSelFct, tag, size, version};
+  if (auto pos = selections_.find(selection); pos != selections_.end()) {
+    ++counters_.memoized_;
+    return pos->second;
+  }
+  ++counters_.selections_;
+  const auto misses = misses_;
+  const int idx = cfgSelFct(tag, pData, size, *this);
+  if (misses == misses_)
+    selections_.emplace(selection, idx);
+  return idx;
+}
+
+DataBuf MnContext::crypt(CryptFct cryptFct, uint16_t tag, const byte* pData, size_t size) {
+  ++counters_.crypts_;
+  return cryptFct(tag, pData, size, *this);
+}
+
 bool TiffBinaryArray::initialize(IfdId group) {
   if (arrayCfg_)
     return true;  // Not a complex array or already initialized
@@ -389,11 +471,11 @@ bool TiffBinaryArray::initialize(IfdId group) {
   return false;
 }
 
-bool TiffBinaryArray::initialize(TiffComponent* pRoot) {
+bool TiffBinaryArray::initialize(MnContext& context) {
   if (!cfgSelFct_)
     return true;  // Not a complex array
 
-  int idx = cfgSelFct_(tag(), pData(), TiffEntryBase::doSize(), pRoot);
+  int idx = context.select(cfgSelFct_, tag(), pData(), TiffEntryBase::doSize());
   if (idx > -1) {
     arrayCfg_ = &arraySet_[idx].cfg_;
     arrayDef_ = arraySet_[idx].def_;
@@ -1108,7 +1190,8 @@ size_t TiffBinaryArray::doWrite(IoWrapper& ioWrapper, ByteOrder byteOrder, size_
     if (cryptFct == &sonyTagDecipher) {
       cryptFct = sonyTagEncipher;
     }
-    DataBuf buf = cryptFct(tag(), mio.mmap(), mio.size(), pRoot_);
+    MnContext context(pRoot_);
+    DataBuf buf = context.crypt(cryptFct, tag(), mio.mmap(), mio.size());
     if (!buf.empty()) {
       mio.seek(0, Exiv2::BasicIo::beg);
       mio.write(buf.c_data(), buf.size());
@@ -1263,7 +1346,7 @@ size_t TiffImageEntry::doWriteImage(IoWrapper& ioWrapper, ByteOrder /*byteOrder*
 #endif
     len = 0;
     for (auto&& [f, s] : strips_) {
-      ioWrapper.write(f, s);
+      ioWrapper.writeImage(f, s);
       len += s;
       size_t align = s & 1;  // Align strip data to word boundary
       if (align)
@@ -10,8 +10,12 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -135,17 +139,29 @@ class IoWrapper {
     by the data passed in the argument.
    */
   int putb(byte data);
+  /*!
+    @brief Like write(), for image data which points into the memory-mapped
+           area of the source set with setSource().
+
+    If both the IO and the source are files, the data is copied from file
+    to file (see FileIo::write(const FileIo&, const byte*, size_t)) rather
+    than through memory.
+   */
+  size_t writeImage(const byte* pData, size_t wcount);
+  //! Set the IO which the image data passed to writeImage() has been mapped from
+  void setSource(const BasicIo& source);
   //! Wrapper for OffsetWriter::setTarget(), using an int instead of the enum to reduce include deps
   void setTarget(int id, size_t target);
   //@}
 
  private:
   // DATA
-  BasicIo& io_;              //! Reference for the IO instance.
-  const byte* pHeader_;      //! Pointer to the header data.
-  size_t size_;              //! Size of the header data.
-  bool wroteHeader_{false};  //! Indicates if the header has been written.
-  OffsetWriter* pow_;        //! Pointer to an offset-writer, if any, or 0
+  BasicIo& io_;                        //! Reference for the IO instance.
+  const byte* pHeader_;                //! Pointer to the header data.
+  size_t size_;                        //! Size of the header data.
+  bool wroteHeader_{false};            //! Indicates if the header has been written.
+  OffsetWriter* pow_;                  //! Pointer to an offset-writer, if any, or 0
+  const BasicIo* pSource_{nullptr};    //! IO the image data is mapped from, if any, or 0
 };
 
 /*!
@@ -1206,10 +1222,95 @@ class TiffIfdMakernote : public TiffComponent {
   @brief Function pointer type for a function to determine which cfg + def
          of a corresponding array set to use.
  */
-using CfgSelFct = int (*)(uint16_t, const byte*, size_t, TiffComponent*);
+using CfgSelFct = int (*)(uint16_t, const byte*, size_t, MnContext&);
 
 //! Function pointer type for a crypt function used for binary arrays.
-using CryptFct = DataBuf (*)(uint16_t, const byte*, size_t, TiffComponent*);
+using CryptFct = DataBuf (*)(uint16_t, const byte*, size_t, MnContext&);
+
+/*!
+  @brief Access to the TIFF tree for the selector and crypt functions of
+         complex binary arrays, which mostly depend on the camera model and
+         a few makernote tags.
+
+  Values found in the tree are kept for the rest of a reader or encoder
+  pass, rather than being searched for again for each binary array of a
+  makernote. Values which are not found are searched again on the next
+  lookup. The counters show the cost of selecting and en/decrypting the
+  binary arrays of a file.
+
+  Selections are memoized by selector function, tag, size and the first
+  four bytes of the array, which hold the version of the arrays which
+  depend on their data. A selection which looked for a value that was not
+  found is not memoized.
+ */
+class MnContext {
+ public:
+  //! Counters of the work done for the selector and crypt functions
+  struct Counters {
+    size_t selections_{};  //!< Calls to selector functions
+    size_t crypts_{};      //!< Calls to crypt functions
+    size_t searches_{};    //!< Searches of the TIFF tree
+    size_t cached_{};      //!< Lookups answered from values found earlier
+    size_t memoized_{};    //!< Selections answered from earlier selections
+  };
+
+  //! @name Creators
+  //@{
+  //! Constructor, \em pRoot is the root of the TIFF tree to look up values in
+  explicit MnContext(TiffComponent* pRoot);
+  ~MnContext();
+  MnContext(const MnContext&) = delete;
+  MnContext& operator=(const MnContext&) = delete;
+  //@}
+
+  //! @name Manipulators
+  //@{
+  //! Return the value of tag \em tag in group \em group, nullptr if there is none
+  const Value* value(uint16_t tag, IfdId group);
+  //! Return the camera make from tag Exif.Image.Make, empty if there is none
+  std::string make();
+  //! Return the camera model from tag Exif.Image.Model, empty if there is none
+  std::string model();
+  //! Return the firmware version from tag Exif.Image.Software, empty if there is none
+  std::string firmware();
+  //! Select the cfg + def of a binary array with \em cfgSelFct, see CfgSelFct
+  int select(CfgSelFct cfgSelFct, uint16_t tag, const byte* pData, size_t size);
+  //! En/decrypt the data of a binary array with \em cryptFct, see CryptFct
+  DataBuf crypt(CryptFct cryptFct, uint16_t tag, const byte* pData, size_t size);
+  //@}
+
+  //! @name Accessors
+  //@{
+  [[nodiscard]] const Counters& counters() const {
+    return counters_;
+  }
+  //@}
+
+ private:
+  //! Return the value of an Ascii tag in IFD0 as a string, empty if there is none
+  std::string ifd0String(uint16_t tag);
+
+  //! Selector function, tag, size and first four bytes of a binary array
+  struct Selection {
+    CfgSelFct cfgSelFct_;
+    uint16_t tag_;
+    size_t size_;
+    uint32_t version_;
+
+    bool operator<(const Selection& rhs) const {
+      if (cfgSelFct_ != rhs.cfgSelFct_)
+        return std::less<>()(cfgSelFct_, rhs.cfgSelFct_);
+      return std::tie(tag_, size_, version_) < std::tie(rhs.tag_, rhs.size_, rhs.version_);
+    }
+  };
+
+  // DATA
+  TiffComponent* pRoot_;                                                 //!< Root of the TIFF tree
+  std::map<std::pair<uint16_t, IfdId>, std::unique_ptr<Value>> values_;  //!< Values found so far
+  std::map<Selection, int> selections_;                                  //!< Selections made so far
+  size_t misses_{};                                                      //!< Lookups which found nothing
+  Counters counters_;                                                    //!< Counters
+};
 
 //! Defines one tag in a binary array
 struct ArrayDef {
@@ -1298,10 +1399,10 @@ class TiffBinaryArray : public TiffEntryBase {
     This version of initialize() is used for reading and non-intrusive writing. It
     calls cfgSelFct_ to determine the correct settings.
 
-    @param pRoot Pointer to the root component of the TIFF tree.
+    @param context Access to the TIFF tree for the selector function.
     @return true if the initialization succeeded, else false.
    */
-  bool initialize(TiffComponent* pRoot);
+  bool initialize(MnContext& context);
   //! Initialize the original data buffer and its size from the base entry.
   void iniOrigDataBuf();
   //! Update the original data buffer and its size, return true if successful.
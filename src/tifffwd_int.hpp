@@ -35,6 +35,7 @@ class TiffBinaryElement;
 
 class TiffIfdMakernote;
 class MnHeader;
+class MnContext;
 
 class TiffVisitor;
 class TiffFinder;
@@ -147,7 +147,7 @@ void TiffImage::readMetadata() {
   }
   clearMetadata();
 
-  const DecodeParams dp(max_recursion_depth_);
+  const DecodeParams dp(max_recursion_depth_, lazyMakernotes());
   ByteOrder bo = TiffParser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), io_->size(), dp);
   setByteOrder(bo);
 
@@ -230,7 +230,7 @@ WriteMethod TiffParser::encode(BasicIo& io, const byte* pData, size_t size, Byte
 #ifdef EXIV2_DEBUG_MESSAGES
     std::cerr << "Warning: Exif IFD " << filteredIfd << " not encoded\n";
 #endif
-    exifData.erase(std::remove_if(exifData.begin(), exifData.end(), FindExifdatum(filteredIfd)), exifData.end());
+    exifData.eraseIfd(filteredIfd);
   }
 
   TiffHeader header(byteOrder);
@@ -17,6 +17,7 @@
 #include "tags_int.hpp"
 #endif
 
+#include <algorithm>
 #include <array>
 #include <iostream>
 
@@ -998,7 +999,7 @@ constexpr ArrayCfg sony2FpCfg = {
     IfdId::sony2FpId,  // Group for the elements
     bigEndian,         // Big endian
     ttUnsignedByte,    // Type for array entry and size element
-    sonyTagDecipher,   // (uint16_t, const byte*, uint32_t, TiffComponent* const);
+    sonyTagDecipher,   // (uint16_t, const byte*, size_t, MnContext&);
     false,             // No size element
     false,             // No fillers
     false,             // Don't concatenate gaps
@@ -1020,7 +1021,7 @@ constexpr ArrayCfg sonyMisc1Cfg = {
     IfdId::sonyMisc1Id,  // Group for the elements
     bigEndian,           // Big endian
     ttUnsignedByte,      // Type for array entry and size element
-    sonyTagDecipher,     // (uint16_t, const byte*, uint32_t, TiffComponent* const);
+    sonyTagDecipher,     // (uint16_t, const byte*, size_t, MnContext&);
     false,               // No size element
     false,               // No fillers
     false,               // Don't concatenate gaps
@@ -1035,7 +1036,7 @@ constexpr ArrayCfg sonyMisc2bCfg = {
     IfdId::sonyMisc2bId,  // Group for the elements
     littleEndian,         // Little endian
     ttUnsignedByte,       // Type for array entry and size element
-    sonyTagDecipher,      // (uint16_t, const byte*, uint32_t, TiffComponent* const);
+    sonyTagDecipher,      // (uint16_t, const byte*, size_t, MnContext&);
     false,                // No size element
     false,                // No fillers
     false,                // Don't concatenate gaps
@@ -1058,7 +1059,7 @@ constexpr ArrayCfg sonyMisc3cCfg = {
     IfdId::sonyMisc3cId,  // Group for the elements
     littleEndian,         // Little endian
     ttUnsignedByte,       // Type for array entry and size element
-    sonyTagDecipher,      // (uint16_t, const byte*, uint32_t, TiffComponent* const);
+    sonyTagDecipher,      // (uint16_t, const byte*, size_t, MnContext&);
     false,                // No size element
     false,                // No fillers
     false,                // Don't concatenate gaps
@@ -1087,7 +1088,7 @@ constexpr ArrayCfg sonySInfo1Cfg = {
     IfdId::sonySInfo1Id,  // Group for the elements
     littleEndian,         // Little endian
     ttUnsignedByte,       // Type for array entry and size element
-    notEncrypted,         // (uint16_t, const byte*, uint32_t, TiffComponent* const);
+    notEncrypted,         // (uint16_t, const byte*, size_t, MnContext&);
     false,                // No size element
     false,                // No fillers
     false,                // Don't concatenate gaps
@@ -1106,7 +1107,7 @@ constexpr ArrayCfg sony2010eCfg = {
     IfdId::sony2010eId,  // Group for the elements
     invalidByteOrder,    // inherit from file.  Usually littleEndian
     ttUnsignedByte,      // Type for array entry and size element
-    sonyTagDecipher,     // (uint16_t, const byte*, uint32_t, TiffComponent* const);
+    sonyTagDecipher,     // (uint16_t, const byte*, size_t, MnContext&);
     false,               // No size element
     false,               // No fillers
     false,               // Don't concatenate gaps
@@ -1271,6 +1272,69 @@ constexpr ArrayDef samsungPwDef[] = {
     {8, ttUnsignedShort, 1},  // Contrast
 };
 
+/*!
+  @brief Compile-time index of a table of rows keyed by (extended tag, group),
+         used for the TIFF tree and group tables.
+
+  The rows are sorted by group and tag, so that the rows of each group form a
+  contiguous slice which is located in O(1) from the group id. Within a slice
+  the tag is found by binary search. Of rows with the same key, the first one
+  in the source table wins.
+ */
+template <typename T, size_t N>
+class TiffGroupIndex {
+ public:
+  //! Number of groups, including IfdId::ignoreId
+  static constexpr size_t groups_ = static_cast<size_t>(IfdId::lastId) + 1;
+
+  //! Constructor, builds the index from \em table.
+  constexpr explicit TiffGroupIndex(const T (&table)[N]) {
+    std::array<size_t, N> order{};
+    for (size_t i = 0; i < N; ++i)
+      order[i] = i;
+    std::sort(order.begin(), order.end(), [&table](size_t a, size_t b) {
+      const auto& ka = table[a].key_;
+      const auto& kb = table[b].key_;
+      if (ka.second != kb.second)
+        return ka.second < kb.second;
+      if (ka.first != kb.first)
+        return ka.first < kb.first;
+      return a < b;
+    });
+    for (auto i : order) {
+      if (size_ > 0 && rows_[size_ - 1].key_ == table[i].key_)
+        continue;
+      rows_[size_++] = table[i];
+    }
+    size_t row = 0;
+    for (size_t g = 0; g < groups_; ++g) {
+      begin_[g] = row;
+      while (row < size_ && static_cast<size_t>(rows_[row].key_.second) == g)
+        ++row;
+    }
+    begin_[groups_] = row;
+  }
+
+  //! Return a pointer to the row for \em extendedTag and \em group or nullptr if there is none.
+  [[nodiscard]] constexpr const T* find(uint32_t extendedTag, IfdId group) const {
+    const auto g = static_cast<size_t>(group);
+    if (g >= groups_)
+      return nullptr;
+    auto first = rows_.begin() + begin_[g];
+    auto last = rows_.begin() + begin_[g + 1];
+    auto it = std::lower_bound(first, last, extendedTag,
+                               [](const T& row, uint32_t tag) { return row.key_.first < tag; });
+    if (it == last || it->key_.first != extendedTag)
+      return nullptr;
+    return &*it;
+  }
+
+ private:
+  std::array<T, N> rows_{};                   //!< Sorted rows without duplicates
+  size_t size_{};                             //!< Number of rows used
+  std::array<size_t, groups_ + 1> begin_{};  //!< Rows of group g are [begin_[g], begin_[g + 1])
+};
+
 /*
   This table lists for each group in a tree, its parent group and tag.
   Root identifies the root of a TIFF tree, as there is a need for multiple
@@ -1280,7 +1344,7 @@ constexpr ArrayDef samsungPwDef[] = {
   With this table, it is possible, for a given group (and tag) to find a
   path, i.e., a list of groups and tags, from the root to that group (tag).
 */
-const TiffTreeTable TiffCreator::tiffTreeTable_ = {
+constexpr TiffTreeStruct tiffTreeTable[] = {
     // root      group             parent group      parent tag
     //---------  ----------------- ----------------- ----------
     {{Tag::root, IfdId::ifdIdNotSet}, {IfdId::ifdIdNotSet, Tag::root}},
@@ -1431,7 +1495,7 @@ const TiffTreeTable TiffCreator::tiffTreeTable_ = {
   the corresponding TIFF component create function.
  */
 #define ignoreTiffComponent nullptr
-const TiffGroupTable TiffCreator::tiffGroupTable_ = {
+constexpr TiffGroupStruct tiffGroupTable[] = {
     // ext. tag  group             create function
     //---------  ----------------- -----------------------------------------
     // Root directory
@@ -1979,8 +2043,13 @@ const TiffGroupTable TiffCreator::tiffGroupTable_ = {
     {{Tag::all, IfdId::ignoreId}, &newTiffEntry},
 };
 
+//! Index of the TIFF tree table by root and group
+constexpr TiffGroupIndex tiffTreeIndex(tiffTreeTable);
+//! Index of the TIFF group table by extended tag and group
+constexpr TiffGroupIndex tiffGroupIndex(tiffGroupTable);
+
 // TIFF mapping table for special decoding and encoding requirements
-const TiffMappingInfo TiffMapping::tiffMappingInfo_[] = {
+constexpr TiffMappingInfo tiffMappingInfo[] = {
     {"*", Tag::all, IfdId::ignoreId, nullptr, nullptr},  // Do not decode tags with group == IfdId::ignoreId
     {"*", 0x02bc, IfdId::ifd0Id, &TiffDecoder::decodeXmp, nullptr /*done before the tree is traversed*/},
     {"*", 0x83bb, IfdId::ifd0Id, &TiffDecoder::decodeIptc, nullptr /*done before the tree is traversed*/},
@@ -1988,9 +2057,25 @@ const TiffMappingInfo TiffMapping::tiffMappingInfo_[] = {
     {"*", 0x0026, IfdId::canonId, &TiffDecoder::decodeCanonAFInfo, nullptr /* Exiv2.Canon.AFInfo is read-only */},
 };
 
+//! Groups with at least one entry in the TIFF mapping table, all others use the default functions
+constexpr auto tiffMappingGroups = [] {
+  std::array<bool, static_cast<size_t>(IfdId::lastId) + 1> groups{};
+  for (auto&& tmi : tiffMappingInfo)
+    groups[static_cast<size_t>(tmi.group_)] = true;
+  return groups;
+}();
+
+//! Return the TIFF mapping table entry for a key, nullptr if there is none.
+static const TiffMappingInfo* findMappingInfo(std::string_view make, uint32_t extendedTag, IfdId group) {
+  const auto g = static_cast<size_t>(group);
+  if (g >= tiffMappingGroups.size() || !tiffMappingGroups[g])
+    return nullptr;
+  return Exiv2::find(tiffMappingInfo, TiffMappingInfo::Key{make, extendedTag, group});
+}
+
 DecoderFct TiffMapping::findDecoder(std::string_view make, uint32_t extendedTag, IfdId group) {
   DecoderFct decoderFct = &TiffDecoder::decodeStdTiffEntry;
-  if (auto td = Exiv2::find(tiffMappingInfo_, TiffMappingInfo::Key{make, extendedTag, group})) {
+  if (auto td = findMappingInfo(make, extendedTag, group)) {
     // This may set decoderFct to 0, meaning that the tag should not be decoded
     decoderFct = td->decoderFct_;
   }
@@ -1999,7 +2084,7 @@ DecoderFct TiffMapping::findDecoder(std::string_view make, uint32_t extendedTag,
 
 EncoderFct TiffMapping::findEncoder(std::string_view make, uint32_t extendedTag, IfdId group) {
   EncoderFct encoderFct = nullptr;
-  if (auto td = Exiv2::find(tiffMappingInfo_, TiffMappingInfo::Key{make, extendedTag, group})) {
+  if (auto td = findMappingInfo(make, extendedTag, group)) {
     // Returns 0 if no special encoder function is found
     encoderFct = td->encoderFct_;
   }
@@ -2008,16 +2093,16 @@ EncoderFct TiffMapping::findEncoder(std::string_view make, uint32_t extendedTag,
 
 TiffComponent::UniquePtr TiffCreator::create(uint32_t extendedTag, IfdId group) {
   auto tag = static_cast<uint16_t>(extendedTag);
-  auto i = tiffGroupTable_.find(TiffGroupKey(extendedTag, group));
+  auto i = tiffGroupIndex.find(extendedTag, group);
   // If the lookup failed then try again with Tag::all.
-  if (i == tiffGroupTable_.end()) {
-    i = tiffGroupTable_.find(TiffGroupKey(Tag::all, group));
+  if (!i) {
+    i = tiffGroupIndex.find(Tag::all, group);
   }
-  if (i != tiffGroupTable_.end() && i->second) {
-    return i->second(tag, group);
+  if (i && i->newTiffCompFct_) {
+    return i->newTiffCompFct_(tag, group);
   }
 #ifdef EXIV2_DEBUG_MESSAGES
-  if (i == tiffGroupTable_.end())
+  if (!i)
     std::cerr << "Warning: No TIFF structure entry found for ";
   else
     std::cerr << "Warning: No TIFF component creator found for ";
@@ -2031,11 +2116,11 @@ TiffPath TiffCreator::getPath(uint32_t extendedTag, IfdId group, uint32_t root)
   TiffPath ret;
   while (true) {
     ret.emplace(extendedTag, group);
-    const auto ts = tiffTreeTable_.find(TiffGroupKey(root, group));
-    assert(ts != tiffTreeTable_.end());
-    extendedTag = ts->second.second;
-    group = ts->second.first;
-    if (ts->first == TiffGroupKey(root, IfdId::ifdIdNotSet)) {
+    const auto ts = tiffTreeIndex.find(root, group);
+    assert(ts);
+    extendedTag = ts->parent_.second;
+    group = ts->parent_.first;
+    if (ts->key_ == TiffGroupKey(root, IfdId::ifdIdNotSet)) {
       break;
     }
   }
@@ -2060,6 +2145,7 @@ ByteOrder TiffParserWorker::decode(ExifData& exifData, IptcData& iptcData, XmpDa
 
 }  // TiffParserWorker::decode
 
+
 WriteMethod TiffParserWorker::encode(BasicIo& io, const byte* pData, size_t size, const ExifData& exifData,
                                      const IptcData& iptcData, const XmpData& xmpData, uint32_t root,
                                      FindEncoderFct findEncoderFct, TiffHeaderBase* pHeader,
@@ -2094,13 +2180,15 @@ WriteMethod TiffParserWorker::encode(BasicIo& io, const byte* pData, size_t size
     encoder.add(createdTree.get(), std::move(parsedTree), root);
     // Write binary representation from the composite tree
     DataBuf header = pHeader->write();
-    auto tempIo = MemIo();
-    IoWrapper ioWrapper(tempIo, header.c_data(), header.size(), pOffsetWriter);
+    auto tempIo = createTemporary(io);
+    IoWrapper ioWrapper(*tempIo, header.c_data(), header.size(), pOffsetWriter);
+    // Strips point into pData, which is usually the mapped area of io
+    ioWrapper.setSource(io);
     auto imageIdx(std::string::npos);
     createdTree->write(ioWrapper, pHeader->byteOrder(), header.size(), std::string::npos, std::string::npos, imageIdx);
     if (pOffsetWriter)
-      pOffsetWriter->writeOffsets(tempIo);
-    io.transfer(tempIo);  // may throw
+      pOffsetWriter->writeOffsets(*tempIo);
+    io.transfer(*tempIo);  // may throw
 #ifndef SUPPRESS_WARNINGS
     EXV_INFO << "Write strategy: Intrusive\n";
 #endif
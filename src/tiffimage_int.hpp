@@ -14,7 +14,6 @@
 #include <map>
 #include <memory>
 #include <string_view>
-#include <unordered_map>
 #include <utility>
 
 // *****************************************************************************
@@ -143,21 +142,18 @@ class TiffHeader : public TiffHeaderBase {
 };
 
 /*!
-  @brief Data structure used to list image tags for TIFF and TIFF-like images.
+  @brief Key of the TIFF group and tree tables: (extended) tag and group.
  */
 using TiffGroupKey = std::pair<uint32_t, IfdId>;
 
-struct TiffGroupKey_hash {
-  std::size_t operator()(TiffGroupKey pair) const noexcept {
-    return std::hash<uint64_t>{}(static_cast<uint64_t>(pair.first) << 32 | static_cast<uint64_t>(pair.second));
-  }
-};
-
 /*!
   @brief Data structure used as a row (element) of a table (array)
          defining the TIFF component used for each tag in a group.
  */
-using TiffGroupTable = std::unordered_map<TiffGroupKey, NewTiffCompFct, TiffGroupKey_hash>;
+struct TiffGroupStruct {
+  TiffGroupKey key_;               //!< Extended tag and group
+  NewTiffCompFct newTiffCompFct_;  //!< Function to create the correct TIFF component
+};
 
 /*!
   @brief Data structure used as a row of the table which describes TIFF trees.
@@ -165,7 +161,12 @@ using TiffGroupTable = std::unordered_map<TiffGroupKey, NewTiffCompFct, TiffGrou
          use standard TIFF layout.
 */
 using TiffTreeParent = std::pair<IfdId, uint32_t>;  // Parent group, parent tag
-using TiffTreeTable = std::unordered_map<TiffGroupKey, TiffTreeParent, TiffGroupKey_hash>;
+
+//! Row of the TIFF tree table: (root, group) and the parent of the group in that tree.
+struct TiffTreeStruct {
+  TiffGroupKey key_;       //!< Root tag and group
+  TiffTreeParent parent_;  //!< Parent group and parent tag
+};
 
 /*!
   @brief TIFF component factory.
@@ -185,10 +186,6 @@ class TiffCreator {
            \em group.
   */
   static TiffPath getPath(uint32_t extendedTag, IfdId group, uint32_t root);
-
- private:
-  static const TiffTreeTable tiffTreeTable_;    //!< TIFF tree structure
-  static const TiffGroupTable tiffGroupTable_;  //!< TIFF group structure
 };
 
 /*!
@@ -297,9 +294,6 @@ class TiffMapping {
     @return Pointer to the encoder function
    */
   static EncoderFct findEncoder(std::string_view make, uint32_t extendedTag, IfdId group);
-
- private:
-  static const TiffMappingInfo tiffMappingInfo_[];  //!< TIFF mapping table
 };
 
 /*!
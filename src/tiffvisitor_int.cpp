@@ -19,6 +19,7 @@
 #include "value.hpp"
 #include "xmp_exiv2.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <iomanip>
 
@@ -197,7 +198,8 @@ TiffDecoder::TiffDecoder(ExifData& exifData, IptcData& iptcData, XmpData& xmpDat
     xmpData_(xmpData),
     pRoot_(pRoot),
     findDecoderFct_(findDecoderFct),
-    max_recursion_depth_(dp.max_recursion_depth()) {
+    max_recursion_depth_(dp.max_recursion_depth()),
+    lazyMakernotes_(dp.lazy_makernotes()) {
   // #1402 Fujifilm RAF. Search for the make
   // Find camera make in existing metadata (read from the JPEG)
   ExifKey key("Exif.Image.Make");
@@ -241,6 +243,28 @@ void TiffDecoder::visitSubIfd(TiffSubIfd* object) {
 void TiffDecoder::visitMnEntry(TiffMnEntry* object) {
   // Always decode binary makernote tag
   decodeTiffEntry(object);
+  if (lazyMakernotes_ && object->mn_ && !exifData_.deferred_)
+    deferMakernote(object);
+}
+
+void TiffDecoder::deferMakernote(TiffMnEntry* object) {
+  // Without its makernote, the entry is not traversed any further
+  std::shared_ptr<TiffIfdMakernote> mn = std::move(object->mn_);
+  exifData_.deferred_ = [mn, tag = object->tag(), group = object->group(), make = make_,
+                         findDecoderFct = findDecoderFct_, depth = max_recursion_depth_](ExifMetadata& md) {
+    ExifData exifData;
+    IptcData iptcData;
+    XmpData xmpData;
+    TiffDecoder decoder(exifData, iptcData, xmpData, mn.get(), findDecoderFct, DecodeParams(depth));
+    decoder.make_ = make;
+    mn->accept(decoder);
+    // Insert the makernote tags right after the binary makernote tag, where an
+    // eager decode would have put them
+    auto pos = std::find_if(md.begin(), md.end(), [=](const auto& e) { return e.tag() == tag && e.ifdId() == group; });
+    if (pos != md.end())
+      ++pos;
+    md.splice(pos, exifData.exifMetadata_);
+  };
 }
 
 void TiffDecoder::visitIfdMakernote(TiffIfdMakernote* object) {
@@ -456,7 +480,8 @@ TiffEncoder::TiffEncoder(ExifData exifData, const IptcData& iptcData, const XmpD
     pPrimaryGroups_(std::move(pPrimaryGroups)),
     byteOrder_(pHeader->byteOrder()),
     origByteOrder_(byteOrder_),
-    findEncoderFct_(findEncoderFct) {
+    findEncoderFct_(findEncoderFct),
+    mnContext_(pRoot) {
   encodeIptc();
   encodeXmp();
 
@@ -618,6 +643,15 @@ void TiffEncoder::visitMnEntry(TiffMnEntry* object) {
   // Test is required here as well as in the callback encoder function
   if (!object->mn_) {
     encodeTiffComponent(object);
+  } else if (exifData_.deferred_) {
+    // The makernote was never expanded, so none of its tags changed. Leave
+    // its bytes as they are and don't traverse it.
+    exifData_.deferred_ = nullptr;
+    object->mn_ = nullptr;
+    ExifKey key(object->tag(), groupName(object->group()));
+    auto pos = exifData_.findKey(key);
+    if (pos != exifData_.end())
+      exifData_.erase(pos);
   } else if (del_) {
     // The makernote is made up of decoded tags, delete binary tag
     ExifKey key(object->tag(), groupName(object->group()));
@@ -670,7 +704,7 @@ void TiffEncoder::visitBinaryArrayEnd(TiffBinaryArray* object) {
   size_t size = object->TiffEntryBase::doSize();
   if (size == 0)
     return;
-  if (!object->initialize(pRoot_))
+  if (!object->initialize(mnContext_))
     return;
 
   // Re-encrypt buffer if necessary
@@ -680,7 +714,7 @@ void TiffEncoder::visitBinaryArrayEnd(TiffBinaryArray* object) {
   }
   if (cryptFct) {
     const byte* pData = object->pData();
-    DataBuf buf = cryptFct(object->tag(), pData, size, pRoot_);
+    DataBuf buf = mnContext_.crypt(cryptFct, object->tag(), pData, size);
     if (!buf.empty()) {
       pData = buf.c_data();
       size = buf.size();
@@ -976,7 +1010,14 @@ void TiffEncoder::add(TiffComponent* pRootDir, TiffComponent::UniquePtr pSourceD
 }  // TiffEncoder::add
 
 TiffReader::TiffReader(const byte* pData, size_t size, TiffComponent* pRoot, TiffRwState state) :
-    pData_(pData), size_(size), pLast_(pData + size), pRoot_(pRoot), origState_(state), mnState_(state) {
+    pData_(pData),
+    size_(size),
+    pLast_(pData + size),
+    pRoot_(pRoot),
+    origState_(state),
+    mnState_(state),
+    maxBytes_(size > minBytes_ / bytesPerBufferByte_ ? size * bytesPerBufferByte_ : minBytes_),
+    mnContext_(pRoot) {
   pState_ = &origState_;
 
 }  // TiffReader::TiffReader
@@ -1053,6 +1094,19 @@ int TiffReader::nextIdx(IfdId group) {
   return ++idxSeq_[group];
 }
 
+bool TiffReader::consumeBytes(size_t size) {
+  if (size > maxBytes_ - bytes_)
+    return false;
+  bytes_ += size;
+  return true;
+}
+
+bool TiffReader::DirItemGreater::operator()(const DirItem& lhs, const DirItem& rhs) const {
+  if (lhs.dir_->start() != rhs.dir_->start())
+    return lhs.dir_->start() > rhs.dir_->start();
+  return lhs.seq_ > rhs.seq_;
+}
+
 void TiffReader::postProcess() {
   setMnState();  // All components to be post-processed must be from the Makernote
   postProc_ = true;
@@ -1064,6 +1118,39 @@ void TiffReader::postProcess() {
 }
 
 void TiffReader::visitDirectory(TiffDirectory* object) {
+  if (!pFirst_) {
+    pFirst_ = object;
+  } else if (object != pCurrent_) {
+    // Remember the state for the directory and read it at the end of the first one
+    dirQueue_.push({object, *pState_, pState_ == &mnState_, dirSeq_++});
+    return;
+  }
+  pCurrent_ = object;
+  readDirectory(object);
+}
+
+void TiffReader::visitDirectoryEnd(TiffDirectory* object) {
+  if (object != pFirst_)
+    return;
+  // Read the queued directories in the order of their start. Directories found
+  // while reading one of them are queued in turn.
+  while (!dirQueue_.empty()) {
+    auto item = dirQueue_.top();
+    dirQueue_.pop();
+    if (item.mn_) {
+      setMnState(&item.state_);
+    } else {
+      setOrigState();
+    }
+    pCurrent_ = item.dir_;
+    item.dir_->accept(*this);
+  }
+  setOrigState();
+  pCurrent_ = nullptr;
+  pFirst_ = nullptr;
+}
+
+void TiffReader::readDirectory(TiffDirectory* object) {
   const byte* p = object->start();
 
   if (circularReference(object->start(), object->group()))
@@ -1085,6 +1172,14 @@ void TiffReader::visitDirectory(TiffDirectory* object) {
 #endif
     return;
   }
+  if (n > maxEntries_ - entries_ || !consumeBytes(2 + (12 * n))) {
+#ifndef SUPPRESS_WARNINGS
+    EXV_ERROR << "Directory " << groupName(object->group())
+              << ": TIFF structure exceeds the entry or size budget; not read.\n";
+#endif
+    return;
+  }
+  entries_ += n;
   for (uint16_t i = 0; i < n; ++i) {
     if (p + 12 > pLast_) {
 #ifndef SUPPRESS_WARNINGS
@@ -1135,7 +1230,7 @@ void TiffReader::visitDirectory(TiffDirectory* object) {
     }
   }  // object->hasNext()
 
-}  // TiffReader::visitDirectory
+}  // TiffReader::readDirectory
 
 void TiffReader::visitSubIfd(TiffSubIfd* object) {
   readTiffEntry(object);
@@ -1180,11 +1275,7 @@ void TiffReader::visitSubIfd(TiffSubIfd* object) {
 void TiffReader::visitMnEntry(TiffMnEntry* object) {
   readTiffEntry(object);
   // Find camera make
-  TiffFinder finder(0x010f, IfdId::ifd0Id);
-  pRoot_->accept(finder);
-  auto te = dynamic_cast<const TiffEntryBase*>(finder.result());
-  if (te && te->pValue()) {
-    auto make = te->pValue()->toString();
+  if (auto make = mnContext_.make(); !make.empty()) {
     // create concrete makernote, based on make and makernote contents
     object->mn_ =
         TiffMnCreator::create(object->tag(), object->mnGroup_, make, object->pData_, object->size_, byteOrder());
@@ -1312,6 +1403,13 @@ void TiffReader::readTiffEntry(TiffEntryBase* object) {
         size = 0;
       }
     }
+    if (size > 4 && !consumeBytes(size)) {
+#ifndef SUPPRESS_WARNINGS
+      EXV_ERROR << "Directory " << groupName(object->group()) << ", entry 0x" << std::setw(4) << std::setfill('0')
+                << std::hex << object->tag() << " exceeds the size budget of the TIFF structure; truncating the entry\n";
+#endif
+      size = 0;
+    }
     auto v = Value::create(typeId);
     enforce(v != nullptr, ErrorCode::kerCorruptedMetadata);
     v->read(pData, size, byteOrder());
@@ -1352,7 +1450,7 @@ void TiffReader::visitBinaryArray(TiffBinaryArray* object) {
 
   if (object->TiffEntryBase::doSize() == 0)
     return;
-  if (!object->initialize(pRoot_))
+  if (!object->initialize(mnContext_))
     return;
   const ArrayCfg* cfg = object->cfg();
   if (!cfg)
@@ -1361,7 +1459,7 @@ void TiffReader::visitBinaryArray(TiffBinaryArray* object) {
   if (auto cryptFct = cfg->cryptFct_) {
     const byte* pData = object->pData();
     size_t size = object->TiffEntryBase::doSize();
-    auto buf = std::make_shared<DataBuf>(cryptFct(object->tag(), pData, size, pRoot_));
+    auto buf = std::make_shared<DataBuf>(mnContext_.crypt(cryptFct, object->tag(), pData, size));
     if (!buf->empty())
       object->setData(std::move(buf));
   }
@@ -13,6 +13,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <map>
+#include <queue>
 #include <string>
 #include <vector>
 
@@ -308,6 +309,11 @@ class TiffDecoder : public TiffVisitor {
     element is found the function leaves both of these parameters unchanged.
   */
   void getObjData(const byte*& pData, size_t& size, uint16_t tag, IfdId group, const TiffEntryBase* object);
+  /*!
+    @brief Take the makernote out of \em object and leave it to the Exif
+           data container to decode it when it is first needed.
+   */
+  void deferMakernote(TiffMnEntry* object);
   //@}
 
   // DATA
@@ -317,6 +323,7 @@ class TiffDecoder : public TiffVisitor {
   TiffComponent* pRoot_;              //!< Root element of the composite
   FindDecoderFct findDecoderFct_;     //!< Ptr to the function to find special decoding functions
   const size_t max_recursion_depth_;  //!< don't allow recursion deeper than this
+  const bool lazyMakernotes_;         //!< Defer decoding the makernote, see DecodeParams
   std::string make_;                  //!< Camera make, determined from the tags to decode
   bool decodedIptc_{false};           //!< Indicates if IPTC has been decoded yet
 
@@ -521,6 +528,7 @@ class TiffEncoder : public TiffVisitor {
   std::string make_;                         //!< Camera make, determined from the tags to encode
   bool dirty_{false};                        //!< Signals if any tag is deleted or allocated
   WriteMethod writeMethod_{wmNonIntrusive};  //!< Write method used.
+  MnContext mnContext_;                      //!< Tree access for binary array selector and crypt functions
 
 };  // class TiffEncoder
 
@@ -573,6 +581,15 @@ class TiffRwState {
   @brief TIFF composite visitor to read the TIFF structure from a block of
          memory and build the composite from it (Visitor pattern). Used by
          TiffParser to read the TIFF data from a block of memory.
+
+  Only the directory the reader is first called with is read while it is
+  visited. All other directories found while reading (sub-IFDs, next IFDs and
+  makernote IFDs) are put on a queue, together with the reader state in
+  effect for them, and read in ascending order of their offset at the end of
+  that first directory. The depth of the call stack therefore doesn't grow
+  with the nesting of the TIFF structure and the data is accessed mostly
+  sequentially. The number of entries and the number of bytes read from the
+  buffer are limited by a global budget.
  */
 class TiffReader : public TiffVisitor {
  public:
@@ -600,8 +617,10 @@ class TiffReader : public TiffVisitor {
   void visitImageEntry(TiffImageEntry* object) override;
   //! Read a TIFF size entry from the data buffer
   void visitSizeEntry(TiffSizeEntry* object) override;
-  //! Read a TIFF directory from the data buffer
+  //! Read a TIFF directory from the data buffer or queue it for reading
   void visitDirectory(TiffDirectory* object) override;
+  //! Read all queued directories at the end of the first directory
+  void visitDirectoryEnd(TiffDirectory* object) override;
   //! Read a TIFF sub-IFD from the data buffer
   void visitSubIfd(TiffSubIfd* object) override;
   //! Read a TIFF makernote entry from the data buffer
@@ -632,6 +651,11 @@ class TiffReader : public TiffVisitor {
   bool circularReference(const byte* start, IfdId group);
   //! Return the next idx sequence number for \em group
   int nextIdx(IfdId group);
+  /*!
+    @brief Charge \em size bytes against the byte budget of the reader.
+           Return false if the budget is exhausted.
+   */
+  bool consumeBytes(size_t size);
 
   /*!
     @brief Read deferred components.
@@ -651,25 +675,59 @@ class TiffReader : public TiffVisitor {
   [[nodiscard]] ByteOrder byteOrder() const;
   //! Return the base offset. See class TiffRwState for details
   [[nodiscard]] size_t baseOffset() const;
+  //! Return the tree access used by binary array selector and crypt functions, with its counters
+  [[nodiscard]] const MnContext& mnContext() const {
+    return mnContext_;
+  }
   //@}
 
+  //! Maximum number of IFD entries read from one TIFF structure
+  static constexpr size_t maxEntries_ = 65536;
+  //! Byte budget per byte of the data buffer, see consumeBytes()
+  static constexpr size_t bytesPerBufferByte_ = 4;
+  //! Minimum byte budget, for small buffers
+  static constexpr size_t minBytes_ = 64 * 1024 * 1024;
+
  private:
+  //! A directory waiting to be read, with the state to read it
+  struct DirItem {
+    TiffDirectory* dir_;  //!< Directory to read
+    TiffRwState state_;   //!< Byte order and base offset for the directory
+    bool mn_;             //!< True if state_ is a makernote state
+    size_t seq_;          //!< Sequence number, to keep the order of directories with the same start
+  };
+  //! Orders directories by ascending start address
+  struct DirItemGreater {
+    bool operator()(const DirItem& lhs, const DirItem& rhs) const;
+  };
   using DirList = std::map<const byte*, IfdId>;
   using IdxSeq = std::map<IfdId, int>;
   using PostList = std::vector<TiffComponent*>;
+  using DirQueue = std::priority_queue<DirItem, std::vector<DirItem>, DirItemGreater>;
+
+  //! Read the entries and next pointer of a TIFF directory
+  void readDirectory(TiffDirectory* object);
 
   // DATA
-  const byte* pData_;      //!< Pointer to the memory buffer
-  size_t size_;            //!< Size of the buffer
-  const byte* pLast_;      //!< Pointer to the last byte
-  TiffComponent* pRoot_;   //!< Root element of the composite
-  TiffRwState* pState_;    //!< Pointer to the state in effect (origState_ or mnState_)
-  TiffRwState origState_;  //!< State class as set in the c'tor
-  TiffRwState mnState_;    //!< State class as set in the c'tor or by setMnState()
-  DirList dirList_;        //!< List of IFD pointers and their groups
-  IdxSeq idxSeq_;          //!< Sequences for group, used for the entry's idx
-  PostList postList_;      //!< List of components with deferred reading
-  bool postProc_{false};   //!< True in postProcessList()
+  const byte* pData_;          //!< Pointer to the memory buffer
+  size_t size_;                //!< Size of the buffer
+  const byte* pLast_;          //!< Pointer to the last byte
+  TiffComponent* pRoot_;       //!< Root element of the composite
+  TiffRwState* pState_;        //!< Pointer to the state in effect (origState_ or mnState_)
+  TiffRwState origState_;      //!< State class as set in the c'tor
+  TiffRwState mnState_;        //!< State class as set in the c'tor or by setMnState()
+  DirList dirList_;            //!< List of IFD pointers and their groups
+  IdxSeq idxSeq_;              //!< Sequences for group, used for the entry's idx
+  PostList postList_;          //!< List of components with deferred reading
+  bool postProc_{false};       //!< True in postProcessList()
+  DirQueue dirQueue_;          //!< Directories waiting to be read
+  TiffDirectory* pFirst_{};    //!< First directory visited, reads the queue when it ends
+  TiffDirectory* pCurrent_{};  //!< Directory which is being read
+  size_t dirSeq_{};            //!< Number of directories queued so far
+  size_t entries_{};           //!< Number of IFD entries read so far
+  size_t bytes_{};             //!< Number of bytes read so far
+  size_t maxBytes_;            //!< Byte budget
+  MnContext mnContext_;        //!< Tree access for binary array selector and crypt functions
 };
 
 }  // namespace Internal
@@ -660,7 +660,7 @@ void WebPImage::decodeChunks(uint32_t filesize) {
 
       if (pos != std::string::npos) {
         XmpData xmpData;
-        const DecodeParams dp(max_recursion_depth_);
+        const DecodeParams dp(max_recursion_depth_, lazyMakernotes());
         ByteOrder bo = ExifParser::decode(exifData_, payload.c_data(pos), payload.size() - pos, dp);
         setByteOrder(bo);
       } else {
@@ -12,16 +12,24 @@
 
 // + standard includes
 #include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <mutex>
+#include <shared_mutex>
+#include <string_view>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 // Adobe XMP Toolkit
 #ifdef EXV_HAVE_XMP_TOOLKIT
-#include <expat.h>
 #include "utils.hpp"
 #define TXMP_STRING_TYPE std::string
 #include "xmp_lifecycle.hpp"
+#include <expat.h>
 #ifdef EXV_ADOBE_XMPSDK
 #include <XMP.hpp>
 #else
@@ -30,12 +38,14 @@
 #include <XMP.incl_cpp>
 #endif  // EXV_HAVE_XMP_TOOLKIT
 
-#ifdef EXV_HAVE_XMP_TOOLKIT
+#ifdef EXV_ADOBE_XMPSDK
 // This anonymous namespace contains a class named XMLValidator, which uses
 // libexpat to do a basic validation check on an XML document. This is to
 // reduce the chance of hitting a bug in the (third-party) xmpsdk
 // library. For example, it is easy to a trigger a stack overflow in xmpsdk
-// with a deeply nested tree.
+// with a deeply nested tree. The bundled xmpsdk makes the same checks in
+// its own expat pass, so only a build with the Adobe XMP SDK needs a
+// separate one.
 namespace {
 using namespace Exiv2;
 
@@ -185,6 +195,1062 @@ class XMLValidator {
   }
 };
 }  // namespace
+#endif  // EXV_ADOBE_XMPSDK
+
+#ifdef EXV_HAVE_XMP_TOOLKIT
+// This anonymous namespace contains the native fast path of XmpParser. NativeXmpReader goes
+// straight from expat events to the properties of a packet, NativeXmpWriter serializes XmpData
+// in the compact RDF of the toolkit without an SXMPMeta. Both only handle packets of simple,
+// struct and array properties, the forms cameras and most editors write. Anything else, such as
+// qualifiers, aliases, rdf:resource, namespaces the toolkit does not know yet or the properties
+// the toolkit touches up after parsing, makes them give up, and the caller falls back to the
+// toolkit. They produce exactly what the toolkit does.
+namespace {
+using namespace Exiv2;
+
+//! Return true if text is XML white space only
+bool isXmlWhitespace(std::string_view text) {
+  return std::all_of(text.begin(), text.end(), [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; });
+}
+
+//! Normalize an RFC 3066 language tag like the toolkit: lower case, but a second subtag of two letters is upper case
+void normalizeLang(std::string& lang) {
+  size_t start = 0;
+  for (int subtag = 0; start <= lang.size(); ++subtag) {
+    const auto end = std::min(lang.find('-', start), lang.size());
+    const bool upper = subtag == 1 && end - start == 2;
+    for (size_t i = start; i < end; ++i) {
+      if (upper && 'a' <= lang[i] && lang[i] <= 'z')
+        lang[i] -= 0x20;
+      else if (!upper && 'A' <= lang[i] && lang[i] <= 'Z')
+        lang[i] += 0x20;
+    }
+    start = end + 1;
+  }
+}
+
+/*!
+  @brief Return true if the toolkit parses the packet as it is. Before parsing, it replaces
+         ASCII controls, bytes that are not UTF-8 and hexadecimal character references of
+         up to two digits with spaces, and it converts UTF-16 and UTF-32 packets.
+ */
+bool isPlainUtf8(const char* buf, size_t len) {
+  const auto p = reinterpret_cast<const unsigned char*>(buf);
+  if (len < 2 || p[0] == 0 || p[0] == 0xFE || p[0] == 0xFF || p[1] == 0)
+    return false;
+  for (size_t i = 0; i < len; ++i) {
+    const auto c = p[i];
+    if (c >= 0x80) {
+      if ((c & 0xC0) != 0xC0)
+        return false;
+      size_t count = 2;
+      for (auto b = static_cast<unsigned char>(c << 2); b & 0x80; b <<= 1)
+        ++count;
+      if (count > len - i)
+        return false;
+      for (size_t k = 1; k < count; ++k) {
+        if ((p[i + k] & 0xC0) != 0x80)
+          return false;
+      }
+      i += count - 1;
+    } else if ((c < 0x20 && c != '\t' && c != '\n' && c != '\r') || c == 0x7F) {
+      return false;
+    } else if (c == '&' && len - i >= 5 && std::memcmp(p + i, "&#x", 3) == 0) {
+      size_t pos = i + 3;
+      unsigned value = 0;
+      for (size_t digits = 0; digits < 2 && pos < len && std::isxdigit(p[pos]); ++digits, ++pos)
+        value = value * 16 + (std::isdigit(p[pos]) ? p[pos] - '0' : (p[pos] | 0x20) - 'a' + 10);
+      if (pos < len && p[pos] == ';' && pos > i + 3 && value != '\t' && value != '\n' && value != '\r')
+        return false;
+    }
+  }
+  return true;
+}
+
+//! A property of a packet, a tree like the one of the toolkit
+struct NativeXmpNode {
+  enum Form { simple, structure, array };
+  std::string name;                  //!< Qualified name, empty for an array item
+  std::string value;                 //!< Value of a simple property
+  std::string lang;                  //!< Language of an item of an alternative array
+  bool hasLang = false;              //!< True if lang is set
+  Form form = simple;                //!< Form of the property
+  TypeId arrayType = invalidTypeId;  //!< xmpBag, xmpSeq or xmpAlt for an array
+  bool altText = false;              //!< True for an alternative array of languages
+  std::vector<NativeXmpNode> children;
+};
+
+/*!
+  @brief Reads the properties of a packet with a single expat pass. The callbacks never
+         throw, they record that the packet needs the toolkit and stop the parser.
+ */
+class NativeXmpReader {
+ public:
+  //! A property as the toolkit's iterator reports it
+  struct Property {
+    size_t schema;  //!< Index of the namespace in schemas()
+    std::string path;
+    Value::UniquePtr value;
+  };
+
+  explicit NativeXmpReader(size_t maxDepth) : maxDepth_(maxDepth), parser_(XML_ParserCreateNS(nullptr, '@')) {
+  }
+
+  ~NativeXmpReader() {
+    if (parser_)
+      XML_ParserFree(parser_);
+  }
+
+  NativeXmpReader(const NativeXmpReader&) = delete;
+  NativeXmpReader& operator=(const NativeXmpReader&) = delete;
+
+  //! Read the packet, return false if it needs the toolkit
+  bool read(const char* buf, size_t len) {
+    if (!parser_ || len > static_cast<size_t>(std::numeric_limits<int>::max()) || !isPlainUtf8(buf, len))
+      return false;
+    XML_SetReturnNSTriplet(parser_, 1);
+    XML_SetUserData(parser_, this);
+    XML_SetElementHandler(parser_, startElement_cb, endElement_cb);
+    XML_SetCharacterDataHandler(parser_, characterData_cb);
+    XML_SetNamespaceDeclHandler(parser_, startNamespace_cb, endNamespace_cb);
+    XML_SetProcessingInstructionHandler(parser_, processingInstruction_cb);
+    XML_SetStartDoctypeDeclHandler(parser_, startDTD_cb);
+    stack_.push_back({});
+    if (XML_Parse(parser_, buf, static_cast<int>(len), true) == XML_STATUS_ERROR || failed_ || rdfCount_ != 1 ||
+        !checkToolkit())
+      return false;
+    for (size_t schema = 0; schema < schemas_.size(); ++schema) {
+      uris_.push_back(schemas_[schema].uri);
+      for (const auto& node : schemas_[schema].props)
+        flatten(schema, node, node.name);
+    }
+    return true;
+  }
+
+  //! The namespace URIs of the properties, in the order of the toolkit
+  [[nodiscard]] const std::vector<std::string>& schemas() const {
+    return uris_;
+  }
+
+  //! The properties, in the order of the toolkit
+  std::vector<Property>& properties() {
+    return properties_;
+  }
+
+ private:
+  //! What the content of an element is
+  enum class Context {
+    outside,      //!< Outside of rdf:RDF
+    rdf,          //!< rdf:RDF, top level rdf:Description elements
+    description,  //!< A top level rdf:Description, top level properties
+    fields,       //!< Fields of a struct
+    items,        //!< Items of an array
+    property,     //!< A property element, text or a node element
+    attrStruct,   //!< A struct written as an empty element with property attributes
+  };
+
+  struct Frame {
+    Context context = Context::outside;
+    NativeXmpNode* node = nullptr;  // The property the content belongs to
+    size_t schema = std::string::npos;  // Set for a top level property
+    bool hasNode = false;               // A property element has a node element
+    std::string text;                   // Text of a property element
+  };
+
+  struct Schema {
+    std::string uri;
+    std::vector<NativeXmpNode> props;
+  };
+
+  //! A name as expat reports it with namespace triplets, "URI@local@prefix"
+  struct Name {
+    std::string_view uri;
+    std::string_view local;
+    std::string_view prefix;
+
+    [[nodiscard]] bool is(const char* ns, const char* name) const {
+      return uri == ns && local == name;
+    }
+    [[nodiscard]] bool isSyntax() const {
+      return uri == kXMP_NS_RDF || uri == kXMP_NS_XML;
+    }
+    [[nodiscard]] std::string qualified() const {
+      std::string name(prefix);
+      name += ':';
+      return name.append(local);
+    }
+  };
+
+  //! Split a name, return false if it has no prefix
+  static bool split(const char* fullName, Name& name) {
+    const std::string_view s(fullName);
+    const auto p = s.rfind('@');
+    if (p == std::string_view::npos || p == 0 || p + 1 == s.size())
+      return false;
+    const auto l = s.rfind('@', p - 1);
+    if (l == std::string_view::npos)
+      return false;
+    name = {s.substr(0, l), s.substr(l + 1, p - l - 1), s.substr(p + 1)};
+    return true;
+  }
+
+  void fail() {
+    if (!failed_) {
+      failed_ = true;
+      XML_StopParser(parser_, XML_FALSE);
+    }
+  }
+
+  void push(Context context, NativeXmpNode* node = nullptr, size_t schema = std::string::npos) {
+    Frame frame;
+    frame.context = context;
+    frame.node = node;
+    frame.schema = schema;
+    stack_.push_back(std::move(frame));
+  }
+
+  //! Add a top level property, or return nullptr if the toolkit needs to see it
+  NativeXmpNode* addTop(const Name& name, size_t& schema) {
+    if (name.isSyntax() || name.is("http://ns.adobe.com/iX/1.0/", "changes"))
+      return nullptr;
+    auto qname = name.qualified();
+    if (!topNames_.insert(qname).second)
+      return nullptr;
+    schema = 0;
+    while (schema < schemas_.size() && schemas_[schema].uri != name.uri)
+      ++schema;
+    if (schema == schemas_.size())
+      schemas_.push_back({std::string(name.uri), {}});
+    auto& node = schemas_[schema].props.emplace_back();
+    node.name = std::move(qname);
+    return &node;
+  }
+
+  //! Add a field to a struct, or return nullptr if the toolkit needs to see it
+  static NativeXmpNode* addField(NativeXmpNode& parent, const Name& name) {
+    if (name.isSyntax())
+      return nullptr;
+    auto qname = name.qualified();
+    for (const auto& field : parent.children) {
+      if (field.name == qname)
+        return nullptr;
+    }
+    auto& node = parent.children.emplace_back();
+    node.name = std::move(qname);
+    return &node;
+  }
+
+  //! Add the property attributes of an element as fields of a struct
+  bool addFields(NativeXmpNode& parent, const XML_Char** attrs) {
+    for (auto attr = attrs; *attr; attr += 2) {
+      Name name;
+      NativeXmpNode* field = split(attr[0], name) ? addField(parent, name) : nullptr;
+      if (!field)
+        return false;
+      field->value = attr[1];
+    }
+    return true;
+  }
+
+  //! Return true if the toolkit touches the top level property up after parsing
+  static bool needsTouchUp(const std::string& uri, const NativeXmpNode& node) {
+    const auto local = std::string_view(node.name).substr(node.name.find(':') + 1);
+    if (uri == kXMP_NS_DC) {
+      if (local == "subject")
+        return node.form != NativeXmpNode::array || node.arrayType != xmpBag;
+      if (local == "description" || local == "rights" || local == "title")
+        return !node.altText;
+      return node.form == NativeXmpNode::simple &&
+             (local == "creator" || local == "date" || local == "contributor" || local == "language" ||
+              local == "publisher" || local == "relation" || local == "type");
+    }
+    if (uri == kXMP_NS_XMP_Rights)
+      return local == "UsageTerms" && !node.altText;
+    if (uri == kXMP_NS_EXIF)
+      return local == "GPSTimeStamp" || (local == "UserComment" && !node.altText);
+    return uri == kXMP_NS_DM && local == "copyright";
+  }
+
+  void startElement(const XML_Char* fullName, const XML_Char** attrs) {
+    if (elemDepth_ > maxDepth_)
+      return fail();
+    ++elemDepth_;
+    if (failed_)
+      return;
+    Name name;
+    const bool prefixed = split(fullName, name);
+    Frame& parent = stack_.back();
+    switch (parent.context) {
+      case Context::outside:
+        if (prefixed && name.is(kXMP_NS_RDF, "RDF")) {
+          if (++rdfCount_ > 1 || *attrs)
+            return fail();
+          return push(Context::rdf);
+        }
+        return push(Context::outside);
+      case Context::rdf:
+        if (!prefixed || !name.is(kXMP_NS_RDF, "Description"))
+          return fail();
+        return startDescription(attrs);
+      case Context::description:
+      case Context::fields:
+      case Context::items:
+        if (!prefixed)
+          return fail();
+        return startProperty(parent, name, attrs);
+      case Context::property:
+        if (!prefixed)
+          return fail();
+        return startNode(parent, name, attrs);
+      case Context::attrStruct:
+        return fail();
+    }
+  }
+
+  //! A top level rdf:Description, its attributes are simple properties
+  void startDescription(const XML_Char** attrs) {
+    for (auto attr = attrs; *attr; attr += 2) {
+      Name name;
+      if (!split(attr[0], name))
+        return fail();
+      if (name.is(kXMP_NS_RDF, "about") && !*attr[1])
+        continue;
+      size_t schema = 0;
+      NativeXmpNode* node = addTop(name, schema);
+      if (!node)
+        return fail();
+      node->value = attr[1];
+      if (needsTouchUp(schemas_[schema].uri, *node))
+        return fail();
+    }
+    push(Context::description);
+  }
+
+  //! A property element, a top level property, a field or an array item
+  void startProperty(Frame& parent, const Name& name, const XML_Char** attrs) {
+    NativeXmpNode* node = nullptr;
+    size_t schema = std::string::npos;
+    const bool isItem = parent.context == Context::items;
+    if (isItem) {
+      if (name.is(kXMP_NS_RDF, "li"))
+        node = &parent.node->children.emplace_back();
+    } else if (parent.context == Context::description) {
+      node = addTop(name, schema);
+    } else {
+      node = addField(*parent.node, name);
+    }
+    if (!node)
+      return fail();
+    if (!*attrs)
+      return push(Context::property, node, schema);
+
+    Name attr;
+    if (!split(attrs[0], attr))
+      return fail();
+    if (!attrs[2] && attr.is(kXMP_NS_RDF, "parseType")) {
+      if (std::strcmp(attrs[1], "Resource") != 0)
+        return fail();
+      node->form = NativeXmpNode::structure;
+      return push(Context::fields, node, schema);
+    }
+    if (!attrs[2] && attr.is(kXMP_NS_XML, "lang")) {
+      if (!isItem || parent.node->arrayType != xmpAlt)
+        return fail();
+      node->lang = attrs[1];
+      normalizeLang(node->lang);
+      node->hasLang = true;
+      return push(Context::property, node, schema);
+    }
+    node->form = NativeXmpNode::structure;
+    if (!addFields(*node, attrs))
+      return fail();
+    push(Context::attrStruct, node, schema);
+  }
+
+  //! The node element of a property element, an rdf:Description for a struct or an array
+  void startNode(Frame& parent, const Name& name, const XML_Char** attrs) {
+    NativeXmpNode* node = parent.node;
+    if (parent.hasNode || node->hasLang || !isXmlWhitespace(parent.text) || name.uri != kXMP_NS_RDF)
+      return fail();
+    parent.hasNode = true;
+    parent.text.clear();
+    if (name.local == "Description") {
+      node->form = NativeXmpNode::structure;
+      if (!addFields(*node, attrs))
+        return fail();
+      return push(Context::fields, node);
+    }
+    if (name.local == "Bag")
+      node->arrayType = xmpBag;
+    else if (name.local == "Seq")
+      node->arrayType = xmpSeq;
+    else if (name.local == "Alt")
+      node->arrayType = xmpAlt;
+    if (node->arrayType == invalidTypeId || *attrs)
+      return fail();
+    node->form = NativeXmpNode::array;
+    push(Context::items, node);
+  }
+
+  void endElement() {
+    if (elemDepth_ > 0)
+      --elemDepth_;
+    if (failed_)
+      return;
+    Frame& frame = stack_.back();
+    NativeXmpNode* node = frame.node;
+    if (frame.context == Context::property && !frame.hasNode) {
+      node->value = std::move(frame.text);
+    } else if (frame.context == Context::items && node->arrayType == xmpAlt) {
+      // An alternative array is one of languages if all items have one, and a language is only allowed once
+      std::unordered_set<std::string> langs;
+      for (const auto& item : node->children) {
+        if (item.hasLang && !langs.insert(item.lang).second)
+          return fail();
+      }
+      if (!langs.empty() && langs.size() != node->children.size())
+        return fail();
+      node->altText = !langs.empty();
+    }
+    if (frame.schema != std::string::npos && needsTouchUp(schemas_[frame.schema].uri, *node))
+      return fail();
+    stack_.pop_back();
+  }
+
+  void characterData(const XML_Char* s, int len) {
+    if (failed_)
+      return;
+    Frame& frame = stack_.back();
+    if (frame.context == Context::outside)
+      return;
+    if (frame.context == Context::property && !frame.hasNode) {
+      frame.text.append(s, len);
+      return;
+    }
+    if (frame.context == Context::attrStruct || !isXmlWhitespace({s, static_cast<size_t>(len)}))
+      fail();
+  }
+
+  void startNamespace(const XML_Char* prefix, const XML_Char* uri) {
+    if (nsDepth_ > maxDepth_)
+      return fail();
+    ++nsDepth_;
+    if (!uri)
+      return;
+    // A default namespace, and the early Dublin Core URI the toolkit replaces
+    if (!prefix || std::strcmp(uri, "http://purl.org/dc/1.1/") == 0)
+      return fail();
+    // Each prefix stands for one URI throughout the packet, so that the names are the toolkit's
+    for (const auto& [u, p] : namespaces_) {
+      const bool sameUri = u == uri;
+      if (sameUri && p == prefix)
+        return;
+      if (sameUri || p == prefix)
+        return fail();
+    }
+    namespaces_.emplace_back(uri, prefix);
+  }
+
+  void endNamespace() {
+    if (nsDepth_ > 0)
+      --nsDepth_;
+  }
+
+  void processingInstruction(const XML_Char* target) {
+    // The toolkit keeps xpacket instructions as nodes, which are not allowed in RDF
+    if (stack_.back().context != Context::outside && std::strcmp(target, "xpacket") == 0)
+      fail();
+  }
+
+  //! Return true if the toolkit has the namespaces of the packet and no aliases
+  [[nodiscard]] bool checkToolkit() const {
+    try {
+      std::string s;
+      for (const auto& [uri, prefix] : namespaces_) {
+        if (!SXMPMeta::GetNamespacePrefix(uri.c_str(), &s) || s.size() != prefix.size() + 1 ||
+            s.compare(0, prefix.size(), prefix) != 0)
+          return false;
+        if (!SXMPMeta::GetNamespaceURI(prefix.c_str(), &s) || s != uri)
+          return false;
+      }
+      for (const auto& schema : schemas_) {
+        for (const auto& node : schema.props) {
+          if (SXMPMeta::ResolveAlias(schema.uri.c_str(), node.name.c_str(), nullptr, nullptr, nullptr))
+            return false;
+        }
+      }
+    } catch (const XMP_Error&) {
+      return false;
+    }
+    return true;
+  }
+
+  //! Turn a property into Exiv2 values like XmpParser::decode does with the toolkit's iterator
+  void flatten(size_t schema, const NativeXmpNode& node, const std::string& path) {
+    if (node.altText) {
+      auto val = std::make_unique<LangAltValue>();
+      for (const auto& item : node.children)
+        val->value_[item.lang] = item.value;
+      properties_.push_back({schema, path, std::move(val)});
+      return;
+    }
+    if (node.form == NativeXmpNode::array &&
+        std::all_of(node.children.begin(), node.children.end(),
+                    [](const NativeXmpNode& item) { return item.form == NativeXmpNode::simple; })) {
+      auto val = std::make_unique<XmpArrayValue>(node.arrayType);
+      for (const auto& item : node.children)
+        val->read(item.value);
+      properties_.push_back({schema, path, std::move(val)});
+      return;
+    }
+    auto val = std::make_unique<XmpTextValue>();
+    if (node.form == NativeXmpNode::simple) {
+      val->read(node.value);
+      properties_.push_back({schema, path, std::move(val)});
+      return;
+    }
+    val->setXmpArrayType(XmpValue::xmpArrayType(node.arrayType));
+    val->setXmpStruct(node.form == NativeXmpNode::structure ? XmpValue::xsStruct : XmpValue::xsNone);
+    properties_.push_back({schema, path, std::move(val)});
+    for (size_t i = 0; i < node.children.size(); ++i) {
+      const auto& child = node.children[i];
+      flatten(schema, child,
+              node.form == NativeXmpNode::array ? path + "[" + std::to_string(i + 1) + "]" : path + "/" + child.name);
+    }
+  }
+
+  static void XMLCALL startElement_cb(void* userData, const XML_Char* name, const XML_Char** attrs) noexcept {
+    static_cast<NativeXmpReader*>(userData)->startElement(name, attrs);
+  }
+
+  static void XMLCALL endElement_cb(void* userData, const XML_Char*) noexcept {
+    static_cast<NativeXmpReader*>(userData)->endElement();
+  }
+
+  static void XMLCALL characterData_cb(void* userData, const XML_Char* s, int len) noexcept {
+    static_cast<NativeXmpReader*>(userData)->characterData(s, len);
+  }
+
+  static void XMLCALL startNamespace_cb(void* userData, const XML_Char* prefix, const XML_Char* uri) noexcept {
+    static_cast<NativeXmpReader*>(userData)->startNamespace(prefix, uri);
+  }
+
+  static void XMLCALL endNamespace_cb(void* userData, const XML_Char*) noexcept {
+    static_cast<NativeXmpReader*>(userData)->endNamespace();
+  }
+
+  static void XMLCALL processingInstruction_cb(void* userData, const XML_Char* target, const XML_Char*) noexcept {
+    static_cast<NativeXmpReader*>(userData)->processingInstruction(target);
+  }
+
+  static void XMLCALL startDTD_cb(void* userData, const XML_Char*, const XML_Char*, const XML_Char*, int) noexcept {
+    static_cast<NativeXmpReader*>(userData)->fail();
+  }
+
+  const size_t maxDepth_;
+  XML_Parser parser_;
+  bool failed_ = false;
+  size_t elemDepth_ = 0;
+  size_t nsDepth_ = 0;
+  int rdfCount_ = 0;
+  std::vector<Frame> stack_;
+  std::vector<std::pair<std::string, std::string>> namespaces_;  // URI and prefix of each declaration
+  std::vector<Schema> schemas_;
+  std::unordered_set<std::string> topNames_;
+  std::vector<std::string> uris_;
+  std::vector<Property> properties_;
+};
+
+/*!
+  @brief Builds the tree XmpParser::encode builds with the toolkit, and writes it like
+         SXMPMeta::SerializeToBuffer in its compact format. add() and serialize() return
+         false if the toolkit needs to do it, or would fail.
+ */
+class NativeXmpWriter {
+ public:
+  //! Add a property like XmpParser::encode does with the toolkit
+  bool add(const Xmpdatum& xmp, const std::string& ns) {
+    if (xmp.typeId() == langAlt) {
+      const auto la = dynamic_cast<const LangAltValue*>(&xmp.value());
+      if (!la)
+        return false;
+      NativeXmpNode* node = nullptr;
+      for (const auto& [lang, specs] : la->value_) {
+        if (specs.empty())
+          continue;
+        if (!node && !(node = create(ns, xmp.tagName())))
+          return false;
+        node->form = NativeXmpNode::array;
+        node->arrayType = xmpAlt;
+        auto& item = node->children.emplace_back();
+        if (!setValue(item.value, specs) || !setValue(item.lang, lang))
+          return false;
+        normalizeLang(item.lang);
+        item.hasLang = true;
+      }
+      return true;
+    }
+
+    const auto val = dynamic_cast<const XmpValue*>(&xmp.value());
+    if (!val || (val->xmpStruct() != XmpValue::xsNone && val->xmpArrayType() != XmpValue::xaNone))
+      return false;
+    const auto typeId = xmp.typeId();
+    if (typeId != xmpBag && typeId != xmpSeq && typeId != xmpAlt &&
+        (typeId != xmpText || !dynamic_cast<const XmpTextValue*>(val)))
+      return false;
+    NativeXmpNode* node = create(ns, xmp.tagName());
+    if (!node)
+      return false;
+    if (val->xmpStruct() != XmpValue::xsNone) {
+      node->form = NativeXmpNode::structure;
+    } else if (val->xmpArrayType() != XmpValue::xaNone) {
+      node->form = NativeXmpNode::array;
+      node->arrayType = val->xmpArrayType() == XmpValue::xaAlt   ? xmpAlt
+                        : val->xmpArrayType() == XmpValue::xaSeq ? xmpSeq
+                                                                 : xmpBag;
+    }
+    if (typeId == xmpText) {
+      return xmp.count() == 0 || node->form != NativeXmpNode::simple || setValue(node->value, xmp.toString(0));
+    }
+    if (xmp.count() > 0 && node->form != NativeXmpNode::array)
+      return false;
+    for (size_t i = 0; i < xmp.count(); ++i) {
+      if (!setValue(node->children.emplace_back().value, xmp.toString(static_cast<long>(i))))
+        return false;
+    }
+    return true;
+  }
+
+  //! Write the packet, see SXMPMeta::SerializeToBuffer
+  bool serialize(std::string& packet, uint16_t formatFlags, uint32_t padding) {
+    const bool omitWrapper = formatFlags & XmpParser::omitPacketWrapper;
+    const bool readOnly = formatFlags & XmpParser::readOnlyPacket;
+    const bool exactLength = formatFlags & XmpParser::exactPacketLength;
+    if (!(formatFlags & XmpParser::useCompactFormat) ||
+        (formatFlags & (XmpParser::includeThumbnailPad | XmpParser::writeAliasComments)) ||
+        ((exactLength || readOnly) && omitWrapper))
+      return false;
+    if (formatFlags & XmpParser::omitAllFormatting) {
+      newline_ = " ";
+      indent_ = "";
+    }
+
+    out_.clear();
+    if (!omitWrapper) {
+      out_ += "<?xpacket begin=\"\xEF\xBB\xBF\" id=\"W5M0MpCehiHzreSzNTczkc9d\"?>";
+      out_ += newline_;
+    }
+    out_ += "<x:xmpmeta xmlns:x=\"adobe:ns:meta/\" x:xmptk=\"";
+    out_ += versionMessage();
+    out_ += "\">";
+    out_ += newline_;
+    indent(1);
+    out_ += "<rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\">";
+    out_ += newline_;
+    indent(2);
+    out_ += "<rdf:Description rdf:about=\"\"";
+    usedNs_ = "xml:rdf:";
+    for (const auto& schema : schemas_) {
+      declareNamespace(schema.prefix, schema.uri);
+      for (const auto& node : schema.props) {
+        if (!declareNamespaces(node))
+          return false;
+      }
+    }
+    bool allAreAttrs = true;
+    for (const auto& schema : schemas_)
+      allAreAttrs &= writeAttrProps(schema.props, 3);
+    if (allAreAttrs) {
+      out_ += "/>";
+      out_ += newline_;
+    } else {
+      out_ += '>';
+      out_ += newline_;
+      for (const auto& schema : schemas_)
+        writeElemProps(schema.props, 3);
+      indent(2);
+      out_ += "</rdf:Description>";
+      out_ += newline_;
+    }
+    indent(1);
+    out_ += "</rdf:RDF>";
+    out_ += newline_;
+    out_ += "</x:xmpmeta>";
+    out_ += newline_;
+
+    std::string tail;
+    if (!omitWrapper)
+      tail = readOnly ? "<?xpacket end=\"r\"?>" : "<?xpacket end=\"w\"?>";
+    size_t pad = padding;
+    if (exactLength) {
+      if (out_.size() + tail.size() > pad)
+        return false;
+      pad -= out_.size() + tail.size();
+    } else if (readOnly || omitWrapper) {
+      pad = 0;
+    } else if (pad == 0) {
+      pad = 2048;
+    }
+    const size_t newlineLen = std::strlen(newline_);
+    if (pad < newlineLen) {
+      out_.append(pad, ' ');
+    } else {
+      pad -= newlineLen;
+      for (; pad >= 100 + newlineLen; pad -= 100 + newlineLen) {
+        out_.append(100, ' ');
+        out_ += newline_;
+      }
+      out_.append(pad, ' ');
+      out_ += newline_;
+    }
+    out_ += tail;
+    packet = std::move(out_);
+    return true;
+  }
+
+ private:
+  struct Schema {
+    std::string uri;
+    std::string prefix;  // With the colon
+    std::vector<NativeXmpNode> props;
+    std::unordered_map<std::string, size_t> index;
+  };
+
+  //! The toolkit's version message for x:xmptk
+  static const std::string& versionMessage() {
+    static const std::string message = [] {
+      XMP_VersionInfo info;
+      SXMPMeta::GetVersionInfo(&info);
+      return std::string(info.message);
+    }();
+    return message;
+  }
+
+  //! Copy a value like the toolkit's SetProperty, return false if it is not UTF-8
+  static bool setValue(std::string& dst, const std::string& src) {
+    dst.assign(src.c_str());
+    for (size_t i = 0; i < dst.size();) {
+      const auto c = static_cast<unsigned char>(dst[i]);
+      if (c < 0x80) {
+        if ((c < 0x20 && c != '\t' && c != '\n' && c != '\r') || c == 0x7F)
+          dst[i] = ' ';
+        ++i;
+        continue;
+      }
+      size_t count = 0;
+      for (auto b = c; b & 0x80; b <<= 1)
+        ++count;
+      if (count < 2 || count > 4 || count > dst.size() - i)
+        return false;
+      uint32_t cp = c & ((1U << (7 - count)) - 1);
+      for (size_t k = 1; k < count; ++k) {
+        const auto d = static_cast<unsigned char>(dst[i + k]);
+        if ((d & 0xC0) != 0x80)
+          return false;
+        cp = (cp << 6) | (d & 0x3F);
+      }
+      if ((0xD800 <= cp && cp <= 0xDFFF) || cp > 0x10FFFF)
+        return false;
+      i += count;
+    }
+    return true;
+  }
+
+  //! Parse an XML name made of ASCII characters
+  static std::string_view parseName(std::string_view path, size_t& pos) {
+    const size_t start = pos;
+    auto isStart = [](char c) { return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || c == '_'; };
+    if (pos < path.size() && isStart(path[pos])) {
+      for (++pos; pos < path.size(); ++pos) {
+        const char c = path[pos];
+        if (!isStart(c) && !('0' <= c && c <= '9') && c != '.' && c != '-')
+          break;
+      }
+    }
+    return path.substr(start, pos - start);
+  }
+
+  //! The URI the toolkit has for a prefix with a colon, empty if it has none
+  const std::string& prefixUri(const std::string& prefix) {
+    auto pos = prefixUris_.find(prefix);
+    if (pos == prefixUris_.end()) {
+      std::string uri;
+      SXMPMeta::GetNamespaceURI(prefix.substr(0, prefix.size() - 1).c_str(), &uri);
+      pos = prefixUris_.emplace(prefix, uri).first;
+    }
+    return pos->second;
+  }
+
+  /*!
+    @brief Create the node of a property path like SetProperty, with the missing nodes on the
+           way. Like the toolkit's, such a node is a struct if a field follows. Return nullptr
+           if the node exists, or the path has more than names and indexes or does not fit the
+           tree.
+   */
+  NativeXmpNode* create(const std::string& ns, const std::string& path) {
+    size_t pos = 0;
+    const auto name = parseName(path, pos);
+    if (name.empty() || ns.empty())
+      return nullptr;
+    auto schema = std::find_if(schemas_.begin(), schemas_.end(), [&](const Schema& s) { return s.uri == ns; });
+    if (schema == schemas_.end()) {
+      std::string prefix;
+      if (!SXMPMeta::GetNamespacePrefix(ns.c_str(), &prefix))
+        return nullptr;
+      schema = schemas_.insert(schemas_.end(), {ns, prefix, {}, {}});
+    }
+    auto qname = schema->prefix + std::string(name);
+    NativeXmpNode* node = nullptr;
+    bool isNew = false;
+    if (auto top = schema->index.find(qname); top != schema->index.end()) {
+      node = &schema->props[top->second];
+    } else {
+      if (SXMPMeta::ResolveAlias(ns.c_str(), qname.c_str(), nullptr, nullptr, nullptr))
+        return nullptr;
+      schema->index.emplace(qname, schema->props.size());
+      node = &schema->props.emplace_back();
+      node->name = std::move(qname);
+      isNew = true;
+    }
+    while (pos < path.size()) {
+      if (path[pos] == '[') {
+        if (isNew || node->form != NativeXmpNode::array || ++pos == path.size() || path[pos] < '1' ||
+            path[pos] > '9')
+          return nullptr;
+        size_t index = 0;
+        for (; pos < path.size() && '0' <= path[pos] && path[pos] <= '9' && index <= node->children.size(); ++pos)
+          index = index * 10 + (path[pos] - '0');
+        if (pos == path.size() || path[pos++] != ']' || index > node->children.size() + 1)
+          return nullptr;
+        isNew = index > node->children.size();
+        node = isNew ? &node->children.emplace_back() : &node->children[index - 1];
+      } else if (path[pos] == '/') {
+        ++pos;
+        const auto prefix = parseName(path, pos);
+        if (isNew)
+          node->form = NativeXmpNode::structure;
+        if (node->form != NativeXmpNode::structure || prefix.empty() || pos == path.size() || path[pos++] != ':')
+          return nullptr;
+        const auto local = parseName(path, pos);
+        auto field = std::string(prefix) + ":";
+        if (local.empty() || prefixUri(field).empty())
+          return nullptr;
+        field.append(local);
+        const auto f = std::find_if(node->children.begin(), node->children.end(),
+                                    [&](const NativeXmpNode& child) { return child.name == field; });
+        isNew = f == node->children.end();
+        if (isNew) {
+          node = &node->children.emplace_back();
+          node->name = std::move(field);
+        } else {
+          node = &*f;
+        }
+      } else {
+        return nullptr;
+      }
+    }
+    return isNew ? node : nullptr;
+  }
+
+  void indent(int level) {
+    for (; level > 0; --level)
+      out_ += indent_;
+  }
+
+  //! Append a value with XML escapes
+  void appendValue(const std::string& value, bool forAttribute) {
+    for (const char c : value) {
+      if (forAttribute && c == '"') {
+        out_ += "&quot;";
+      } else if (c == '&') {
+        out_ += "&amp;";
+      } else if (c == '<') {
+        out_ += "&lt;";
+      } else if (c == '>') {
+        out_ += "&gt;";
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        out_ += "&#x";
+        out_ += "0123456789ABCDEF"[c & 0xF];
+        out_ += ';';
+      } else {
+        out_ += c;
+      }
+    }
+  }
+
+  void declareNamespace(const std::string& prefix, const std::string& uri) {
+    if (usedNs_.find(":" + prefix) != std::string::npos)
+      return;
+    out_ += newline_;
+    indent(4);
+    out_ += "xmlns:";
+    out_.append(prefix, 0, prefix.size() - 1);
+    out_ += "=\"";
+    out_ += uri;
+    out_ += '"';
+    usedNs_ += prefix;
+  }
+
+  bool declareElemNamespace(const std::string& name) {
+    const auto prefix = name.substr(0, name.find(':') + 1);
+    const auto& uri = prefixUri(prefix);
+    if (uri.empty())
+      return false;
+    declareNamespace(prefix, uri);
+    return true;
+  }
+
+  //! Declare the namespaces of the fields and qualifiers in a property, see DeclareUsedNamespaces
+  bool declareNamespaces(const NativeXmpNode& node) {
+    if (node.form == NativeXmpNode::structure) {
+      for (const auto& field : node.children) {
+        if (!declareElemNamespace(field.name))
+          return false;
+      }
+    }
+    for (const auto& child : node.children) {
+      if (!declareNamespaces(child))
+        return false;
+    }
+    return !node.hasLang || declareElemNamespace("xml:lang");
+  }
+
+  static bool canBeAttr(const NativeXmpNode& node) {
+    return !node.name.empty() && !node.hasLang && node.form == NativeXmpNode::simple;
+  }
+
+  //! Write the simple properties as attributes, return true if all are
+  bool writeAttrProps(const std::vector<NativeXmpNode>& props, int level) {
+    bool allAreAttrs = true;
+    for (const auto& node : props) {
+      if (!canBeAttr(node)) {
+        allAreAttrs = false;
+        continue;
+      }
+      out_ += newline_;
+      indent(level);
+      out_ += node.name;
+      out_ += "=\"";
+      appendValue(node.value, true);
+      out_ += '"';
+    }
+    return allAreAttrs;
+  }
+
+  void writeArrayTag(const NativeXmpNode& node, int level, bool start) {
+    if (!start && node.children.empty())
+      return;
+    indent(level);
+    out_ += start ? "<rdf:" : "</rdf:";
+    out_ += node.arrayType == xmpAlt ? "Alt" : node.arrayType == xmpSeq ? "Seq" : "Bag";
+    if (start && node.children.empty())
+      out_ += '/';
+    out_ += '>';
+    out_ += newline_;
+  }
+
+  //! Write the other properties as elements, see SerializeCompactRDFElemProps
+  void writeElemProps(const std::vector<NativeXmpNode>& props, int level) {
+    for (const auto& node : props) {
+      if (canBeAttr(node))
+        continue;
+      const std::string& elemName = node.name.empty() ? liName : node.name;
+      indent(level);
+      out_ += '<';
+      out_ += elemName;
+      if (node.hasLang) {
+        out_ += " xml:lang=\"";
+        appendValue(node.lang, true);
+        out_ += '"';
+      }
+      bool emitEndTag = true;
+      bool indentEndTag = true;
+      if (node.form == NativeXmpNode::simple) {
+        if (node.value.empty()) {
+          out_ += "/>";
+          out_ += newline_;
+          emitEndTag = false;
+        } else {
+          out_ += '>';
+          appendValue(node.value, false);
+          indentEndTag = false;
+        }
+      } else if (node.form == NativeXmpNode::array) {
+        out_ += '>';
+        out_ += newline_;
+        writeArrayTag(node, level + 1, true);
+        writeElemProps(node.children, level + 2);
+        writeArrayTag(node, level + 1, false);
+      } else {
+        const bool hasAttrFields = std::any_of(node.children.begin(), node.children.end(), canBeAttr);
+        const bool hasElemFields = !std::all_of(node.children.begin(), node.children.end(), canBeAttr);
+        if (node.children.empty()) {
+          out_ += " rdf:parseType=\"Resource\"/>";
+          out_ += newline_;
+          emitEndTag = false;
+        } else if (!hasElemFields) {
+          writeAttrProps(node.children, level + 1);
+          out_ += "/>";
+          out_ += newline_;
+          emitEndTag = false;
+        } else if (!hasAttrFields) {
+          out_ += " rdf:parseType=\"Resource\">";
+          out_ += newline_;
+          writeElemProps(node.children, level + 1);
+        } else {
+          out_ += '>';
+          out_ += newline_;
+          indent(level + 1);
+          out_ += "<rdf:Description";
+          writeAttrProps(node.children, level + 2);
+          out_ += '>';
+          out_ += newline_;
+          writeElemProps(node.children, level + 1);
+          indent(level + 1);
+          out_ += "</rdf:Description>";
+          out_ += newline_;
+        }
+      }
+      if (emitEndTag) {
+        if (indentEndTag)
+          indent(level);
+        out_ += "</";
+        out_ += elemName;
+        out_ += '>';
+        out_ += newline_;
+      }
+    }
+  }
+
+  inline static const std::string liName = "rdf:li";
+
+  std::vector<Schema> schemas_;
+  std::map<std::string, std::string> prefixUris_;
+  std::string out_;
+  std::string usedNs_;
+  const char* newline_ = "\n";
+  const char* indent_ = " ";
+};
+
+/*!
+  @brief Serialize xmpData without the toolkit into packet. The namespace of each datum
+         is in namespaces. Return false if the toolkit needs to do it.
+ */
+bool serializeNative(std::string& packet, const XmpData& xmpData, const std::vector<std::string>& namespaces,
+                     uint16_t formatFlags, uint32_t padding) {
+  try {
+    NativeXmpWriter writer;
+    auto ns = namespaces.begin();
+    for (const auto& xmp : xmpData) {
+      if (!writer.add(xmp, *ns++))
+        return false;
+    }
+    return writer.serialize(packet, formatFlags, padding);
+  } catch (const XMP_Error&) {
+    return false;
+  }
+}
+}  // namespace
 #endif  // EXV_HAVE_XMP_TOOLKIT
 
 // *****************************************************************************
@@ -194,7 +1260,7 @@ namespace {
 class FindXmpdatum {
  public:
   //! Constructor, initializes the object with key
-  explicit FindXmpdatum(const Exiv2::XmpKey& key) : key_(key.key()) {
+  explicit FindXmpdatum(std::string key) : key_(std::move(key)) {
   }
   /*!
     @brief Returns true if prefix and property of the argument
@@ -246,18 +1312,16 @@ struct Xmpdatum::Impl {
   ~Impl() = default;
 
   // DATA
-  XmpKey::UniquePtr key_;   //!< Key
+  XmpKey key_;              //!< Key
   Value::UniquePtr value_;  //!< Value
 };
 
-Xmpdatum::Impl::Impl(const XmpKey& key, const Value* pValue) : key_(key.clone()) {
+Xmpdatum::Impl::Impl(const XmpKey& key, const Value* pValue) : key_(key) {
   if (pValue)
     value_ = pValue->clone();
 }
 
-Xmpdatum::Impl::Impl(const Impl& rhs) {
-  if (rhs.key_)
-    key_ = rhs.key_->clone();  // deep copy
+Xmpdatum::Impl::Impl(const Impl& rhs) : key_(rhs.key_) {
   if (rhs.value_)
     value_ = rhs.value_->clone();  // deep copy
 }
@@ -265,9 +1329,7 @@ Xmpdatum::Impl::Impl(const Impl& rhs) {
 Xmpdatum::Impl& Xmpdatum::Impl::operator=(const Impl& rhs) {
   if (this == &rhs)
     return *this;
-  key_.reset();
-  if (rhs.key_)
-    key_ = rhs.key_->clone();  // deep copy
+  key_ = rhs.key_;
   value_.reset();
   if (rhs.value_)
     value_ = rhs.value_->clone();  // deep copy
@@ -280,41 +1342,51 @@ Xmpdatum::Xmpdatum(const XmpKey& key, const Value* pValue) : p_(std::make_unique
 Xmpdatum::Xmpdatum(const Xmpdatum& rhs) : p_(std::make_unique<Impl>(*rhs.p_)) {
 }
 
+Xmpdatum::Xmpdatum(Xmpdatum&& rhs) noexcept = default;
+
 Xmpdatum& Xmpdatum::operator=(const Xmpdatum& rhs) {
   if (this == &rhs)
     return *this;
-  *p_ = *rhs.p_;
+  if (p_)
+    *p_ = *rhs.p_;
+  else
+    p_ = std::make_unique<Impl>(*rhs.p_);
+  return *this;
+}
+
+Xmpdatum& Xmpdatum::operator=(Xmpdatum&& rhs) noexcept {
+  std::swap(p_, rhs.p_);
   return *this;
 }
 
 Xmpdatum::~Xmpdatum() = default;
 
 std::string Xmpdatum::key() const {
-  return p_->key_ ? p_->key_->key() : "";
+  return p_->key_.key();
 }
 
 const char* Xmpdatum::familyName() const {
-  return p_->key_ ? p_->key_->familyName() : "";
+  return p_->key_.familyName();
 }
 
 std::string Xmpdatum::groupName() const {
-  return p_->key_ ? p_->key_->groupName() : "";
+  return p_->key_.groupName();
 }
 
 std::string Xmpdatum::tagName() const {
-  return p_->key_ ? p_->key_->tagName() : "";
+  return p_->key_.tagName();
 }
 
 std::string Xmpdatum::tagLabel() const {
-  return p_->key_ ? p_->key_->tagLabel() : "";
+  return p_->key_.tagLabel();
 }
 
 std::string Xmpdatum::tagDesc() const {
-  return p_->key_ ? p_->key_->tagDesc() : "";
+  return p_->key_.tagDesc();
 }
 
 uint16_t Xmpdatum::tag() const {
-  return p_->key_ ? p_->key_->tag() : 0;
+  return p_->key_.tag();
 }
 
 TypeId Xmpdatum::typeId() const {
@@ -384,11 +1456,7 @@ void Xmpdatum::setValue(const Value* pValue) {
 int Xmpdatum::setValue(const std::string& value) {
   XmpProperties::XmpLock lock;
   if (!p_->value_) {
-    TypeId type = xmpText;
-    if (p_->key_) {
-      type = XmpProperties::propertyTypeUnlocked(*p_->key_.get(), lock);
-    }
-    p_->value_ = Value::create(type);
+    p_->value_ = Value::create(XmpProperties::propertyTypeUnlocked(p_->key_, lock));
   }
   return p_->value_->read(value);
 }
@@ -396,11 +1464,13 @@ int Xmpdatum::setValue(const std::string& value) {
 Xmpdatum& XmpData::operator[](const std::string& key) {
   XmpProperties::XmpLock lock;
   XmpKey xmpKey(key, lock);
-  auto pos = std::find_if(xmpMetadata_.begin(), xmpMetadata_.end(), FindXmpdatum(xmpKey));
-  if (pos == xmpMetadata_.end()) {
-    return xmpMetadata_.emplace_back(xmpKey);
+  const auto k = xmpKey.key();
+  changes_.touch(k);
+  if (auto pos = findUnlocked(k, lock); pos < xmpMetadata_.size()) {
+    keyIndexLent_ = pos;
+    return xmpMetadata_[pos];
   }
-  return *pos;
+  return xmpMetadata_.emplace_back(xmpKey);
 }
 
 int XmpData::add(const XmpKey& key, const Value* value) {
@@ -409,6 +1479,7 @@ int XmpData::add(const XmpKey& key, const Value* value) {
 }
 
 int XmpData::addUnlocked(const XmpKey& key, const Value* value, const XmpProperties::XmpLock&) {
+  changes_.touch(key.key());
   xmpMetadata_.emplace_back(key, value);
   return 0;
 }
@@ -419,18 +1490,54 @@ int XmpData::add(const Xmpdatum& xmpDatum) {
 }
 
 int XmpData::addUnlocked(const Xmpdatum& xmpDatum, const XmpProperties::XmpLock&) {
+  changes_.touch(xmpDatum.key());
   xmpMetadata_.push_back(xmpDatum);
   return 0;
 }
 
+size_t XmpData::findUnlocked(const std::string& key, const XmpProperties::XmpLock&) const {
+  // The entry handed out last keeps its place in the index only if its key was not changed through it
+  if (!keyIndexStale_ && keyIndexLent_ < keyIndexed_ && keyIndexed_ <= xmpMetadata_.size()) {
+    auto lent = keyIndex_.find(xmpMetadata_[keyIndexLent_].key());
+    keyIndexStale_ = lent == keyIndex_.end() || lent->second != keyIndexLent_;
+  }
+  keyIndexLent_ = std::numeric_limits<size_t>::max();
+  // Other references may be outstanding, so the entry found must still have the key
+  for (bool rebuilt = false;; rebuilt = true) {
+    if (keyIndexStale_ || keyIndexed_ > xmpMetadata_.size()) {
+      keyIndex_.clear();
+      keyIndexed_ = 0;
+      keyIndexStale_ = false;
+    }
+    for (; keyIndexed_ < xmpMetadata_.size(); ++keyIndexed_)
+      keyIndex_.try_emplace(xmpMetadata_[keyIndexed_].key(), keyIndexed_);
+    auto i = keyIndex_.find(key);
+    if (i == keyIndex_.end())
+      return xmpMetadata_.size();
+    if (rebuilt || xmpMetadata_[i->second].key() == key)
+      return i->second;
+    keyIndexStale_ = true;
+  }
+}
+
+void XmpData::resetKeyIndex() {
+  keyIndexStale_ = true;
+}
+
 XmpData::const_iterator XmpData::findKey(const XmpKey& key) const {
   XmpProperties::XmpLock lock;
-  return std::find_if(xmpMetadata_.begin(), xmpMetadata_.end(), FindXmpdatum(key));
+  return xmpMetadata_.begin() + findUnlocked(key.key(), lock);
 }
 
 XmpData::iterator XmpData::findKey(const XmpKey& key) {
   XmpProperties::XmpLock lock;
-  return std::find_if(xmpMetadata_.begin(), xmpMetadata_.end(), FindXmpdatum(key));
+  const auto k = key.key();
+  const auto pos = findUnlocked(k, lock);
+  if (pos < xmpMetadata_.size()) {
+    changes_.touch(k);
+    keyIndexLent_ = pos;
+  }
+  return xmpMetadata_.begin() + pos;
 }
 
 void XmpData::clear() {
@@ -441,6 +1548,8 @@ void XmpData::clear() {
 void XmpData::clearUnlocked(const XmpProperties::XmpLock&) {
   xmpMetadata_.clear();
   nsBindings_.clear();
+  resetKeyIndex();
+  changes_.touchAll();
 }
 
 void XmpData::sortByKey() {
@@ -450,6 +1559,7 @@ void XmpData::sortByKey() {
 
 void XmpData::sortByKeyUnlocked(const XmpProperties::XmpLock&) {
   std::sort(xmpMetadata_.begin(), xmpMetadata_.end(), cmpMetadataByKey);
+  resetKeyIndex();
 }
 
 XmpData::const_iterator XmpData::begin() const {
@@ -478,7 +1588,14 @@ long XmpData::countUnlocked(const XmpProperties::XmpLock&) const {
   return static_cast<long>(xmpMetadata_.size());
 }
 
+uint64_t XmpData::generation() const {
+  XmpProperties::XmpLock lock;
+  return changes_.generation();
+}
+
 XmpData::iterator XmpData::begin() {
+  changes_.touchAll();
+  resetKeyIndex();
   return xmpMetadata_.begin();
 }
 
@@ -488,6 +1605,8 @@ XmpData::iterator XmpData::end() {
 
 XmpData::iterator XmpData::erase(XmpData::iterator pos) {
   XmpProperties::XmpLock lock;
+  changes_.touch(pos->key());
+  resetKeyIndex();
   return xmpMetadata_.erase(pos);
 }
 
@@ -510,7 +1629,7 @@ void XmpData::eraseFamily(XmpData::iterator& pos) {
   }
   // now erase the family!
   for (const auto& k : keys) {
-    erase(findKey(Exiv2::XmpKey(k)));
+    erase(std::find_if(xmpMetadata_.begin(), xmpMetadata_.end(), FindXmpdatum(k)));
   }
 }
 
@@ -518,11 +1637,23 @@ void XmpData::eraseFamily(XmpData::iterator& pos) {
 // See src/properties.cpp for the definition.
 
 // Lock Hierarchy:
-// 1. XmpProperties::getMutex()
+// 1. toolkitBindingsMutex
+//    - Held shared by encode from SetProperty through serialization, and by decode from the parse
+//      of a packet which declares no new namespace binding through the walk of its properties
+//    - Held exclusively to change a namespace binding of the XMP Toolkit: by registerNs, by encode
+//      to register Exiv2's namespaces and by decode to parse any other packet
+// 2. XmpProperties::getMutex()
 //    - Protects XMP Toolkit lifecycle (initialize/terminate)
-//    - Protects XMP Toolkit usage (encode/decode) via serialization
 //    - Protects XMP Namespace Registry (XmpProperties::nsRegistry_)
-//    - Protects XMP SDK internal state (via exclusive access)
+//    - Protects namespace registration with the XMP Toolkit
+// 3. The toolkit lock, taken by the class-static SXMPMeta functions (namespace lookup and registration)
+// 4. The toolkit namespace map lock, taken briefly by the SXMPMeta methods
+//
+// Parsing, iterating and serializing an SXMPMeta object (encode/decode) does not need the Giant
+// Lock: toolkit objects are used by one thread at a time and the toolkit protects its shared
+// namespace maps itself. encode and decode only take it for the namespace and key lookups.
+// The bindings must not change while a packet is built and serialized or walked though, as the
+// toolkit looks up the prefix of each property again.
 //
 // Facade Pattern:
 // - Public methods (encode, decode, registerNs, etc...) acquire the lock
@@ -534,6 +1665,68 @@ void XmpData::eraseFamily(XmpData::iterator& pos) {
 // Default locking implementation removed as we use Giant Lock
 
 #ifdef EXV_HAVE_XMP_TOOLKIT
+namespace {
+//! Generations of Exiv2's namespace registry and of the toolkit's when encode() last synchronized them
+struct NsGenerations {
+  uint64_t registry_ = 0;
+  XMP_Uns64 toolkit_ = 0;
+  bool operator==(const NsGenerations&) const = default;
+};
+NsGenerations syncedNsGenerations;  // Guarded by the Giant Lock
+std::shared_mutex toolkitBindingsMutex;
+
+NsGenerations nsGenerations(uint64_t registry) {
+#ifdef EXV_ADOBE_XMPSDK
+  // The Adobe XMP SDK has no generation, and does not rebind a registered URI to another prefix
+  return {registry, 0};
+#else
+  return {registry, SXMPMeta::GetNamespaceGeneration()};
+#endif
+}
+
+//! Whether the toolkit's parse of the packet may change a namespace binding: it declares a namespace
+//! which is not registered with the same prefix, or one this scan cannot read.
+bool parseMayRebindNamespaces(std::string_view packet) {
+  // A packet in UTF-16 or UTF-32 is not scanned
+  if (packet.find('\0') != std::string_view::npos)
+    return true;
+  constexpr auto space = " \t\r\n";
+  for (auto pos = packet.find("xmlns"); pos != std::string_view::npos; pos = packet.find("xmlns", pos)) {
+    pos += 5;
+    std::string prefix = "_dflt_";
+    if (pos < packet.size() && packet[pos] == ':') {
+      const auto end = packet.find_first_of(" \t\r\n=", pos);
+      if (end == std::string_view::npos)
+        return true;
+      prefix = packet.substr(pos + 1, end - pos - 1);
+      pos = end;
+    }
+    pos = packet.find_first_not_of(space, pos);
+    if (pos == std::string_view::npos || packet[pos] != '=')
+      continue;  // Not an attribute
+    pos = packet.find_first_not_of(space, pos + 1);
+    if (pos == std::string_view::npos || (packet[pos] != '"' && packet[pos] != '\''))
+      return true;
+    const auto end = packet.find(packet[pos], pos + 1);
+    if (end == std::string_view::npos)
+      return true;
+    std::string uri(packet.substr(pos + 1, end - pos - 1));
+    pos = end + 1;
+    if (uri.empty())
+      continue;  // Not registered
+    if (uri.find_first_of("&\t\r\n") != std::string::npos)
+      return true;
+    if (uri == "http://purl.org/dc/1.1/")
+      uri = "http://purl.org/dc/elements/1.1/";
+    std::string registeredPrefix;
+    std::string registeredUri;
+    if (!SXMPMeta::GetNamespacePrefix(uri.c_str(), &registeredPrefix) || registeredPrefix != prefix + ':' ||
+        !SXMPMeta::GetNamespaceURI(prefix.c_str(), &registeredUri) || registeredUri != uri)
+      return true;
+  }
+  return false;
+}
+}  // namespace
 
 void xmpToolkitEnsureInitialized() {
   static XmpToolkitLifetimeManager instance;
@@ -544,11 +1737,12 @@ void XmpParser::registerNsImpl(const std::string& ns, const std::string& prefix)
   xmpToolkitEnsureInitialized();
   try {
     std::string existingPrefix;
+    std::string existingNs;
     if (SXMPMeta::GetNamespacePrefix(ns.c_str(), &existingPrefix)) {
       if (!existingPrefix.empty() && existingPrefix.back() == ':') {
         existingPrefix.pop_back();
       }
-      if (existingPrefix == prefix) {
+      if (existingPrefix == prefix && SXMPMeta::GetNamespaceURI(prefix.c_str(), &existingNs) && existingNs == ns) {
         // Already registered correctly, skip overhead
         return;
       }
@@ -630,6 +1824,7 @@ void XmpParser::clearCustomNamespaces() {
 #ifdef EXV_HAVE_XMP_TOOLKIT
 void XmpParser::registerNs(const std::string& ns, const std::string& prefix) {
   try {
+    std::unique_lock bindingsLock(toolkitBindingsMutex);
     XmpProperties::XmpLock lock;
     registerNsImpl(ns, prefix);
   } catch (const XMP_Error& /* e */) {
@@ -668,26 +1863,72 @@ int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket, const Deco
       return 0;
     }
 
-    // Acquire Giant Lock
-    XmpProperties::XmpLock lock;
-    try {
-      xmpToolkitEnsureInitialized();
-    } catch (const Error&) {
+    {
+      XmpProperties::XmpLock lock;
+      try {
+        xmpToolkitEnsureInitialized();
+      } catch (const Error&) {
 #ifndef SUPPRESS_WARNINGS
-      EXV_ERROR << "XMP toolkit initialization failed.\n";
+        EXV_ERROR << "XMP toolkit initialization failed.\n";
 #endif
-      return 2;
+        return 2;
+      }
+      xmpData.clearUnlocked(lock);
     }
 
-    xmpData.clearUnlocked(lock);
+    // The packet is validated, parsed and walked without the Giant Lock. It is only taken to look
+    // up and register namespaces and to create keys, xmpData itself belongs to the caller.
 
     // Make sure the unterminated substring is used
     size_t len = xmpPacket.size();
     while (len > 0 && 0 == xmpPacket[len - 1])
       --len;
 
+    const auto maxDepth = std::clamp<size_t>(dp.max_recursion_depth(), 1, std::numeric_limits<XMP_Uns32>::max());
+    if (dp.native_xmp()) {
+      // The reader gives up on anything the toolkit would parse differently, and on namespaces
+      // Exiv2 does not know, which the toolkit path registers.
+      NativeXmpReader reader(maxDepth);
+      if (reader.read(xmpPacket.data(), len)) {
+        XmpProperties::XmpLock lock;
+        std::vector<std::string> prefixes;
+        for (const auto& uri : reader.schemas()) {
+          auto prefix = XmpProperties::prefixUnlocked(uri, lock);
+          if (prefix.empty())
+            break;
+          prefixes.push_back(std::move(prefix));
+        }
+        if (prefixes.size() == reader.schemas().size()) {
+          for (size_t i = 0; i < prefixes.size(); ++i)
+            xmpData.nsBindings_[prefixes[i]] = reader.schemas()[i];
+          for (auto& prop : reader.properties()) {
+            const auto& uri = reader.schemas()[prop.schema];
+            xmpData.xmpMetadata_.emplace_back(*makeXmpKey(uri, prop.path, lock), prop.value.get());
+          }
+          return 0;
+        }
+      }
+    }
+
+#ifdef EXV_ADOBE_XMPSDK
     XMLValidator::check(xmpPacket.data(), len, dp);
+#endif
+    // The parse registers the namespaces the packet declares with the toolkit. If that may change a
+    // binding it runs alone, else the bindings are shared until the properties have been walked.
+    std::shared_lock bindingsShared(toolkitBindingsMutex);
+    std::unique_lock<std::shared_mutex> bindingsExclusive;
+    if (parseMayRebindNamespaces({xmpPacket.data(), len})) {
+      bindingsShared.unlock();
+      bindingsExclusive = std::unique_lock(toolkitBindingsMutex);
+    }
+#ifdef EXV_ADOBE_XMPSDK
     SXMPMeta meta(xmpPacket.data(), static_cast<XMP_StringLen>(len));
+#else
+    // The toolkit's expat pass also rejects a DOCTYPE and trees nested deeper than the limit,
+    // so the packet is only tokenized once.
+    SXMPMeta meta;
+    meta.ParseFromBuffer(xmpPacket.data(), static_cast<XMP_StringLen>(len), 0, static_cast<XMP_Uns32>(maxDepth));
+#endif
     SXMPIterator iter(meta);
     std::string schemaNs;
     std::string propPath;
@@ -699,6 +1940,7 @@ int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket, const Deco
         throw Error(ErrorCode::kerAliasesNotSupported, schemaNs, propPath, propValue);
       }
       if (XMP_NodeIsSchema(opt)) {
+        XmpProperties::XmpLock lock;
         // Register unknown namespaces with Exiv2
         // (Namespaces are automatically registered with the XMP Toolkit)
         std::string prefix = XmpProperties::prefixUnlocked(schemaNs, lock);
@@ -723,7 +1965,11 @@ int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket, const Deco
         xmpData.nsBindings_[prefix] = schemaNs;
         continue;
       }
-      auto key = makeXmpKey(schemaNs, propPath, lock);
+      XmpKey::UniquePtr key;
+      {
+        XmpProperties::XmpLock lock;
+        key = makeXmpKey(schemaNs, propPath, lock);
+      }
       if (XMP_ArrayIsAltText(opt)) {
         // Read Lang Alt property
         auto val = std::make_unique<LangAltValue>();
@@ -745,7 +1991,7 @@ int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket, const Deco
           }
           val->value_[propValue] = std::move(text);
         }
-        xmpData.addUnlocked(*key, val.get(), lock);
+        xmpData.xmpMetadata_.emplace_back(*key, val.get());
         continue;
       }
       if (XMP_PropIsArray(opt) && !XMP_PropHasQualifiers(opt) && !XMP_ArrayIsAltText(opt)) {
@@ -774,7 +2020,7 @@ int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket, const Deco
             printNode(schemaNs, propPath, propValue, opt);
             val->read(propValue);
           }
-          xmpData.addUnlocked(*key, val.get(), lock);
+          xmpData.xmpMetadata_.emplace_back(*key, val.get());
           continue;
         }
       }
@@ -784,12 +2030,12 @@ int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket, const Deco
         // Create a metadatum with only XMP options
         val->setXmpArrayType(xmpArrayType(opt));
         val->setXmpStruct(xmpStruct(opt));
-        xmpData.addUnlocked(*key, val.get(), lock);
+        xmpData.xmpMetadata_.emplace_back(*key, val.get());
         continue;
       }
       if (XMP_PropIsSimple(opt) || XMP_PropIsQualifier(opt)) {
         val->read(propValue);
-        xmpData.addUnlocked(*key, val.get(), lock);
+        xmpData.xmpMetadata_.emplace_back(*key, val.get());
         continue;
       }
       // Don't let any node go by unnoticed
@@ -831,28 +2077,55 @@ int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket, const Deco
 #ifdef EXV_HAVE_XMP_TOOLKIT
 int XmpParser::encode(std::string& xmpPacket, const XmpData& xmpData, uint16_t formatFlags, uint32_t padding) {
   try {
-    // Acquire Giant Lock
-    XmpProperties::XmpLock lock;
-    try {
-      xmpToolkitEnsureInitialized();
-    } catch (const Error&) {
+    // The Giant Lock is held to register the namespaces with the toolkit and to resolve the
+    // namespace of each datum. The packet is built and serialized without it, but with the
+    // toolkit's namespace bindings held.
+    std::vector<std::string> namespaces;
+    std::shared_lock bindingsLock(toolkitBindingsMutex);
+    for (;;) {
+      {
+        XmpProperties::XmpLock lock;
+        try {
+          xmpToolkitEnsureInitialized();
+        } catch (const Error&) {
 #ifndef SUPPRESS_WARNINGS
-      EXV_ERROR << "XMP toolkit initialization failed.\n";
+          EXV_ERROR << "XMP toolkit initialization failed.\n";
 #endif
-      return 2;
-    }
+          return 2;
+        }
 
-    if (xmpData.emptyUnlocked(lock)) {
-      xmpPacket.clear();
-      return 0;
-    }  // We are holding the Giant Lock, so we can iterate nsRegistry_ safely.
-    // XmpProperties interactions must go through Unlocked/impl methods to avoid deadlocks.
-    for (const auto& [xmp, uri] : XmpProperties::nsRegistry_) {
+        if (xmpData.emptyUnlocked(lock)) {
+          xmpPacket.clear();
+          return 0;
+        }
+        // The registry is only pushed to the toolkit if either changed since the last encode. A
+        // decode changes the toolkit's, if a packet binds a registered URI to another prefix.
+        if (nsGenerations(XmpProperties::nsGeneration_) == syncedNsGenerations) {
+          namespaces.reserve(xmpData.countUnlocked(lock));
+          for (const auto& xmp : xmpData) {
+            namespaces.push_back(resolveNamespace(xmpData, xmp.groupName(), lock));
+          }
+          break;
+        }
+      }
+      // Pushing the registry changes the bindings, which needs them exclusively. A decode may
+      // change them again before they are shared, then they are pushed again.
+      bindingsLock.unlock();
+      {
+        std::unique_lock exclusiveLock(toolkitBindingsMutex);
+        XmpProperties::XmpLock lock;
+        // We are holding the Giant Lock, so we can iterate nsRegistry_ safely.
+        // XmpProperties interactions must go through Unlocked/impl methods to avoid deadlocks.
+        for (const auto& [xmp, uri] : XmpProperties::nsRegistry_) {
 #ifdef EXIV2_DEBUG_MESSAGES
-      std::cerr << "Registering " << uri.prefix_ << " : " << xmp << "\n";
+          std::cerr << "Registering " << uri.prefix_ << " : " << xmp << "\n";
 #endif
-      // registerNsImpl is safe since we hold the lock
-      registerNsImpl(xmp, uri.prefix_);
+          // registerNsImpl is safe since we hold both locks
+          registerNsImpl(xmp, uri.prefix_);
+        }
+        syncedNsGenerations = nsGenerations(XmpProperties::nsGeneration_);
+      }
+      bindingsLock.lock();
     }
 
     // Note: we deliberately do NOT re-register the per-instance bindings with
@@ -862,9 +2135,18 @@ int XmpParser::encode(std::string& xmpPacket, const XmpData& xmpData, uint16_t f
     // toolkit's URI->prefix mapping whenever our preferred prefix differs from the
     // one the file used for that URI (e.g. iptc vs Iptc4xmpCore), which breaks
     // serialization of struct fields that still carry the file's prefix.
+    if (formatFlags & useNativeSerializer) {
+      std::string tmpPacket;
+      if (serializeNative(tmpPacket, xmpData, namespaces, formatFlags, padding)) {
+        xmpPacket = std::move(tmpPacket);
+        return 0;
+      }
+    }
+
     SXMPMeta meta;
+    auto nsPos = namespaces.begin();
     for (const auto& xmp : xmpData) {
-      const std::string ns = resolveNamespace(xmpData, xmp.groupName(), lock);
+      const std::string& ns = *nsPos++;
       XMP_OptionBits options = 0;
 
       if (xmp.typeId() == langAlt) {
@@ -51,18 +51,16 @@ Exif comment    :
     stderr = [
         """Error: Directory Image: Next pointer is out of bounds; ignored.
 """
-        + 8 * err_msg_dir_img
+        + 9 * err_msg_dir_img
+        + """Warning: Directory Image, entry 0x3030 has unknown Exif (TIFF) type 12336; setting type size 1.
+Error: Directory Image, entry 0x3030 has invalid size 1414415696*1; skipping entry.
+"""
+        + 36 * err_msg_dir_img
         + """Warning: Directory Photo has an unexpected next pointer; ignored.
 """
         + 13 * err_msg_dir_ph
         + """Warning: Directory Photo, entry 0x927c has unknown Exif (TIFF) type 12336; setting type size 1.
-Warning: Directory Pentax has an unexpected next pointer; ignored.
 """
-        + 6 * err_msg_dir_pentax
-        + """Warning: Directory Pentax, entry 0x0006 has unknown Exif (TIFF) type 12336; setting type size 1.
-Warning: Directory Pentax, entry 0x0007 has unknown Exif (TIFF) type 12336; setting type size 1.
-"""
-        + 39 * err_msg_dir_pentax
         + 23 * err_msg_dir_ph
         + """Warning: Directory Photo, entry 0x3030 has unknown Exif (TIFF) type 48; setting type size 1.
 Error: Directory Photo, entry 0x3030 has invalid size 808464432*1; skipping entry.
@@ -74,11 +72,13 @@ Warning: Directory Photo, entry 0x3030 has unknown Exif (TIFF) type 12336; setti
 Error: Directory Photo, entry 0x3030 has invalid size 808452103*1; skipping entry.
 """
         + 3 * err_msg_dir_ph
-        + err_msg_dir_img
-        + """Warning: Directory Image, entry 0x3030 has unknown Exif (TIFF) type 12336; setting type size 1.
-Error: Directory Image, entry 0x3030 has invalid size 1414415696*1; skipping entry.
+        + """Warning: Directory Pentax has an unexpected next pointer; ignored.
 """
-        + 36 * err_msg_dir_img
+        + 6 * err_msg_dir_pentax
+        + """Warning: Directory Pentax, entry 0x0006 has unknown Exif (TIFF) type 12336; setting type size 1.
+Warning: Directory Pentax, entry 0x0007 has unknown Exif (TIFF) type 12336; setting type size 1.
+"""
+        + 39 * err_msg_dir_pentax
         + """Warning: JPEG format error, rc = 5
 """]
 
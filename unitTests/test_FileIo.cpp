@@ -2,11 +2,25 @@
 
 #include <gtest/gtest.h>
 #include "basicio.hpp"
+
+#include <algorithm>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
 using namespace Exiv2;
 
 namespace {
 constexpr auto imagePath = TESTDATA_PATH "/DSC_3079.jpg";
 constexpr auto nonExistingImagePath = TESTDATA_PATH "/nonExisting.jpg";
+
+DataBuf content(const std::string& path) {
+  FileIo file(path);
+  file.open();
+  DataBuf buf(file.size());
+  file.read(buf.data(), buf.size());
+  return buf;
+}
 }  // namespace
 
 TEST(AFileIO, canBeInstantiatedWithFilePath) {
@@ -77,3 +91,52 @@ TEST(AFileIO, canSeekBeyondEOF) {
   ASSERT_FALSE(file.error());
   ASSERT_FALSE(file.eof());
 }
+
+TEST(AFileIO, writesDataFromTheMappedAreaOfAnotherFile) {
+  FileIo source(imagePath);
+  ASSERT_EQ(0, source.open());
+  const byte* pMapped = source.mmap();
+  const auto original = content(imagePath);
+  const byte other[] = {1, 2, 3};
+
+  const std::string path("./fileio-write-mapped");
+  {
+    FileIo file(path);
+    ASSERT_EQ(0, file.open("w+b"));
+    // A large range in the middle, a small one and data which is not in the mapped area
+    ASSERT_EQ(100000U, file.write(source, pMapped + 1000, 100000));
+    ASSERT_EQ(10U, file.write(source, pMapped, 10));
+    ASSERT_EQ(3U, file.write(source, other, 3));
+    ASSERT_EQ(100013U, file.tell());
+  }
+  const auto written = content(path);
+  ASSERT_EQ(100013U, written.size());
+  const byte* p = written.c_data();
+  ASSERT_TRUE(std::equal(p, p + 100000, original.c_data(1000)));
+  ASSERT_TRUE(std::equal(p + 100000, p + 100010, original.c_data()));
+  ASSERT_TRUE(std::equal(p + 100010, p + 100013, other));
+  EXPECT_TRUE(fs::remove(path));
+}
+
+TEST(AFileIO, transferReplacesItsFileWithAnotherFile) {
+  const std::string path("./fileio-transfer");
+  const std::string tempPath("./fileio-transfer.tmp");
+  const byte before[] = {1, 2, 3, 4};
+  const byte after[] = {5, 6};
+  {
+    FileIo file(path);
+    ASSERT_EQ(0, file.open("w+b"));
+    file.write(before, sizeof(before));
+  }
+  FileIo file(path);
+  FileIo temp(tempPath);
+  ASSERT_EQ(0, temp.open("w+b"));
+  temp.write(after, sizeof(after));
+  ASSERT_NO_THROW(file.transfer(temp));
+
+  ASSERT_FALSE(fs::exists(tempPath));
+  const auto written = content(path);
+  ASSERT_EQ(sizeof(after), written.size());
+  ASSERT_TRUE(std::equal(written.c_data(), written.c_data() + written.size(), after));
+  EXPECT_TRUE(fs::remove(path));
+}
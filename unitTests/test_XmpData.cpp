@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <exiv2/exiv2.hpp>
+
+#include <algorithm>
+#include <string>
+
+using namespace Exiv2;
+
+namespace {
+// An XmpData with a few entries, one of them twice
+XmpData sample() {
+  XmpData xmpData;
+  xmpData["Xmp.dc.format"] = "image/jpeg";
+  xmpData["Xmp.xmp.Rating"] = "3";
+  xmpData["Xmp.dc.source"] = "first";
+  xmpData.add(XmpKey("Xmp.dc.source"), nullptr);
+  xmpData["Xmp.tiff.Make"] = "Camera Maker";
+  return xmpData;
+}
+
+long position(const XmpData& xmpData, const std::string& key) {
+  return std::distance(xmpData.begin(), xmpData.findKey(XmpKey(key)));
+}
+}  // namespace
+
+TEST(XmpData, findKeyReturnsTheFirstEntryWithTheKey) {
+  const XmpData xmpData = sample();
+  ASSERT_EQ(0, position(xmpData, "Xmp.dc.format"));
+  ASSERT_EQ(2, position(xmpData, "Xmp.dc.source"));
+  ASSERT_EQ("first", xmpData.findKey(XmpKey("Xmp.dc.source"))->toString());
+  ASSERT_EQ(xmpData.end(), xmpData.findKey(XmpKey("Xmp.dc.title")));
+}
+
+TEST(XmpData, findKeyFindsEntriesAddedLater) {
+  XmpData xmpData = sample();
+  ASSERT_EQ(xmpData.end(), xmpData.findKey(XmpKey("Xmp.dc.title")));
+  xmpData["Xmp.dc.title"] = "lang=x-default Title";
+  ASSERT_EQ(5, position(xmpData, "Xmp.dc.title"));
+  xmpData.add(XmpKey("Xmp.dc.format"), nullptr);
+  ASSERT_EQ(0, position(xmpData, "Xmp.dc.format"));
+  ASSERT_EQ(7, xmpData.count());
+}
+
+TEST(XmpData, operatorBracketsReturnsTheExistingEntry) {
+  XmpData xmpData = sample();
+  xmpData["Xmp.dc.source"] = "changed";
+  ASSERT_EQ(5, xmpData.count());
+  ASSERT_EQ("changed", xmpData.findKey(XmpKey("Xmp.dc.source"))->toString());
+}
+
+TEST(XmpData, findKeyFollowsErase) {
+  XmpData xmpData = sample();
+  ASSERT_EQ(2, position(xmpData, "Xmp.dc.source"));
+  xmpData.erase(xmpData.findKey(XmpKey("Xmp.dc.source")));
+  ASSERT_EQ(2, position(xmpData, "Xmp.dc.source"));
+  ASSERT_EQ(3, position(xmpData, "Xmp.tiff.Make"));
+  xmpData.erase(xmpData.findKey(XmpKey("Xmp.tiff.Make")));
+  xmpData["Xmp.dc.title"] = "lang=x-default Title";
+  ASSERT_EQ(xmpData.end(), xmpData.findKey(XmpKey("Xmp.tiff.Make")));
+  ASSERT_EQ(3, position(xmpData, "Xmp.dc.title"));
+}
+
+TEST(XmpData, findKeyFollowsSortAndClear) {
+  XmpData xmpData = sample();
+  ASSERT_EQ(0, position(xmpData, "Xmp.dc.format"));
+  xmpData.sortByKey();
+  ASSERT_EQ(0, position(xmpData, "Xmp.dc.format"));
+  ASSERT_EQ(3, position(xmpData, "Xmp.tiff.Make"));
+  ASSERT_EQ(4, position(xmpData, "Xmp.xmp.Rating"));
+  xmpData.clear();
+  ASSERT_EQ(xmpData.end(), xmpData.findKey(XmpKey("Xmp.dc.format")));
+}
+
+TEST(XmpData, findKeyFollowsAssignmentsThroughIterators) {
+  XmpData xmpData = sample();
+  ASSERT_EQ(1, position(xmpData, "Xmp.xmp.Rating"));
+  *(xmpData.begin() + 1) = Xmpdatum(XmpKey("Xmp.dc.title"));
+  ASSERT_EQ(xmpData.end(), xmpData.findKey(XmpKey("Xmp.xmp.Rating")));
+  ASSERT_EQ(1, position(xmpData, "Xmp.dc.title"));
+  std::reverse(xmpData.begin(), xmpData.end());
+  ASSERT_EQ(4, position(xmpData, "Xmp.dc.format"));
+  ASSERT_EQ(1, position(xmpData, "Xmp.dc.source"));
+}
+
+TEST(XmpData, findKeyFollowsAssignmentsThroughReferences) {
+  XmpData xmpData = sample();
+  xmpData["Xmp.xmp.Rating"] = Xmpdatum(XmpKey("Xmp.dc.source"));
+  ASSERT_EQ(xmpData.end(), xmpData.findKey(XmpKey("Xmp.xmp.Rating")));
+  ASSERT_EQ(1, position(xmpData, "Xmp.dc.source"));
+  *xmpData.findKey(XmpKey("Xmp.tiff.Make")) = Xmpdatum(XmpKey("Xmp.dc.format"));
+  ASSERT_EQ(0, position(xmpData, "Xmp.dc.format"));
+  ASSERT_EQ(xmpData.end(), xmpData.findKey(XmpKey("Xmp.tiff.Make")));
+  xmpData["Xmp.dc.source"] = "changed";
+  ASSERT_EQ(1, position(xmpData, "Xmp.dc.source"));
+}
+
+TEST(XmpData, findKeyFollowsAssignmentsThroughSeveralReferences) {
+  XmpData xmpData = sample();
+  xmpData["Xmp.dc.title"] = "lang=x-default Title";
+  auto& title = xmpData["Xmp.dc.title"];
+  auto& source = xmpData["Xmp.dc.source"];
+  title = Xmpdatum(XmpKey("Xmp.dc.rights"));
+  ASSERT_EQ(xmpData.end(), xmpData.findKey(XmpKey("Xmp.dc.title")));
+  ASSERT_EQ(5, position(xmpData, "Xmp.dc.rights"));
+  ASSERT_EQ("first", source.toString());
+
+  auto pos = xmpData.findKey(XmpKey("Xmp.dc.format"));
+  *++pos = Xmpdatum(XmpKey("Xmp.dc.subject"));
+  ASSERT_EQ(xmpData.end(), xmpData.findKey(XmpKey("Xmp.xmp.Rating")));
+  ASSERT_EQ(1, position(xmpData, "Xmp.dc.subject"));
+}
+
+TEST(XmpData, copiesFindTheirOwnEntries) {
+  XmpData xmpData = sample();
+  ASSERT_EQ(2, position(xmpData, "Xmp.dc.source"));
+  const XmpData copy = xmpData;
+  xmpData.erase(xmpData.begin());
+  ASSERT_EQ(2, position(copy, "Xmp.dc.source"));
+  ASSERT_EQ("first", copy.findKey(XmpKey("Xmp.dc.source"))->toString());
+  ASSERT_EQ(1, position(xmpData, "Xmp.dc.source"));
+}
+
+TEST(XmpData, movedEntriesKeepKeyAndValue) {
+  Xmpdatum xmpdatum(XmpKey("Xmp.dc.format"));
+  xmpdatum.setValue("image/jpeg");
+  Xmpdatum moved(std::move(xmpdatum));
+  ASSERT_EQ("Xmp.dc.format", moved.key());
+  ASSERT_EQ("image/jpeg", moved.toString());
+  xmpdatum = moved;
+  ASSERT_EQ("Xmp.dc.format", xmpdatum.key());
+
+  // Moved from by assignment, an entry holds the value of the one it was moved to
+  Xmpdatum other(XmpKey("Xmp.dc.title"));
+  other = std::move(moved);
+  ASSERT_EQ("Xmp.dc.format", other.key());
+  ASSERT_EQ("Xmp.dc.title", moved.key());
+}
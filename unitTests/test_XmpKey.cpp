@@ -76,3 +76,19 @@ TEST_F(AXmpKey, throwsWithNotRegisteredPrefix) {
 TEST_F(AXmpKey, throwsWithBadFormedKey) {
   ASSERT_THROW(XmpKey key(expectedProperty), std::exception);  // It should have the format ns.prefix.key
 }
+
+TEST_F(AXmpKey, throwsOnceThePrefixIsUnregistered) {
+  XmpProperties::registerNs("http://example.com/transient/", "transient");
+  XmpKey key("Xmp.transient.prop");
+  XmpProperties::unregisterNs("http://example.com/transient/");
+  ASSERT_THROW(XmpKey("Xmp.transient.prop"), std::exception);
+  ASSERT_EQ("Xmp.transient.prop", key.key());
+}
+
+TEST_F(AXmpKey, copyOutlivesTheOriginal) {
+  auto key = std::make_unique<XmpKey>("Xmp.prefix.a/prefix:property[1]/prefix:that/prefix:is/prefix:long");
+  const XmpKey copiedKey(*key);
+  key.reset();
+  ASSERT_EQ("Xmp.prefix.a/prefix:property[1]/prefix:that/prefix:is/prefix:long", copiedKey.key());
+  ASSERT_EQ("a/prefix:property[1]/prefix:that/prefix:is/prefix:long", copiedKey.tagName());
+}
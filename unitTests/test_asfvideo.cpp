@@ -54,3 +54,58 @@ TEST(AsfVideo, readMetadata) {
   ASSERT_FALSE(data.empty());
   ASSERT_EQ(xmpData["Xmp.video.TotalStream"].count(), 4u);
 }
+
+namespace {
+std::string le16(uint16_t v) {
+  return {static_cast<char>(v & 0xff), static_cast<char>(v >> 8)};
+}
+
+std::string le32(uint32_t v) {
+  return le16(static_cast<uint16_t>(v)) + le16(static_cast<uint16_t>(v >> 16));
+}
+
+std::string le64(uint64_t v) {
+  return le32(static_cast<uint32_t>(v)) + le32(static_cast<uint32_t>(v >> 32));
+}
+
+std::string guid(uint32_t d1, uint16_t d2, uint16_t d3, uint64_t d4) {
+  std::string g = le32(d1) + le16(d2) + le16(d3);
+  for (int shift = 56; shift >= 0; shift -= 8)
+    g += static_cast<char>((d4 >> shift) & 0xff);
+  return g;
+}
+
+std::string object(const std::string& id, const std::string& payload) {
+  return id + le64(24 + payload.size()) + payload;
+}
+
+// A null terminated UTF-16 string
+std::string wchars(const std::string& s) {
+  std::string w;
+  for (char c : s)
+    w += std::string(1, c) + '\0';
+  return w + std::string(2, '\0');
+}
+}  // namespace
+
+TEST(AsfVideo, readMetadataContinuesAfterEachHeaderObjectWhateverItsDecoderRead) {
+  const std::string name = wchars("WMV3");
+  const std::string description = wchars("Windows Media Video 9");
+  const std::string codecList =
+      object(guid(0x86D15240, 0x311D, 0x11D0, 0xA3A400A0C90348F6ULL),
+             std::string(16, '\0') + le32(1) + le16(1) + le16(static_cast<uint16_t>(name.size() / 2)) + name +
+                 le16(static_cast<uint16_t>(description.size() / 2)) + description + le16(4) + "WMV3");
+  const std::string title = wchars("Title");
+  const std::string contentDescription =
+      object(guid(0x75B22633, 0x668E, 0x11CF, 0xA6D900AA0062CE6CULL),
+             le16(static_cast<uint16_t>(title.size())) + le16(0) + le16(0) + le16(0) + le16(0) + title);
+  const std::string file = object(guid(0x75B22630, 0x668E, 0x11CF, 0xA6D900AA0062CE6CULL),
+                                  le32(2) + '\x01' + '\x02' + codecList + contentDescription) +
+                           object(guid(0x75B22636, 0x668E, 0x11CF, 0xA6D900AA0062CE6CULL),
+                                  std::string(16, '\0') + le64(1) + le16(0x0101) + std::string(1000, '\x55'));
+
+  auto io = std::make_unique<MemIo>(reinterpret_cast<const byte*>(file.data()), file.size());
+  AsfVideo asf(std::move(io), defaultImageCtorParams(false));
+  asf.readMetadata();
+  ASSERT_EQ("Title", asf.xmpData()["Xmp.video.Title"].toString());
+}
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <exiv2/basicio.hpp>
+#include <exiv2/bmffimage.hpp>
+#include <exiv2/exiv2.hpp>
+#include "unittest_utils.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace Exiv2;
+
+namespace {
+// The image, in memory
+Image::UniquePtr openCopy(const std::string& name) {
+  FileIo file((fs::path(TESTDATA_PATH) / name).string());
+  EXPECT_EQ(0, file.open());
+  const DataBuf data = file.read(file.size());
+  auto io = std::make_unique<MemIo>();
+  io->write(data.c_data(), data.size());
+  auto image = ImageFactory::open(std::move(io));
+  image->readMetadata();
+  return image;
+}
+
+// Read the metadata of what was written
+Image::UniquePtr reopen(const Image::UniquePtr& image) {
+  auto& io = image->io();
+  EXPECT_EQ(0, io.open());
+  const DataBuf data = io.read(io.size());
+  io.close();
+  auto copy = std::make_unique<MemIo>();
+  copy->write(data.c_data(), data.size());
+  auto reread = ImageFactory::open(std::move(copy));
+  reread->readMetadata();
+  return reread;
+}
+// The lengths of the first extents of the items in the iloc box of the image
+std::vector<uint64_t> extentLengths(const Image::UniquePtr& image) {
+  auto& io = image->io();
+  EXPECT_EQ(0, io.open());
+  const DataBuf data = io.read(io.size());
+  io.close();
+  const auto get = [&data](size_t pos, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i)
+      value = value << 8 | data.read_uint8(pos + i);
+    return value;
+  };
+  size_t pos = 0;
+  while (pos + 8 <= data.size() && get(pos, 4) != 0x696c6f63)  // "iloc"
+    ++pos;
+  pos -= 4;
+  const auto version = get(pos + 8, 1);
+  const auto sizes = get(pos + 12, 2);
+  const size_t offsetSize = sizes >> 12;
+  const size_t lengthSize = sizes >> 8 & 0xf;
+  const size_t baseOffsetSize = sizes >> 4 & 0xf;
+  const size_t indexSize = version == 1 || version == 2 ? sizes & 0xf : 0;
+  const size_t idSize = version < 2 ? 2 : 4;
+  auto count = get(pos + 14, idSize);
+  pos += 14 + idSize;
+  std::vector<uint64_t> lengths;
+  while (count-- > 0) {
+    pos += idSize + (version == 1 || version == 2 ? 2 : 0) + 2 + baseOffsetSize;
+    const auto extents = get(pos, 2);
+    pos += 2;
+    for (uint64_t i = 0; i < extents; ++i) {
+      if (i == 0)
+        lengths.push_back(get(pos + indexSize + offsetSize, lengthSize));
+      pos += indexSize + offsetSize + lengthSize;
+    }
+  }
+  return lengths;
+}
+}  // namespace
+
+TEST(BmffImage, writesMetadataWhichFitsInPlace) {
+  auto image = openCopy("Stonehenge.heic");
+  const size_t size = image->io().size();
+  image->exifData()["Exif.Image.Model"] = "M";
+  // The packet as it was, the toolkit serializes it larger
+  image->writeXmpFromPacket(true);
+  image->writeMetadata();
+  ASSERT_EQ(size, image->io().size());
+
+  auto reread = reopen(image);
+  ASSERT_EQ("M", reread->exifData()["Exif.Image.Model"].toString());
+  ASSERT_EQ("18.0-250.0 mm f/3.5-6.3", reread->xmpData()["Xmp.aux.Lens"].toString());
+}
+
+TEST(BmffImage, appendsMetadataWhichDoesNotFit) {
+  auto image = openCopy("avif_exif_xmp.avif");
+  const size_t size = image->io().size();
+  const std::string comment(5000, 'x');
+  image->exifData()["Exif.Photo.UserComment"] = comment;
+  image->xmpData()["Xmp.dc.description"] = comment;
+  image->writeMetadata();
+  ASSERT_LT(size, image->io().size());
+
+  auto reread = reopen(image);
+  ASSERT_EQ(image->exifData()["Exif.Photo.UserComment"].toString(),
+            reread->exifData()["Exif.Photo.UserComment"].toString());
+  ASSERT_EQ(image->xmpData()["Xmp.dc.description"].toString(), reread->xmpData()["Xmp.dc.description"].toString());
+  ASSERT_EQ(image->exifData().count(), reread->exifData().count());
+
+  // Writing again fits where the items are now
+  const size_t grown = image->io().size();
+  image->writeMetadata();
+  ASSERT_EQ(grown, image->io().size());
+}
+
+TEST(BmffImage, doesNotWriteToImagesWithoutMetadataItems) {
+  auto image = openCopy("Canon-R6-pruned.CR3");
+  ASSERT_THROW(image->writeMetadata(), Error);
+}
+
+TEST(BmffImage, keepsItemsWhichAreClearedValid) {
+  auto image = openCopy("avif_exif_xmp.avif");
+  image->clearExifData();
+  image->clearXmpData();
+  image->writeMetadata();
+  const auto lengths = extentLengths(image);
+  ASSERT_FALSE(lengths.empty());
+  for (auto length : lengths)
+    ASSERT_NE(0u, length);
+
+  auto reread = reopen(image);
+  ASSERT_TRUE(reread->exifData().empty());
+  ASSERT_TRUE(reread->xmpData().empty());
+}
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <exiv2/exiv2.hpp>
+
+#include <string>
+
+using namespace Exiv2;
+
+namespace {
+ExifData sample() {
+  ExifData exifData;
+  exifData["Exif.Image.Make"] = "Camera Maker";
+  exifData["Exif.Image.Model"] = "Camera 1";
+  exifData["Exif.Photo.DateTimeOriginal"] = "2024:01:02 03:04:05";
+  exifData["Exif.Photo.SubSecTimeOriginal"] = "12";
+  return exifData;
+}
+
+std::string xmpValue(const XmpData& xmpData, const std::string& key) {
+  auto pos = xmpData.findKey(XmpKey(key));
+  return pos == xmpData.end() ? "" : pos->toString();
+}
+}  // namespace
+
+TEST(ChangeLog, recordsKeysOnceTheGenerationWasTaken) {
+  ChangeLog changes;
+  changes.touch("Exif.Image.Make");
+  const auto since = changes.generation();
+  ASSERT_FALSE(changes.allChangedSince(since));
+  ASSERT_TRUE(changes.allChangedSince(0));
+  changes.touch("Exif.Image.Model");
+  ASSERT_EQ(std::vector<std::string>{"Exif.Image.Model"}, changes.changedSince(since));
+  changes.touchAll();
+  ASSERT_TRUE(changes.allChangedSince(since));
+  ASSERT_TRUE(changes.changedSince(since).empty());
+}
+
+TEST(ChangeLog, assignedContainersCountAsAllChanged) {
+  ExifData exifData = sample();
+  const auto since = exifData.generation();
+  exifData = sample();
+  XmpData xmpData;
+  ASSERT_LT(since, copyExifToXmp(exifData, xmpData, since));
+  ASSERT_EQ("Camera 1", xmpValue(xmpData, "Xmp.tiff.Model"));
+}
+
+TEST(IncrementalConversion, convertsOnlyTheExifTagsThatChanged) {
+  ExifData exifData = sample();
+  XmpData xmpData;
+  auto since = copyExifToXmp(exifData, xmpData, 0);
+  ASSERT_EQ("Camera Maker", xmpValue(xmpData, "Xmp.tiff.Make"));
+  ASSERT_EQ("2024-01-02T03:04:05.12", xmpValue(xmpData, "Xmp.photoshop.DateCreated"));
+
+  // A conversion would overwrite the model
+  xmpData["Xmp.tiff.Model"] = "Edited";
+  exifData["Exif.Image.Make"] = "Other Maker";
+  since = copyExifToXmp(exifData, xmpData, since);
+  ASSERT_EQ("Other Maker", xmpValue(xmpData, "Xmp.tiff.Make"));
+  ASSERT_EQ("Edited", xmpValue(xmpData, "Xmp.tiff.Model"));
+
+  // Nothing changed
+  xmpData["Xmp.tiff.Make"] = "Edited";
+  since = copyExifToXmp(exifData, xmpData, since);
+  ASSERT_EQ("Edited", xmpValue(xmpData, "Xmp.tiff.Make"));
+
+  // The subseconds are part of the date
+  exifData.findKey(ExifKey("Exif.Photo.SubSecTimeOriginal"))->setValue("34");
+  since = copyExifToXmp(exifData, xmpData, since);
+  ASSERT_EQ("2024-01-02T03:04:05.34", xmpValue(xmpData, "Xmp.photoshop.DateCreated"));
+  ASSERT_EQ("Edited", xmpValue(xmpData, "Xmp.tiff.Make"));
+
+  // A mutable iterator may change anything
+  exifData.begin()->setValue("Third Maker");
+  copyExifToXmp(exifData, xmpData, since);
+  ASSERT_EQ("Third Maker", xmpValue(xmpData, "Xmp.tiff.Make"));
+  ASSERT_EQ("Camera 1", xmpValue(xmpData, "Xmp.tiff.Model"));
+}
+
+TEST(IncrementalConversion, convertsOnlyTheXmpPropertiesThatChanged) {
+  XmpData xmpData;
+  xmpData["Xmp.tiff.Make"] = "Camera Maker";
+  xmpData["Xmp.exif.Flash/exif:Fired"] = "False";
+  xmpData["Xmp.exif.Flash/exif:Return"] = "0";
+  xmpData["Xmp.exif.Flash/exif:Mode"] = "0";
+  xmpData["Xmp.exif.Flash/exif:Function"] = "False";
+  xmpData["Xmp.exif.Flash/exif:RedEyeMode"] = "False";
+  ExifData exifData;
+  auto since = copyXmpToExif(xmpData, exifData, 0);
+  ASSERT_EQ("Camera Maker", exifData["Exif.Image.Make"].toString());
+  ASSERT_EQ(0, exifData["Exif.Photo.Flash"].toInt64());
+
+  exifData["Exif.Image.Make"] = "Edited";
+  xmpData["Xmp.exif.Flash/exif:Fired"] = "True";
+  copyXmpToExif(xmpData, exifData, since);
+  ASSERT_EQ(1, exifData["Exif.Photo.Flash"].toInt64());
+  ASSERT_EQ("Edited", exifData["Exif.Image.Make"].toString());
+}
+
+TEST(IncrementalConversion, convertsOnlyTheIptcDatasetsThatChanged) {
+  IptcData iptcData;
+  iptcData["Iptc.Application2.City"] = "Paris";
+  iptcData["Iptc.Application2.Headline"] = "Headline";
+  XmpData xmpData;
+  auto since = copyIptcToXmp(iptcData, xmpData, "UTF-8", 0);
+  ASSERT_EQ("Paris", xmpValue(xmpData, "Xmp.photoshop.City"));
+
+  xmpData["Xmp.photoshop.Headline"] = "Edited";
+  iptcData["Iptc.Application2.City"] = "Rome";
+  since = copyIptcToXmp(iptcData, xmpData, "UTF-8", since);
+  ASSERT_EQ("Rome", xmpValue(xmpData, "Xmp.photoshop.City"));
+  ASSERT_EQ("Edited", xmpValue(xmpData, "Xmp.photoshop.Headline"));
+
+  IptcData target;
+  since = copyXmpToIptc(xmpData, target, 0);
+  ASSERT_EQ("Edited", target["Iptc.Application2.Headline"].toString());
+  target.clear();
+  xmpData["Xmp.photoshop.City"] = "Oslo";
+  copyXmpToIptc(xmpData, target, since);
+  ASSERT_EQ("Oslo", target["Iptc.Application2.City"].toString());
+  ASSERT_EQ(target.end(), target.findKey(IptcKey("Iptc.Application2.Headline")));
+}
+
+TEST(ExifDigest, isTheDigestTheXmpToolkitWrites) {
+  ExifData exifData = sample();
+  exifData["Exif.GPSInfo.GPSAltitude"] = "100/1";
+  XmpData xmpData;
+  syncExifWithXmp(exifData, xmpData);
+  const auto tiff = xmpValue(xmpData, "Xmp.tiff.NativeDigest");
+  const auto exif = xmpValue(xmpData, "Xmp.exif.NativeDigest");
+  ASSERT_EQ(0, tiff.rfind("256,257,258,", 0));
+  ASSERT_EQ("F965526B36E1023736F47B4ABBC38ACC", tiff.substr(tiff.find(';') + 1));
+  ASSERT_EQ(0, exif.rfind("36864,40960,", 0));
+  ASSERT_EQ("EBE29082B194C35DC17B9213B3BEFEA0", exif.substr(exif.find(';') + 1));
+
+  // XMP is up to date, so it is converted back to Exif
+  xmpData["Xmp.tiff.Model"] = "Edited";
+  syncExifWithXmp(exifData, xmpData);
+  ASSERT_EQ("Edited", exifData.findKey(ExifKey("Exif.Image.Model"))->toString());
+  ASSERT_NE(tiff, xmpValue(xmpData, "Xmp.tiff.NativeDigest"));
+  ASSERT_EQ(exif, xmpValue(xmpData, "Xmp.exif.NativeDigest"));
+
+  // Exif changed after XMP, so it is converted to XMP
+  exifData["Exif.Image.Make"] = "Other Maker";
+  syncExifWithXmp(exifData, xmpData);
+  ASSERT_EQ("Other Maker", xmpValue(xmpData, "Xmp.tiff.Make"));
+}
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <exiv2/basicio.hpp>
+#include <exiv2/exif.hpp>
+#include <exiv2/image.hpp>
+#include <exiv2/tags.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Exiv2;
+
+namespace {
+constexpr auto imagePath = TESTDATA_PATH "/exiv2-bug1114.jpg";  // Nikon makernote
+
+using Entries = std::vector<std::pair<std::string, std::string>>;
+
+Entries entries(const ExifData& exifData) {
+  Entries ret;
+  for (auto&& md : exifData) {
+    ret.emplace_back(md.key(), md.toString());
+  }
+  return ret;
+}
+
+Image::UniquePtr readImage(const byte* data, size_t size, bool lazy) {
+  auto image = ImageFactory::open(data, size);
+  image->lazyMakernotes(lazy);
+  image->readMetadata();
+  return image;
+}
+
+DataBuf readFile(const char* path) {
+  FileIo file(path);
+  file.open();
+  DataBuf buf(file.size());
+  file.read(buf.data(), buf.size());
+  return buf;
+}
+
+DataBuf content(BasicIo& io) {
+  io.open();
+  DataBuf buf(io.size());
+  io.read(buf.data(), buf.size());
+  io.close();
+  return buf;
+}
+}  // namespace
+
+TEST(ALazyMakernote, expandsToTheSameEntriesAsAnEagerDecode) {
+  const auto file = readFile(imagePath);
+  auto eager = readImage(file.c_data(), file.size(), false);
+  auto lazy = readImage(file.c_data(), file.size(), true);
+  ASSERT_EQ(entries(eager->exifData()), entries(lazy->exifData()));
+}
+
+TEST(ALazyMakernote, isExpandedByTheFirstLookupOfAMakernoteKey) {
+  const auto file = readFile(imagePath);
+  auto image = readImage(file.c_data(), file.size(), true);
+  const auto& exifData = std::as_const(*image).exifData();
+  ASSERT_NE(exifData.findKey(ExifKey("Exif.Image.Make")), exifData.end());
+  auto pos = exifData.findKey(ExifKey("Exif.Nikon3.Version"));
+  ASSERT_NE(pos, exifData.end());
+  // Right after the binary makernote tag and the synthesized makernote tags
+  ASSERT_EQ("Exif.Photo.MakerNote", std::prev(pos, 3)->key());
+}
+
+TEST(ALazyMakernote, isDroppedByClear) {
+  const auto file = readFile(imagePath);
+  auto image = readImage(file.c_data(), file.size(), true);
+  image->exifData().clear();
+  ASSERT_TRUE(image->exifData().empty());
+  ASSERT_EQ(0U, image->exifData().count());
+}
+
+TEST(ALazyMakernote, isWrittenBackUnchangedIfItWasNotExpanded) {
+  const auto file = readFile(imagePath);
+  auto image = readImage(file.c_data(), file.size(), true);
+  auto pos = image->exifData().findKey(ExifKey("Exif.Photo.ExposureTime"));
+  ASSERT_NE(pos, image->exifData().end());
+  pos->setValue("1/30");
+  image->writeMetadata();
+
+  // Including the binary makernote tag, which holds the original makernote bytes
+  const auto written = content(image->io());
+  auto original = readImage(file.c_data(), file.size(), false);
+  auto reread = readImage(written.c_data(), written.size(), false);
+  auto expected = entries(original->exifData());
+  for (auto&& [key, value] : expected) {
+    if (key == "Exif.Photo.ExposureTime")
+      value = "1/30";
+  }
+  ASSERT_EQ(expected, entries(reread->exifData()));
+}
+
+TEST(ALazyMakernote, isWrittenLikeAnEagerlyDecodedOneByAnIntrusiveWrite) {
+  const auto file = readFile(imagePath);
+  Entries results[2];
+  for (bool lazy : {false, true}) {
+    auto image = readImage(file.c_data(), file.size(), lazy);
+    image->exifData()["Exif.Image.ImageDescription"] = "Adds an IFD0 entry";
+    image->writeMetadata();
+
+    const auto written = content(image->io());
+    auto reread = readImage(written.c_data(), written.size(), false);
+    results[lazy] = entries(reread->exifData());
+  }
+  ASSERT_EQ(results[0], results[1]);
+}
+
+TEST(ALazyMakernote, writesModifiedMakernoteTags) {
+  const auto file = readFile(imagePath);
+  auto image = readImage(file.c_data(), file.size(), true);
+  image->exifData()["Exif.Nikon3.Quality"] = "FINE";
+  image->writeMetadata();
+
+  const auto written = content(image->io());
+  auto reread = readImage(written.c_data(), written.size(), false);
+  auto pos = reread->exifData().findKey(ExifKey("Exif.Nikon3.Quality"));
+  ASSERT_NE(pos, reread->exifData().end());
+  ASSERT_EQ("FINE", pos->toString());
+  ASSERT_NE(reread->exifData().findKey(ExifKey("Exif.Nikon3.Version")), reread->exifData().end());
+}
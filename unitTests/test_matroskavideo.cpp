@@ -6,8 +6,69 @@
 #include <exiv2/matroskavideo.hpp>
 #include "unittest_utils.hpp"
 
+#include <string>
+#include <vector>
+
 using namespace Exiv2;
 
+namespace {
+using Bytes = std::vector<byte>;
+
+// An EBML element with a one byte size
+Bytes element(Bytes id, const Bytes& data) {
+  id.push_back(static_cast<byte>(0x80 | data.size()));
+  id.insert(id.end(), data.begin(), data.end());
+  return id;
+}
+
+Bytes concat(std::initializer_list<Bytes> parts) {
+  Bytes result;
+  for (auto& part : parts)
+    result.insert(result.end(), part.begin(), part.end());
+  return result;
+}
+
+Bytes bigEndian64(uint64_t value) {
+  Bytes result(8);
+  for (size_t i = 0; i < 8; ++i)
+    result[7 - i] = static_cast<byte>(value >> (8 * i));
+  return result;
+}
+
+Bytes text(const std::string& s) {
+  return {s.begin(), s.end()};
+}
+
+// The EBML header of a WebM file and the header of a segment of unknown size
+const Bytes fileHeader = concat({element({0x1a, 0x45, 0xdf, 0xa3}, element({0x42, 0x82}, text("webm"))),
+                                 {0x18, 0x53, 0x80, 0x67, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}});
+const Bytes cluster = element({0x1f, 0x43, 0xb6, 0x75}, Bytes(100, 0xff));
+const Bytes info = element({0x15, 0x49, 0xa9, 0x66}, element({0x7b, 0xa9}, text("Title")));
+const Bytes tracks =
+    element({0x16, 0x54, 0xae, 0x6b},
+            element({0xae}, element({0xe0}, concat({element({0xb0}, bigEndian64(640)),
+                                                    element({0xba}, bigEndian64(480))}))));
+const Bytes tags = element({0x12, 0x54, 0xc3, 0x67},
+                           element({0x73, 0x73}, element({0x67, 0xc8}, element({0x45, 0xa3}, text("ARTIST")))));
+
+// A SeekHead with entries for the elements at the given positions in the segment
+Bytes seekHead(std::initializer_list<std::pair<Bytes, uint32_t>> entries) {
+  Bytes seeks;
+  for (auto& [id, position] : entries) {
+    const Bytes pos{static_cast<byte>(position >> 24), static_cast<byte>(position >> 16),
+                    static_cast<byte>(position >> 8), static_cast<byte>(position)};
+    seeks = concat({seeks, element({0x4d, 0xbb}, concat({element({0x53, 0xab}, id), element({0x53, 0xac}, pos)}))});
+  }
+  return element({0x11, 0x4d, 0x9b, 0x74}, seeks);
+}
+
+XmpData readXmp(const Bytes& file) {
+  MatroskaVideo mkv(std::make_unique<MemIo>(file.data(), file.size()), defaultImageCtorParams(false));
+  mkv.readMetadata();
+  return mkv.xmpData();
+}
+}  // namespace
+
 TEST(MatroskaVideo, canBeOpenedWithEmptyMemIo) {
   auto memIo = std::make_unique<MemIo>();
   ASSERT_NO_THROW(MatroskaVideo mkv(std::move(memIo), defaultImageCtorParams(false)));
@@ -54,3 +115,32 @@ TEST(MatroskaVideo, readMetadata) {
   ASSERT_FALSE(data.empty());
   ASSERT_EQ(xmpData["Xmp.video.TotalStream"].count(), 4u);
 }
+
+TEST(MatroskaVideo, readMetadataFindsElementsAfterTheClustersThroughTheSeekHead) {
+  // Each Seek is 3 + 7 + 7 bytes long, the header of the SeekHead 5
+  const uint32_t first = 5 + 3 * 17;
+  const uint32_t tracksPos = first + static_cast<uint32_t>(cluster.size() + info.size());
+  const Bytes file =
+      concat({fileHeader,
+              seekHead({{{0x15, 0x49, 0xa9, 0x66}, first + static_cast<uint32_t>(cluster.size())},
+                        {{0x16, 0x54, 0xae, 0x6b}, tracksPos},
+                        {{0x12, 0x54, 0xc3, 0x67}, tracksPos + static_cast<uint32_t>(tracks.size())}}),
+              cluster, info, tracks, tags});
+
+  auto xmpData = readXmp(file);
+  ASSERT_EQ("webm", xmpData["Xmp.video.DocType"].toString());
+  ASSERT_EQ("Title", xmpData["Xmp.video.Title"].toString());
+  ASSERT_EQ(640, xmpData["Xmp.video.Width"].toInt64());
+  ASSERT_EQ(480, xmpData["Xmp.video.Height"].toInt64());
+  ASSERT_EQ("4:3", xmpData["Xmp.video.AspectRatio"].toString());
+  ASSERT_EQ("ARTIST", xmpData["Xmp.video.TagName"].toString());
+}
+
+TEST(MatroskaVideo, readMetadataScansUpToTheFirstClusterWithoutSeekHead) {
+  const Bytes file = concat({fileHeader, info, tracks, cluster, tags});
+
+  auto xmpData = readXmp(file);
+  ASSERT_EQ("Title", xmpData["Xmp.video.Title"].toString());
+  ASSERT_EQ(640, xmpData["Xmp.video.Width"].toInt64());
+  ASSERT_TRUE(xmpData.findKey(XmpKey("Xmp.video.TagName")) == xmpData.end());
+}
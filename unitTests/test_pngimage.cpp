@@ -9,11 +9,58 @@
 
 #include <algorithm>
 #include <array>
+#include <filesystem>
 #include <memory>
 #include <sstream>
+#include <string>
+#include <vector>
 
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace fs = std::filesystem;
 using namespace Exiv2;
 
+namespace {
+// The file from its first IDAT chunk to the end
+std::string imageData(const std::string& path) {
+  FileIo file(path);
+  EXPECT_EQ(0, file.open());
+  const DataBuf buf = file.read(file.size());
+  const std::string data(buf.c_str(), buf.size());
+  const auto pos = data.find("IDAT");
+  EXPECT_NE(std::string::npos, pos);
+  return data.substr(pos - 4);
+}
+
+// Append a chunk of type and data to png, with its CRC
+void appendChunk(std::string& png, const std::string& type, const std::string& data) {
+  uint32_t crc = 0xffffffff;
+  for (const auto c : type + data) {
+    crc ^= static_cast<unsigned char>(c);
+    for (int k = 0; k < 8; ++k)
+      crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+  }
+  crc ^= 0xffffffff;
+  byte buf[4];
+  ul2Data(buf, static_cast<uint32_t>(data.size()), bigEndian);
+  png.append(reinterpret_cast<const char*>(buf), 4);
+  png += type + data;
+  ul2Data(buf, crc, bigEndian);
+  png.append(reinterpret_cast<const char*>(buf), 4);
+}
+
+// Read the metadata of png with CRC checks
+std::vector<PngChunkCheck> checkChunks(const std::string& png) {
+  PngImage image(std::make_unique<MemIo>(reinterpret_cast<const byte*>(png.data()), png.size()),
+                 defaultImageCtorParams(false));
+  image.setVerifyChunks(true);
+  image.readMetadata();
+  return image.chunkChecks();
+}
+}  // namespace
+
 TEST(PngChunk, keyTxtChunkExtractsKeywordCorrectlyInPresenceOfNullChar) {
   // The following data is: '\0\0"AzTXtRaw profile type exif\0\0x'
   const std::array<std::uint8_t, 32> data{0x00, 0x00, 0x22, 0x41, 0x7a, 0x54, 0x58, 0x74, 0x52, 0x61, 0x77,
@@ -126,6 +173,114 @@ TEST(PngImage, canWriteMetadataFromCreatedPngImage) {
   ASSERT_NO_THROW(png.writeMetadata());
 }
 
+TEST(PngImage, readsCompressedTextUpToTheMaxInflatedSize) {
+  PngImage png(std::make_unique<MemIo>(), defaultImageCtorParams(true));
+  const std::string comment(300000, 'x');
+  png.setComment(comment);
+  png.writeMetadata();
+  png.readMetadata();
+  ASSERT_EQ(comment, png.comment());
+
+  png.setMaxInflatedSize(comment.size() - 1);
+  ASSERT_THROW(png.readMetadata(), Exiv2::Error);
+}
+
+TEST(PngImage, skipsIccProfilesLargerThanTheMaxInflatedSize) {
+  PngImage png(std::make_unique<MemIo>(), defaultImageCtorParams(true));
+  png.setIccProfile(DataBuf(100000), false);
+  png.writeMetadata();
+  png.readMetadata();
+  ASSERT_EQ(100000u, png.iccProfile().size());
+
+  png.setMaxInflatedSize(1000);
+  png.readMetadata();
+  ASSERT_TRUE(png.iccProfile().empty());
+}
+
+TEST(PngImage, copiesTheImageDataAsItIsWhenWritingMetadata) {
+  const std::string source(TESTDATA_PATH "/ReaganLargePng.png");
+  const std::string path("./pngimage-write.png");
+  fs::copy_file(source, path, fs::copy_options::overwrite_existing);
+  auto image = ImageFactory::open(path);
+  image->readMetadata();
+  image->setComment("A comment");
+  image->exifData()["Exif.Image.Model"] = "A model";
+  image->writeMetadata();
+
+  ASSERT_EQ(imageData(source), imageData(path));
+  auto reread = ImageFactory::open(path);
+  reread->readMetadata();
+  ASSERT_EQ("A comment", reread->comment());
+  ASSERT_EQ("A model", reread->exifData()["Exif.Image.Model"].toString());
+  EXPECT_TRUE(fs::remove(path));
+}
+
+#ifndef _WIN32
+TEST(PngImage, keepsThePermissionsAndTheOwnerOfTheFileWithoutWarnings) {
+  const std::string path("./pngimage-permissions.png");
+  fs::copy_file(TESTDATA_PATH "/ReaganLargePng.png", path, fs::copy_options::overwrite_existing);
+  const auto perms = fs::perms::owner_read | fs::perms::owner_write | fs::perms::group_read;
+  fs::permissions(path, perms);
+  struct stat before{};
+  ASSERT_EQ(0, ::stat(path.c_str(), &before));
+
+  static std::vector<std::string> logged;
+  logged.clear();
+  const auto handler = LogMsg::handler();
+  LogMsg::setHandler([](int, const char* msg) { logged.emplace_back(msg); });
+  auto image = ImageFactory::open(path);
+  image->readMetadata();
+  image->setComment("A comment");
+  image->writeMetadata();
+  LogMsg::setHandler(handler);
+
+  ASSERT_TRUE(logged.empty()) << logged.front();
+  ASSERT_EQ(perms, fs::status(path).permissions());
+  struct stat after{};
+  ASSERT_EQ(0, ::stat(path.c_str(), &after));
+  ASSERT_EQ(before.st_uid, after.st_uid);
+  ASSERT_EQ(before.st_gid, after.st_gid);
+  EXPECT_TRUE(fs::remove(path));
+}
+#endif
+
+TEST(PngImage, checksNoCrcsByDefault) {
+  PngImage png(std::make_unique<MemIo>(), defaultImageCtorParams(true));
+  png.readMetadata();
+  ASSERT_FALSE(png.verifyChunks());
+  ASSERT_TRUE(png.chunkChecks().empty());
+}
+
+TEST(PngImage, checksTheCrcOfEveryChunk) {
+  // Chunks which are checked in pieces on this thread, and on several threads
+  for (size_t size : {3 * 1024 * 1024 + 5, 9 * 1024 * 1024 + 5}) {
+    // The signature and IHDR of a 1x1 image, a chunk which is checked in pieces, and IEND
+    std::string png("\x89PNG\r\n\x1a\n", 8);
+    appendChunk(png, "IHDR", std::string("\0\0\0\x01\0\0\0\x01\x08\x02\0\0\0", 13));
+    std::string large(size, 'a');
+    for (size_t i = 0; i < large.size(); i += 4099)
+      large[i] = static_cast<char>(i);
+    appendChunk(png, "prVt", large);
+    appendChunk(png, "IEND", "");
+
+    auto checks = checkChunks(png);
+    ASSERT_EQ(3u, checks.size());
+    ASSERT_EQ("IHDR", checks[0].type_);
+    ASSERT_EQ("prVt", checks[1].type_);
+    ASSERT_EQ(33u, checks[1].offset_);
+    ASSERT_EQ(large.size(), checks[1].length_);
+    ASSERT_EQ("IEND", checks[2].type_);
+    for (const auto& check : checks)
+      ASSERT_TRUE(check.ok()) << check.type_;
+
+    png[33 + 8 + 2 * 1024 * 1024 + 17] ^= 1;
+    checks = checkChunks(png);
+    ASSERT_TRUE(checks[0].ok());
+    ASSERT_FALSE(checks[1].ok());
+    ASSERT_TRUE(checks[2].ok());
+  }
+}
+
 TEST(PngImage, cannotWriteMetadataToIoWhichCannotBeOpened) {
   auto memIo = std::make_unique<FileIo>("NonExistingPath.png");
   PngImage png(std::move(memIo), defaultImageCtorParams(false));
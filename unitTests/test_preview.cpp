@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <exiv2/basicio.hpp>
+#include <exiv2/error.hpp>
+#include <exiv2/image.hpp>
+#include <exiv2/preview.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+
+using namespace Exiv2;
+
+namespace {
+// Compare the sizes listed by getPreviewProperties() with the sizes of the extracted preview images
+void expectListedSizes(const std::string& path, size_t previews) {
+  auto image = ImageFactory::open(path);
+  image->readMetadata();
+  PreviewManager manager(*image);
+  const auto list = manager.getPreviewProperties();
+  ASSERT_EQ(previews, list.size()) << path;
+  for (auto&& properties : list) {
+    EXPECT_NE(0U, properties.size_) << path << ", preview " << properties.id_;
+    EXPECT_EQ(manager.getPreviewImage(properties).size(), properties.size_) << path << ", preview " << properties.id_;
+  }
+}
+
+bool sameData(const PreviewImage& lhs, const PreviewImage& rhs) {
+  return lhs.size() == rhs.size() && std::equal(lhs.pData(), lhs.pData() + lhs.size(), rhs.pData());
+}
+}  // namespace
+
+TEST(APreviewManager, listsTheSizeOfTiffPreviews) {
+  expectListedSizes(TESTDATA_PATH "/IMG_1361.dng", 1);
+  expectListedSizes(TESTDATA_PATH "/ReaganLargeTiff.tiff", 1);
+  expectListedSizes(TESTDATA_PATH "/exiv2-kodak-dc210.jpg", 1);
+}
+
+TEST(APreviewManager, listsTheSizeOfNativePreviews) {
+#ifdef EXV_ENABLE_BMFF
+  expectListedSizes(TESTDATA_PATH "/Canon-R6-pruned.CR3", 2);
+#endif
+  expectListedSizes(TESTDATA_PATH "/exiv2-bug836.eps", 1);
+}
+
+#ifdef EXV_HAVE_XMP_TOOLKIT
+TEST(APreviewManager, listsTheSizeOfXmpPreviews) {
+  expectListedSizes(TESTDATA_PATH "/exiv2-pre-in-xmp.xmp", 1);
+}
+#endif
+
+TEST(APreviewManager, returnsAViewOfAPreviewStoredInOnePiece) {
+  auto image = ImageFactory::open(TESTDATA_PATH "/exiv2-bug836.eps");
+  image->readMetadata();
+  PreviewManager manager(*image);
+  const auto list = manager.getPreviewProperties();
+  ASSERT_EQ(1U, list.size());
+
+  const auto view = manager.getPreviewView(list[0]);
+  const auto preview = manager.getPreviewImage(list[0]);
+  ASSERT_TRUE(view.isView());
+  ASSERT_FALSE(preview.isView());
+  ASSERT_EQ(26471U, view.offset());
+  ASSERT_TRUE(sameData(preview, view));
+
+  // The views of a manager share one mapping of the file
+  const auto again = manager.getPreviewView(list[0]);
+  ASSERT_EQ(view.pData(), again.pData());
+
+  // The view doesn't depend on the state of the image
+  image->io().close();
+  const PreviewImage copy(view);
+  ASSERT_TRUE(copy.isView());
+  ASSERT_EQ(view.pData(), copy.pData());
+  ASSERT_TRUE(sameData(preview, copy));
+}
+
+TEST(APreviewManager, returnsACopyOfAPreviewThatIsCreated) {
+  auto image = ImageFactory::open(TESTDATA_PATH "/exiv2-kodak-dc210.jpg");
+  image->readMetadata();
+  PreviewManager manager(*image);
+  const auto list = manager.getPreviewProperties();
+  ASSERT_EQ(1U, list.size());
+
+  const auto view = manager.getPreviewView(list[0]);
+  ASSERT_FALSE(view.isView());
+  ASSERT_TRUE(sameData(manager.getPreviewImage(list[0]), view));
+}
+
+TEST(APreviewImage, writesAViewToAFile) {
+  auto image = ImageFactory::open(TESTDATA_PATH "/exiv2-bug836.eps");
+  image->readMetadata();
+  PreviewManager manager(*image);
+  const auto view = manager.getPreviewView(manager.getPreviewProperties().at(0));
+  ASSERT_TRUE(view.isView());
+
+  const std::string path("./preview-view.tif");
+  {
+    FileIo file(path);
+    ASSERT_EQ(0, file.open("wb"));
+    ASSERT_EQ(1U, file.write(reinterpret_cast<const byte*>("x"), 1));
+    ASSERT_EQ(view.size(), view.writeTo(file));
+  }
+  FileIo file(path);
+  ASSERT_EQ(0, file.open());
+  ASSERT_EQ(view.size() + 1U, file.size());
+  DataBuf buf(file.size());
+  ASSERT_EQ(buf.size(), file.read(buf.data(), buf.size()));
+  ASSERT_EQ('x', buf.read_uint8(0));
+  ASSERT_EQ(0, buf.cmpBytes(1, view.pData(), view.size()));
+  file.close();
+  EXPECT_TRUE(fs::remove(path));
+}
+
+#ifdef EXV_ENABLE_FILESYSTEM
+TEST(APreviewIndex, readsThePreviewImagesOfTheFileItWasCreatedFor) {
+  const std::string path(TESTDATA_PATH "/exiv2-bug836.eps");
+  auto image = ImageFactory::open(path);
+  image->readMetadata();
+  PreviewManager manager(*image);
+  const auto list = manager.getPreviewProperties();
+  const auto record = manager.getPreviewIndex();
+
+  const PreviewIndex index(record.c_data(), record.size());
+  ASSERT_TRUE(index.matches(path));
+  ASSERT_EQ(list.size(), index.getPreviewProperties().size());
+  const auto& properties = index.getPreviewProperties().at(0);
+  ASSERT_EQ(list[0].id_, properties.id_);
+  ASSERT_EQ(list[0].size_, properties.size_);
+  ASSERT_EQ(list[0].mimeType_, properties.mimeType_);
+  ASSERT_EQ(list[0].extension_, properties.extension_);
+
+  const auto preview = index.getPreviewImage(path, properties);
+  ASSERT_TRUE(preview.isView());
+  ASSERT_TRUE(sameData(manager.getPreviewImage(list[0]), preview));
+}
+
+TEST(APreviewIndex, returnsAnEmptyImageForAPreviewThatIsCreated) {
+  const std::string path(TESTDATA_PATH "/exiv2-kodak-dc210.jpg");
+  auto image = ImageFactory::open(path);
+  image->readMetadata();
+  const auto record = PreviewManager(*image).getPreviewIndex();
+
+  const PreviewIndex index(record.c_data(), record.size());
+  ASSERT_EQ(1U, index.getPreviewProperties().size());
+  ASSERT_EQ(0U, index.getPreviewImage(path, index.getPreviewProperties()[0]).size());
+}
+
+TEST(APreviewIndex, doesNotMatchAModifiedFile) {
+  const std::string path("./preview-index.eps");
+  fs::copy_file(TESTDATA_PATH "/exiv2-bug836.eps", path, fs::copy_options::overwrite_existing);
+  auto image = ImageFactory::open(path);
+  image->readMetadata();
+  const auto record = PreviewManager(*image).getPreviewIndex();
+  image.reset();
+
+  const PreviewIndex index(record.c_data(), record.size());
+  ASSERT_TRUE(index.matches(path));
+  {
+    FileIo file(path);
+    ASSERT_EQ(0, file.open("r+b"));
+    ASSERT_EQ(1U, file.write(reinterpret_cast<const byte*>("x"), 1));
+  }
+  ASSERT_FALSE(index.matches(path));
+  ASSERT_FALSE(index.matches("./does-not-exist.eps"));
+  EXPECT_TRUE(fs::remove(path));
+}
+
+TEST(APreviewIndex, rejectsATruncatedRecord) {
+  auto image = ImageFactory::open(TESTDATA_PATH "/exiv2-bug836.eps");
+  image->readMetadata();
+  const auto record = PreviewManager(*image).getPreviewIndex();
+  ASSERT_THROW(PreviewIndex(record.c_data(), record.size() - 1), Error);
+  ASSERT_THROW(PreviewIndex(record.c_data(), 4), Error);
+}
+#endif
@@ -0,0 +1,321 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <exiv2/basicio.hpp>
+#include <exiv2/quicktimevideo.hpp>
+#include "unittest_utils.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace Exiv2;
+
+namespace {
+using Bytes = std::vector<byte>;
+
+Bytes readTestFile(const std::string& name) {
+  FileIo file((fs::path(TESTDATA_PATH) / name).string());
+  EXPECT_EQ(0, file.open());
+  const DataBuf data = file.read(file.size());
+  return {data.begin(), data.end()};
+}
+
+// Position and size of the first top level atom of the type
+std::pair<size_t, size_t> findAtom(const Bytes& file, const std::string& type) {
+  for (size_t pos = 0; pos + 8 <= file.size();) {
+    const size_t size = getULong(file.data() + pos, bigEndian);
+    if (std::equal(type.begin(), type.end(), file.begin() + pos + 4))
+      return {pos, size};
+    pos += size;
+  }
+  return {0, 0};
+}
+
+// The first chunk offset of the first stco atom
+uint32_t firstChunkOffset(const Bytes& file) {
+  const std::string stco = "stco";
+  auto it = std::search(file.begin(), file.end(), stco.begin(), stco.end());
+  return getULong(&*(it + 12), bigEndian);
+}
+
+// The file with the moov atom after the ftyp atom, followed by a free atom of padding bytes
+Bytes fastStart(const Bytes& file, size_t padding) {
+  const auto [ftypPos, ftypSize] = findAtom(file, "ftyp");
+  const auto [moovPos, moovSize] = findAtom(file, "moov");
+  Bytes moov(file.begin() + moovPos, file.begin() + moovPos + moovSize);
+  const std::string stco = "stco";
+  for (auto it = std::search(moov.begin(), moov.end(), stco.begin(), stco.end()); it != moov.end();
+       it = std::search(it + 4, moov.end(), stco.begin(), stco.end())) {
+    const uint32_t count = getULong(&*(it + 8), bigEndian);
+    for (uint32_t i = 0; i < count; ++i) {
+      byte* entry = &*(it + 12 + 4 * i);
+      ul2Data(entry, static_cast<uint32_t>(getULong(entry, bigEndian) + moovSize + padding), bigEndian);
+    }
+  }
+  Bytes result(file.begin() + ftypPos, file.begin() + ftypPos + ftypSize);
+  result.insert(result.end(), moov.begin(), moov.end());
+  if (padding > 0) {
+    Bytes free(padding);
+    ul2Data(free.data(), static_cast<uint32_t>(padding), bigEndian);
+    std::copy_n("free", 4, free.begin() + 4);
+    result.insert(result.end(), free.begin(), free.end());
+  }
+  result.insert(result.end(), file.begin() + ftypPos + ftypSize, file.begin() + moovPos);
+  return result;
+}
+
+std::unique_ptr<QuickTimeVideo> openVideo(const Bytes& file) {
+  auto io = std::make_unique<MemIo>();
+  io->write(file.data(), file.size());
+  auto video = std::make_unique<QuickTimeVideo>(std::move(io), defaultImageCtorParams(false));
+  video->readMetadata();
+  return video;
+}
+
+// The file which was written
+Bytes written(QuickTimeVideo& video) {
+  auto& io = video.io();
+  EXPECT_EQ(0, io.open());
+  const DataBuf data = io.read(io.size());
+  io.close();
+  return {data.begin(), data.end()};
+}
+
+// Write a title and a description, and check them and the frame rate in what was written
+Bytes writeAndCheck(const Bytes& file) {
+  auto video = openVideo(file);
+  const auto frameRate = video->xmpData()["Xmp.video.FrameRate"].toFloat();
+  video->xmpData()["Xmp.video.Title"] = "Title";
+  video->xmpData()["Xmp.dc.description"] = "Description";
+  video->writeMetadata();
+  const Bytes result = written(*video);
+
+  auto reread = openVideo(result);
+  auto& xmpData = reread->xmpData();
+  EXPECT_EQ("Title", xmpData["Xmp.video.Title"].toString());
+  EXPECT_EQ("lang=\"x-default\" Description", xmpData["Xmp.dc.description"].toString());
+  EXPECT_FLOAT_EQ(frameRate, xmpData["Xmp.video.FrameRate"].toFloat());
+  return result;
+}
+
+// The number of top level atoms of the type
+size_t countAtoms(const Bytes& file, const std::string& type) {
+  size_t count = 0;
+  for (size_t pos = 0; pos + 8 <= file.size(); pos += getULong(file.data() + pos, bigEndian)) {
+    if (std::equal(type.begin(), type.end(), file.begin() + pos + 4))
+      ++count;
+  }
+  return count;
+}
+
+bool contains(const Bytes& file, const std::string& str) {
+  return std::search(file.begin(), file.end(), str.begin(), str.end()) != file.end();
+}
+
+Bytes atom(const std::string& type, std::initializer_list<Bytes> parts) {
+  Bytes result(8);
+  for (auto& part : parts)
+    result.insert(result.end(), part.begin(), part.end());
+  ul2Data(result.data(), static_cast<uint32_t>(result.size()), bigEndian);
+  std::copy(type.begin(), type.end(), result.begin() + 4);
+  return result;
+}
+
+Bytes uint32s(std::initializer_list<uint32_t> values) {
+  Bytes result;
+  for (auto value : values) {
+    byte buf[4];
+    ul2Data(buf, value, bigEndian);
+    result.insert(result.end(), buf, buf + 4);
+  }
+  return result;
+}
+
+// A gpmd track of three samples in one chunk at dataPos, and a Novatek gps atom with two entries
+Bytes telemetryAtoms(uint32_t dataPos) {
+  const Bytes stbl = atom("stbl", {atom("stsd", {uint32s({0, 1, 16}), {'g', 'p', 'm', 'd'}, uint32s({0, 1})}),
+                                   atom("stts", {uint32s({0, 1, 3, 1000})}),
+                                   atom("stsc", {uint32s({0, 1, 1, 3, 1})}),
+                                   atom("stsz", {uint32s({0, 0, 3, 4, 5, 6})}),
+                                   atom("stco", {uint32s({0, 1, dataPos})})});
+  const Bytes trak = atom("trak", {atom("tkhd", {uint32s({0, 0, 0, 7, 0})}),
+                                   atom("mdia", {atom("mdhd", {uint32s({0, 0, 0, 1000, 3000, 0})}),
+                                                 atom("hdlr", {uint32s({0, 0}), {'m', 'e', 't', 'a'}}),
+                                                 atom("minf", {stbl})})});
+  const Bytes udta = atom("udta", {atom("gps ", {uint32s({0x101, 0, dataPos, 4, dataPos + 4, 11})})});
+  Bytes result = trak;
+  result.insert(result.end(), udta.begin(), udta.end());
+  return result;
+}
+
+// The small video with telemetry atoms in its moov atom, then the samples at dataPos in an mdat atom
+Bytes telemetryFile(uint32_t& dataPos) {
+  Bytes file = readTestFile("small_video.mp4");
+  const auto [moovPos, moovSize] = findAtom(file, "moov");
+  const Bytes movie(file.begin() + moovPos + 8, file.begin() + moovPos + moovSize);
+  dataPos = static_cast<uint32_t>(moovPos + 8 + movie.size() + telemetryAtoms(0).size() + 8);
+  file.resize(moovPos);
+  const Bytes moov = atom("moov", {movie, telemetryAtoms(dataPos)});
+  const Bytes mdat = atom("mdat", {{'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O'}});
+  file.insert(file.end(), moov.begin(), moov.end());
+  file.insert(file.end(), mdat.begin(), mdat.end());
+  return file;
+}
+
+XmpData readXmp(const std::string& name, bool summarize) {
+  auto io = std::make_unique<FileIo>((fs::path(TESTDATA_PATH) / name).string());
+  QuickTimeVideo video(std::move(io), defaultImageCtorParams(false));
+  video.setSummarizeSampleTables(summarize);
+  video.readMetadata();
+  return video.xmpData();
+}
+}  // namespace
+
+TEST(QuickTimeVideo, decodesTheWholeSampleTablesByDefault) {
+  auto memIo = std::make_unique<MemIo>();
+  QuickTimeVideo video(std::move(memIo), defaultImageCtorParams(false));
+  ASSERT_FALSE(video.summarizeSampleTables());
+}
+
+TEST(QuickTimeVideo, summaryOfTheSampleTablesHasTheSameFrameRate) {
+  for (auto name : {"sample_640x360.mov", "small_video.mp4"}) {
+    auto full = readXmp(name, false);
+    auto summary = readXmp(name, true);
+    ASSERT_NE(full.findKey(XmpKey("Xmp.video.FrameRate")), full.end()) << name;
+    ASSERT_DOUBLE_EQ(full["Xmp.video.FrameRate"].toFloat(), summary["Xmp.video.FrameRate"].toFloat()) << name;
+    ASSERT_EQ(full["Xmp.video.Codec"].toString(), summary["Xmp.video.Codec"].toString()) << name;
+    ASSERT_EQ(full.count(), summary.count()) << name;
+  }
+}
+
+TEST(QuickTimeVideo, writesTheMovieAtTheEndOfTheFileInPlace) {
+  const Bytes file = readTestFile("sample_640x360.mov");
+  const auto [moovPos, moovSize] = findAtom(file, "moov");
+  const Bytes result = writeAndCheck(file);
+  ASSERT_TRUE(std::equal(file.begin(), file.begin() + moovPos, result.begin()));
+  ASSERT_EQ(moovPos, findAtom(result, "moov").first);
+
+  // The same metadata fits where it is
+  auto video = openVideo(result);
+  video->writeMetadata();
+  ASSERT_EQ(result, written(*video));
+}
+
+TEST(QuickTimeVideo, writesTheMovieToTheFreeAtomAfterIt) {
+  const Bytes file = fastStart(readTestFile("small_video.mp4"), 4096);
+  const Bytes result = writeAndCheck(file);
+  ASSERT_EQ(file.size(), result.size());
+  ASSERT_EQ(firstChunkOffset(file), firstChunkOffset(result));
+  ASSERT_EQ(findAtom(file, "mdat"), findAtom(result, "mdat"));
+}
+
+TEST(QuickTimeVideo, movesTheMediaDataAndAdjustsTheChunkOffsets) {
+  const Bytes file = fastStart(readTestFile("small_video.mp4"), 0);
+  const Bytes result = writeAndCheck(file);
+  const auto [mdatPos, mdatSize] = findAtom(file, "mdat");
+  const auto [newMdatPos, newMdatSize] = findAtom(result, "mdat");
+  ASSERT_LT(mdatPos, newMdatPos);
+  ASSERT_TRUE(std::equal(file.begin() + mdatPos, file.begin() + mdatPos + mdatSize, result.begin() + newMdatPos));
+  ASSERT_EQ(firstChunkOffset(file) - mdatPos, firstChunkOffset(result) - newMdatPos);
+}
+
+TEST(QuickTimeVideo, writesTheXmpPacketOfIsoFilesToAUuidAtom) {
+  const Bytes file = fastStart(readTestFile("small_video.mp4"), 4096);
+  const Bytes result = writeAndCheck(file);
+  const auto [uuidPos, uuidSize] = findAtom(result, "uuid");
+  ASSERT_LT(24u, uuidSize);
+  ASSERT_EQ(0xbe, result[uuidPos + 8]);
+  ASSERT_FALSE(contains(result, "XMP_"));
+
+  // Written again, the atom is replaced
+  auto video = openVideo(result);
+  video->xmpData()["Xmp.dc.description"] = "Other";
+  video->writeMetadata();
+  const Bytes again = written(*video);
+  ASSERT_EQ(1u, countAtoms(again, "uuid"));
+  ASSERT_EQ(findAtom(file, "mdat"), findAtom(again, "mdat"));
+  ASSERT_EQ("lang=\"x-default\" Other", openVideo(again)->xmpData()["Xmp.dc.description"].toString());
+}
+
+TEST(QuickTimeVideo, writesTheXmpPacketOfQuickTimeFilesToTheUserData) {
+  const Bytes result = writeAndCheck(readTestFile("sample_640x360.mov"));
+  ASSERT_EQ(0u, countAtoms(result, "uuid"));
+  ASSERT_TRUE(contains(result, "XMP_"));
+}
+
+TEST(QuickTimeVideo, packetReadLastReplacesTheProperties) {
+  Bytes file = writeAndCheck(readTestFile("sample_640x360.mov"));
+  XmpData xmpData;
+  xmpData["Xmp.dc.description"] = "Other";
+  std::string packet;
+  ASSERT_EQ(0, XmpParser::encode(packet, xmpData));
+  Bytes payload{0xbe, 0x7a, 0xcf, 0xcb, 0x97, 0xa9, 0x42, 0xe8, 0x9c, 0x71, 0x99, 0x94, 0x91, 0xe3, 0xaf, 0xac};
+  payload.insert(payload.end(), packet.begin(), packet.end());
+  const Bytes uuid = atom("uuid", {payload});
+  file.insert(file.end(), uuid.begin(), uuid.end());
+
+  auto video = openVideo(file);
+  auto& read = video->xmpData();
+  ASSERT_EQ(1, std::count_if(read.begin(), read.end(),
+                             [](const Xmpdatum& xmp) { return xmp.key() == "Xmp.dc.description"; }));
+  ASSERT_EQ("lang=\"x-default\" Other", read["Xmp.dc.description"].toString());
+}
+
+TEST(QuickTimeVideo, readsTheSamplesOfTelemetryTracks) {
+  static_assert(std::input_iterator<TelemetryTrack::const_iterator>);
+  uint32_t dataPos = 0;
+  auto video = openVideo(telemetryFile(dataPos));
+  const auto tracks = video->telemetryTracks();
+  ASSERT_EQ(2u, tracks.size());
+
+  const auto& gpmd = tracks[0];
+  ASSERT_EQ("gpmd", gpmd.format());
+  ASSERT_EQ(7u, gpmd.trackId());
+  ASSERT_EQ(3u, gpmd.size());
+  std::vector<std::string> data;
+  for (const auto& sample : gpmd) {
+    ASSERT_DOUBLE_EQ(static_cast<double>(data.size()), sample.time_);
+    ASSERT_DOUBLE_EQ(1.0, sample.duration_);
+    data.emplace_back(sample.data_.c_str(), sample.data_.size());
+  }
+  ASSERT_EQ((std::vector<std::string>{"ABCD", "EFGHI", "JKLMNO"}), data);
+
+  const auto& gps = tracks[1];
+  ASSERT_EQ("gps ", gps.format());
+  ASSERT_EQ(2u, gps.size());
+  ASSERT_EQ(dataPos + 4, gps.sample(1).offset_);
+  ASSERT_DOUBLE_EQ(1.0, gps.sample(1).time_);
+  ASSERT_EQ(11u, gps.sample(1).data_.size());
+}
+
+TEST(QuickTimeVideo, closesTheFileItOpenedToReadASample) {
+  uint32_t dataPos = 0;
+  const Bytes file = telemetryFile(dataPos);
+  const std::string path("./quicktimevideo-telemetry.mp4");
+  {
+    FileIo out(path);
+    ASSERT_EQ(0, out.open("wb"));
+    ASSERT_EQ(file.size(), out.write(file.data(), file.size()));
+  }
+  QuickTimeVideo video(std::make_unique<FileIo>(path), defaultImageCtorParams(false));
+  video.readMetadata();
+  const auto tracks = video.telemetryTracks();
+  ASSERT_FALSE(tracks.empty());
+  ASSERT_EQ(4u, tracks[0].sample(0).data_.size());
+  ASSERT_FALSE(video.io().isopen());
+
+  auto it = tracks[0].begin();
+  ASSERT_EQ(dataPos, it++->offset_);
+  ASSERT_EQ(dataPos + 4, it->offset_);
+  EXPECT_TRUE(fs::remove(path));
+}
+
+TEST(QuickTimeVideo, hasNoTelemetryTracksWithoutTimedMetadata) {
+  auto video = openVideo(readTestFile("small_video.mp4"));
+  ASSERT_TRUE(video->telemetryTracks().empty());
+}
@@ -54,3 +54,59 @@ TEST(RiffVideo, readMetadata) {
   ASSERT_FALSE(data.empty());
   ASSERT_EQ(xmpData["Xmp.video.TotalStream"].count(), 4u);
 }
+
+namespace {
+std::string le16(uint16_t v) {
+  return {static_cast<char>(v & 0xff), static_cast<char>(v >> 8)};
+}
+
+std::string le32(uint32_t v) {
+  return le16(static_cast<uint16_t>(v)) + le16(static_cast<uint16_t>(v >> 16));
+}
+
+// A chunk with its pad byte
+std::string chunk(const std::string& id, const std::string& payload) {
+  std::string c = id + le32(static_cast<uint32_t>(payload.size())) + payload;
+  if (payload.size() % 2)
+    c += '\0';
+  return c;
+}
+
+std::string list(const std::string& id, const std::string& type, const std::string& chunks) {
+  return chunk(id, type + chunks);
+}
+
+// An AVI file with a video stream and the INFO list after the index
+std::string avi(const std::string& info) {
+  const std::string strh = "vids" + std::string("MJPG") + std::string(12, '\0') + le32(1) + le32(25) +
+                           std::string(28, '\0');
+  const std::string strf = le32(40) + le32(640) + le32(480) + le16(1) + le16(24) + "MJPG" + std::string(20, '\0');
+  const std::string strl =
+      list("LIST", "strl", chunk("strh", strh) + chunk("strf", strf) + chunk("JUNK", std::string(1000, '\0')));
+  return list("RIFF", "AVI ",
+              list("LIST", "hdrl", chunk("avih", std::string(56, '\0')) + strl) +
+                  list("LIST", "movi", chunk("00dc", std::string(4000, '\x55'))) +
+                  chunk("idx1", "00dc" + le32(0x10) + le32(4) + le32(4000)) + list("LIST", "INFO", info));
+}
+
+XmpData readAvi(const std::string& file) {
+  auto io = std::make_unique<MemIo>(reinterpret_cast<const byte*>(file.data()), file.size());
+  RiffVideo riff(std::move(io), defaultImageCtorParams(false));
+  riff.readMetadata();
+  return riff.xmpData();
+}
+}  // namespace
+
+TEST(RiffVideo, readMetadataContinuesAfterEachChunkWhateverItsDecoderRead) {
+  auto xmpData = readAvi(avi(chunk("INAM", "Title") + chunk("IART", "Artist")));
+  ASSERT_EQ("MJPG", xmpData["Xmp.video.Compressor"].toString());
+  ASSERT_EQ("Title", xmpData["Xmp.video.Title"].toString());
+  ASSERT_EQ("Artist", xmpData["Xmp.video.Artist"].toString());
+}
+
+TEST(RiffVideo, readMetadataSkipsUnknownAndOversizedInfoValues) {
+  auto xmpData = readAvi(avi(chunk("IDIT", "Sat Oct 18 12:00:00 2026") +
+                                   chunk("ICMT", std::string(1024 * 1024 + 1, 'x')) + chunk("INAM", "Title")));
+  ASSERT_EQ("Title", xmpData["Xmp.video.Title"].toString());
+  ASSERT_EQ(xmpData.end(), xmpData.findKey(XmpKey("Xmp.video.Comment")));
+}
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <exiv2/basicio.hpp>
+#include <exiv2/exif.hpp>
+#include <exiv2/image.hpp>
+#include <exiv2/tags.hpp>
+
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+
+using namespace Exiv2;
+
+namespace {
+constexpr auto imagePath = TESTDATA_PATH "/Reagan.tiff";  // One strip of 104000 bytes
+
+DataBuf content(const std::string& path) {
+  FileIo file(path);
+  file.open();
+  DataBuf buf(file.size());
+  file.read(buf.data(), buf.size());
+  return buf;
+}
+
+// The image data of the file, located by its strip offset and byte count
+DataBuf strip(const std::string& path) {
+  auto image = ImageFactory::open(path);
+  image->readMetadata();
+  const auto& exifData = image->exifData();
+  auto offset = exifData.findKey(ExifKey("Exif.Image.StripOffsets"));
+  auto count = exifData.findKey(ExifKey("Exif.Image.StripByteCounts"));
+  EXPECT_NE(offset, exifData.end());
+  EXPECT_NE(count, exifData.end());
+  const auto file = content(path);
+  const auto begin = static_cast<size_t>(offset->toInt64());
+  return {file.c_data(begin), static_cast<size_t>(count->toInt64())};
+}
+
+// Write the image at path with an entry added to IFD0, which requires an intrusive write
+void addEntry(const std::string& path) {
+  auto image = ImageFactory::open(path);
+  image->readMetadata();
+  ASSERT_EQ(image->exifData().findKey(ExifKey("Exif.Image.Copyright")), image->exifData().end());
+  image->exifData()["Exif.Image.Copyright"] = "Adds an IFD0 entry";
+  image->writeMetadata();
+}
+}  // namespace
+
+TEST(ATiffImage, keepsTheImageDataInAnIntrusiveWrite) {
+  const std::string path("./tiffimage-intrusive.tiff");
+  fs::copy_file(imagePath, path, fs::copy_options::overwrite_existing);
+  addEntry(path);
+
+  const auto expected = strip(imagePath);
+  const auto written = strip(path);
+  ASSERT_EQ(104000U, written.size());
+  ASSERT_EQ(0, expected.cmpBytes(0, written.c_data(), written.size()));
+
+  auto image = ImageFactory::open(path);
+  image->readMetadata();
+  ASSERT_EQ("Adds an IFD0 entry", image->exifData()["Exif.Image.Copyright"].toString());
+  EXPECT_TRUE(fs::remove(path));
+}
+
+TEST(ATiffImage, leavesNoTemporaryFileBehindAfterAnIntrusiveWrite) {
+  const fs::path dir("./tiffimage-dir");
+  fs::remove_all(dir);
+  fs::create_directory(dir);
+  const auto path = (dir / "image.tiff").string();
+  fs::copy_file(imagePath, path);
+  addEntry(path);
+
+  size_t files = 0;
+  for ([[maybe_unused]] auto&& entry : fs::directory_iterator(dir))
+    ++files;
+  ASSERT_EQ(1U, files);
+  EXPECT_TRUE(fs::remove_all(dir));
+}
+
+TEST(ATiffImage, keepsASymbolicLinkToTheFileInAnIntrusiveWrite) {
+  const std::string path("./tiffimage-target.tiff");
+  const std::string link("./tiffimage-link.tiff");
+  fs::copy_file(imagePath, path, fs::copy_options::overwrite_existing);
+  fs::remove(link);
+  try {
+    fs::create_symlink(fs::absolute(path), link);
+  } catch (const fs::filesystem_error&) {
+    fs::remove(path);
+    GTEST_SKIP() << "Symbolic links are not supported";
+  }
+  addEntry(link);
+
+  ASSERT_TRUE(fs::is_symlink(link));
+  const auto written = content(path);
+  const auto viaLink = content(link);
+  ASSERT_EQ(written.size(), viaLink.size());
+  ASSERT_EQ(0, written.cmpBytes(0, viaLink.c_data(), viaLink.size()));
+  ASSERT_NE(content(imagePath).size(), written.size());
+  EXPECT_TRUE(fs::remove(link));
+  EXPECT_TRUE(fs::remove(path));
+}
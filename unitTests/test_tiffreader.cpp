@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <exiv2/exif.hpp>
+#include <exiv2/error.hpp>
+#include <exiv2/image.hpp>
+#include <exiv2/tags.hpp>
+#include <makernote_int.hpp>
+#include <tiffcomposite_int.hpp>
+#include <tiffimage_int.hpp>
+#include <tiffvisitor_int.hpp>
+#include "unittest_utils.hpp"
+
+#include <vector>
+
+using namespace Exiv2;
+
+namespace {
+void putUShort(std::vector<byte>& buf, size_t pos, uint16_t v) {
+  us2Data(buf.data() + pos, v, littleEndian);
+}
+
+void putULong(std::vector<byte>& buf, size_t pos, uint32_t v) {
+  ul2Data(buf.data() + pos, v, littleEndian);
+}
+
+// Little endian TIFF with one IFD of \em entries BYTE entries which all point to the same \em dataSize bytes.
+std::vector<byte> tiffWithSharedData(uint16_t entries, uint32_t dataSize) {
+  const uint32_t dataOffset = 8 + 2 + (12 * entries) + 4;
+  std::vector<byte> buf(dataOffset + dataSize);
+  buf[0] = 'I';
+  buf[1] = 'I';
+  putUShort(buf, 2, 42);
+  putULong(buf, 4, 8);
+  putUShort(buf, 8, entries);
+  for (uint16_t i = 0; i < entries; ++i) {
+    const size_t p = 10 + (12 * i);
+    putUShort(buf, p, 0x1000 + i);  // unknown tag
+    putUShort(buf, p + 2, 1);       // BYTE
+    putULong(buf, p + 4, dataSize);
+    putULong(buf, p + 8, dataOffset);
+  }
+  putULong(buf, 10 + (12 * entries), 0);  // no next IFD
+  return buf;
+}
+}  // namespace
+
+TEST(ATiffReader, readsAllEntriesWithinTheByteBudget) {
+  auto buf = tiffWithSharedData(10, 1024);
+  ExifData exifData;
+  ExifParser::decode(exifData, buf.data(), buf.size(), defaultDecodeParams());
+  ASSERT_EQ(10U, exifData.count());
+  for (auto&& md : exifData) {
+    ASSERT_EQ(1024U, md.size());
+  }
+}
+
+TEST(ATiffReader, truncatesEntriesBeyondTheByteBudget) {
+  const uint32_t dataSize = 1024 * 1024;
+  const uint16_t entries = 80;
+  ASSERT_GT(entries * size_t{dataSize}, Internal::TiffReader::minBytes_);
+  auto buf = tiffWithSharedData(entries, dataSize);
+
+  const auto level = LogMsg::level();
+  LogMsg::setLevel(LogMsg::mute);
+  ExifData exifData;
+  ExifParser::decode(exifData, buf.data(), buf.size(), defaultDecodeParams());
+  LogMsg::setLevel(level);
+
+  ASSERT_EQ(entries, exifData.count());
+  size_t read = 0;
+  for (auto&& md : exifData) {
+    read += md.size();
+  }
+  ASSERT_LE(read, Internal::TiffReader::minBytes_);
+  ASSERT_GE(read, Internal::TiffReader::minBytes_ - dataSize);
+}
+
+TEST(ATiffReader, searchesTheTreeOnceForEachInputOfTheMakernoteArrayFunctions) {
+  // Nikon makernote with encrypted binary arrays
+  auto image = ImageFactory::open(TESTDATA_PATH "/exiv2-bug1114.jpg");
+  image->readMetadata();
+  Blob blob;
+  ExifParser::encode(blob, littleEndian, image->exifData());
+
+  auto root = Internal::TiffCreator::create(Internal::Tag::root, IfdId::ifdIdNotSet);
+  root->setStart(blob.data() + 8);
+  Internal::TiffReader reader(blob.data(), blob.size(), root.get(), Internal::TiffRwState{littleEndian, 0});
+  root->accept(reader);
+  reader.postProcess();
+
+  auto&& counters = reader.mnContext().counters();
+  ASSERT_GT(counters.selections_, 0U);
+  ASSERT_GT(counters.crypts_, 0U);
+  // Make, model, shutter count and serial number
+  ASSERT_LE(counters.searches_, 4U);
+  ASSERT_GT(counters.cached_, 0U);
+
+  Internal::MnContext context(root.get());
+  ASSERT_TRUE(context.firmware().starts_with("Ver.1.03"));
+  ASSERT_EQ(context.firmware(), context.firmware());
+  ASSERT_EQ(1U, context.counters().searches_);
+}
+
+TEST(AnMnContext, memoizesSelectionsWhichFoundTheirInputs) {
+  const byte version[] = {'0', '1', '0', '0', 0, 0, 0, 0};
+  Internal::MnContext context(nullptr);
+  ASSERT_EQ(0, context.select(Internal::nikonSelector, 0x0098, version, sizeof(version)));
+  ASSERT_EQ(0, context.select(Internal::nikonSelector, 0x0098, version, sizeof(version)));
+  ASSERT_EQ(1U, context.counters().selections_);
+  ASSERT_EQ(1U, context.counters().memoized_);
+
+  // Without a model, the next model may be found in the tree
+  ASSERT_EQ(-1, context.select(Internal::sonyCsSelector, 0x0114, version, sizeof(version)));
+  ASSERT_EQ(-1, context.select(Internal::sonyCsSelector, 0x0114, version, sizeof(version)));
+  ASSERT_EQ(3U, context.counters().selections_);
+  ASSERT_EQ(1U, context.counters().memoized_);
+}
@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <exiv2/exiv2.hpp>
+
+#include <filesystem>
+#include <string>
+
+#include "unittest_utils.hpp"
+
+namespace fs = std::filesystem;
+using namespace Exiv2;
+
+namespace {
+constexpr auto head =
+    "<?xpacket begin=\"\xEF\xBB\xBF\" id=\"W5M0MpCehiHzreSzNTczkc9d\"?>\n"
+    "<x:xmpmeta xmlns:x=\"adobe:ns:meta/\">\n"
+    " <rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\">\n";
+constexpr auto tail =
+    " </rdf:RDF>\n"
+    "</x:xmpmeta>\n"
+    "<?xpacket end=\"w\"?>";
+
+// What a camera or an editor writes, in all the forms the native reader handles
+constexpr auto description =
+    "  <rdf:Description rdf:about=\"\"\n"
+    "    xmlns:xmp=\"http://ns.adobe.com/xap/1.0/\"\n"
+    "    xmlns:dc=\"http://purl.org/dc/elements/1.1/\"\n"
+    "    xmlns:exif=\"http://ns.adobe.com/exif/1.0/\"\n"
+    "    xmlns:stEvt=\"http://ns.adobe.com/xap/1.0/sType/ResourceEvent#\"\n"
+    "    xmlns:xmpMM=\"http://ns.adobe.com/xap/1.0/mm/\"\n"
+    "   xmp:Rating=\"3\"\n"
+    "   xmp:CreatorTool=\"Camera &amp; &quot;Firmware&quot; 1.0\">\n"
+    "   <xmp:CreateDate>2024-01-02T03:04:05</xmp:CreateDate>\n"
+    "   <xmp:Label></xmp:Label>\n"
+    "   <dc:format>image/jpeg</dc:format>\n"
+    "   <dc:title>\n"
+    "    <rdf:Alt>\n"
+    "     <rdf:li xml:lang=\"x-default\">A &lt;title&gt;&#xA;on two lines</rdf:li>\n"
+    "     <rdf:li xml:lang=\"EN-us\">A title</rdf:li>\n"
+    "    </rdf:Alt>\n"
+    "   </dc:title>\n"
+    "   <dc:subject>\n"
+    "    <rdf:Bag>\n"
+    "     <rdf:li>one</rdf:li>\n"
+    "     <rdf:li>two</rdf:li>\n"
+    "    </rdf:Bag>\n"
+    "   </dc:subject>\n"
+    "   <dc:creator><rdf:Seq><rdf:li>Someone</rdf:li></rdf:Seq></dc:creator>\n"
+    "   <exif:ISOSpeedRatings><rdf:Seq/></exif:ISOSpeedRatings>\n"
+    "   <exif:Flash rdf:parseType=\"Resource\">\n"
+    "    <exif:Fired>False</exif:Fired>\n"
+    "    <exif:Mode>2</exif:Mode>\n"
+    "   </exif:Flash>\n"
+    "   <exif:OECF exif:Columns=\"2\" exif:Rows=\"1\"/>\n"
+    "   <xmpMM:DerivedFrom>\n"
+    "    <rdf:Description xmpMM:DocumentID=\"doc\">\n"
+    "     <xmpMM:Manager><rdf:Bag><rdf:li>m</rdf:li></rdf:Bag></xmpMM:Manager>\n"
+    "    </rdf:Description>\n"
+    "   </xmpMM:DerivedFrom>\n"
+    "   <xmpMM:History>\n"
+    "    <rdf:Seq>\n"
+    "     <rdf:li stEvt:action=\"saved\" stEvt:when=\"2024-01-02T03:04:05\"/>\n"
+    "     <rdf:li rdf:parseType=\"Resource\"><stEvt:action>converted</stEvt:action></rdf:li>\n"
+    "     <rdf:li><rdf:Description stEvt:action=\"edited\"/></rdf:li>\n"
+    "    </rdf:Seq>\n"
+    "   </xmpMM:History>\n"
+    "   <xmpMM:Pantry><rdf:Bag><rdf:li><rdf:Bag><rdf:li>x</rdf:li></rdf:Bag></rdf:li></rdf:Bag></xmpMM:Pantry>\n"
+    "  </rdf:Description>\n";
+
+std::string packet(const std::string& props) {
+  return std::string(head) + props + tail;
+}
+
+std::string describe(const XmpData& xmpData) {
+  std::string s;
+  for (const auto& xmp : xmpData)
+    s += xmp.key() + " " + xmp.typeName() + " " + xmp.toString() + "\n";
+  return s;
+}
+
+int decode(XmpData& xmpData, const std::string& xmpPacket, bool native) {
+  const auto level = LogMsg::level();
+  LogMsg::setLevel(LogMsg::mute);
+  const int rc = XmpParser::decode(xmpData, xmpPacket, DecodeParams(MAX_RECURSION_DEPTH, false, native));
+  LogMsg::setLevel(level);
+  return rc;
+}
+
+// Decode the packet with and without the native reader, they must not differ
+void expectSameDecode(const std::string& xmpPacket) {
+  XmpData toolkit;
+  XmpData native;
+  const int rc = decode(toolkit, xmpPacket, false);
+  ASSERT_EQ(rc, decode(native, xmpPacket, true));
+  ASSERT_EQ(describe(toolkit), describe(native));
+}
+
+// Encode with and without the native serializer, the packets must not differ
+void expectSameEncode(const XmpData& xmpData, uint16_t formatFlags, uint32_t padding = 0) {
+  std::string toolkit;
+  std::string native;
+  const auto level = LogMsg::level();
+  LogMsg::setLevel(LogMsg::mute);
+  const int rc = XmpParser::encode(toolkit, xmpData, formatFlags, padding);
+  const int nativeRc = XmpParser::encode(native, xmpData, formatFlags | XmpParser::useNativeSerializer, padding);
+  LogMsg::setLevel(level);
+  ASSERT_EQ(rc, nativeRc);
+  ASSERT_EQ(toolkit, native);
+}
+
+void expectSameEncode(const XmpData& xmpData) {
+  expectSameEncode(xmpData, XmpParser::useCompactFormat);
+  expectSameEncode(xmpData, XmpParser::useCompactFormat | XmpParser::omitAllFormatting);
+  expectSameEncode(xmpData, XmpParser::useCompactFormat | XmpParser::omitPacketWrapper);
+  expectSameEncode(xmpData, XmpParser::useCompactFormat | XmpParser::readOnlyPacket);
+  expectSameEncode(xmpData, XmpParser::useCompactFormat, 250);
+  expectSameEncode(xmpData, XmpParser::useCompactFormat | XmpParser::exactPacketLength, 8192);
+  expectSameEncode(xmpData, XmpParser::useCompactFormat | XmpParser::exactPacketLength, 100);
+  expectSameEncode(xmpData, 0);
+}
+}  // namespace
+
+TEST(NativeXmp, decodesACameraPacketLikeTheToolkit) {
+  expectSameDecode(packet(description));
+}
+
+TEST(NativeXmp, encodesACameraPacketLikeTheToolkit) {
+  XmpData xmpData;
+  ASSERT_EQ(0, decode(xmpData, packet(description), true));
+  ASSERT_FALSE(xmpData.empty());
+  expectSameEncode(xmpData);
+}
+
+TEST(NativeXmp, encodesDataSetByAnApplicationLikeTheToolkit) {
+  XmpData xmpData;
+  xmpData["Xmp.dc.format"] = "image/jpeg";
+  xmpData["Xmp.xmp.Rating"] = "3";
+  xmpData["Xmp.dc.description"] = "lang=\"de-DE\" Beschreibung";
+  xmpData["Xmp.dc.rights"] = "";
+  xmpData["Xmp.dc.source"] = "tab\tand control\x01 character";
+  XmpTextValue history;
+  history.setXmpArrayType(XmpValue::xaSeq);
+  xmpData.add(XmpKey("Xmp.xmpMM.History"), &history);
+  xmpData["Xmp.xmpMM.History[1]/stEvt:action"] = "saved";
+  XmpTextValue flash;
+  flash.setXmpStruct();
+  xmpData.add(XmpKey("Xmp.exif.Flash"), &flash);
+  xmpData["Xmp.exif.Flash/exif:Fired"] = "True";
+  expectSameEncode(xmpData);
+}
+
+TEST(NativeXmp, fallsBackToTheToolkitForOtherPackets) {
+  const std::string packets[] = {
+      // A qualifier
+      "  <rdf:Description rdf:about=\"\" xmlns:xmp=\"http://ns.adobe.com/xap/1.0/\">\n"
+      "   <xmp:BaseURL rdf:resource=\"http://example.com/\"/>\n"
+      "  </rdf:Description>\n",
+      // A language qualifier outside of an alternative array
+      "  <rdf:Description rdf:about=\"\" xmlns:dc=\"http://purl.org/dc/elements/1.1/\">\n"
+      "   <dc:format xml:lang=\"en\">image/jpeg</dc:format>\n"
+      "  </rdf:Description>\n",
+      // A property the toolkit touches up
+      "  <rdf:Description rdf:about=\"\" xmlns:dc=\"http://purl.org/dc/elements/1.1/\" dc:subject=\"one\"/>\n",
+      // A namespace Exiv2 does not know
+      "  <rdf:Description rdf:about=\"\" xmlns:nsNative=\"http://example.com/native/\" nsNative:Tag=\"1\"/>\n",
+      // A prefix for two namespaces
+      "  <rdf:Description rdf:about=\"\" xmlns:xmp=\"http://ns.adobe.com/xap/1.0/\" xmp:Rating=\"1\"/>\n"
+      "  <rdf:Description rdf:about=\"\" xmlns:xmp=\"http://purl.org/dc/elements/1.1/\" xmp:format=\"a\"/>\n",
+      // Control characters
+      "  <rdf:Description rdf:about=\"\" xmlns:xmp=\"http://ns.adobe.com/xap/1.0/\" xmp:Label=\"&#x41;\"/>\n",
+      // A duplicate language
+      "  <rdf:Description rdf:about=\"\" xmlns:dc=\"http://purl.org/dc/elements/1.1/\">\n"
+      "   <dc:title><rdf:Alt><rdf:li xml:lang=\"en\">a</rdf:li><rdf:li xml:lang=\"EN\">b</rdf:li></rdf:Alt></dc:title>\n"
+      "  </rdf:Description>\n",
+      // Not well-formed
+      "  <rdf:Description rdf:about=\"\" xmlns:xmp=\"http://ns.adobe.com/xap/1.0/\">\n",
+  };
+  for (const auto& props : packets) {
+    SCOPED_TRACE(props);
+    expectSameDecode(packet(props));
+  }
+}
+
+TEST(NativeXmp, decodesAndEncodesTheTestFilesLikeTheToolkit) {
+  for (const auto& entry : fs::directory_iterator(TESTDATA_PATH)) {
+    const auto ext = entry.path().extension();
+    if (ext != ".xmp" && ext != ".jpg")
+      continue;
+    std::string xmpPacket;
+    XmpData converted;
+    const auto level = LogMsg::level();
+    LogMsg::setLevel(LogMsg::mute);
+    try {
+      auto image = ImageFactory::open(entry.path().string());
+      image->readMetadata();
+      xmpPacket = image->xmpPacket();
+      copyExifToXmp(image->exifData(), converted);
+    } catch (const Error&) {
+    }
+    LogMsg::setLevel(level);
+    SCOPED_TRACE(entry.path().string());
+    // What the Exif to XMP conversion sets, with structs it does not add itself
+    if (!converted.empty())
+      expectSameEncode(converted);
+    if (xmpPacket.empty())
+      continue;
+    expectSameDecode(xmpPacket);
+    XmpData xmpData;
+    if (decode(xmpData, xmpPacket, true) == 0)
+      expectSameEncode(xmpData);
+  }
+}
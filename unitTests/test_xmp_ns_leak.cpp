@@ -194,3 +194,44 @@ TEST(XmpNsLeak, ProgrammaticAddUsesCanonicalUriAfterPoison) {
   EXPECT_EQ("http://ns.adobe.com/xap/1.0/mm/", uriForPrefix(packet, "xmpMM"))
       << "programmatic add fell back to the poisoned global binding";
 }
+
+// ---------------------------------------------------------------------------
+// encode() only pushes the registry to the toolkit when either side changed.
+// A read that binds a registered URI to another prefix changes the toolkit's
+// side, and a later write must still use the registered prefix.
+// ---------------------------------------------------------------------------
+TEST(XmpNsLeak, RegisteredPrefixIsUsedAgainAfterAReadRebindsItsUri) {
+  using Exiv2::XmpProperties;
+
+  const std::string uri = "http://example.com/xgen/1.0/";
+  XmpProperties::registerNs(uri, "xgen");
+  Exiv2::XmpData d;
+  d["Xmp.xgen.Tag"] = "v";
+  std::string packet;
+  ASSERT_EQ(0, Exiv2::XmpParser::encode(packet, d, Exiv2::XmpParser::omitPacketWrapper));
+  ASSERT_EQ(uri, uriForPrefix(packet, "xgen"));
+
+  const std::string rebind = R"(<?xpacket begin="" id="W5M0MpCehiHzreSzNTczkc9d"?>)"
+                             R"(<x:xmpmeta xmlns:x="adobe:ns:meta/">)"
+                             R"(<rdf:RDF xmlns:rdf="http://www.w3.org/1999/02/22-rdf-syntax-ns#">)"
+                             R"(<rdf:Description rdf:about="")"
+                             R"( xmlns:xother="http://example.com/xgen/1.0/")"
+                             R"( xother:Tag="w"/>)"
+                             R"(</rdf:RDF></x:xmpmeta><?xpacket end="w"?>)";
+  {
+    Exiv2::XmpData r;
+    ASSERT_EQ(0, Exiv2::XmpParser::decode(r, rebind, defaultDecodeParams()));
+  }
+
+  ASSERT_EQ(0, Exiv2::XmpParser::encode(packet, d, Exiv2::XmpParser::omitPacketWrapper));
+  EXPECT_EQ(uri, uriForPrefix(packet, "xgen"));
+  EXPECT_EQ("<none>", uriForPrefix(packet, "xother"));
+
+  // A new registration reaches the toolkit with the next write
+  XmpProperties::registerNs(uri, "xgen2");
+  Exiv2::XmpData d2;
+  d2["Xmp.xgen2.Tag"] = "v";
+  ASSERT_EQ(0, Exiv2::XmpParser::encode(packet, d2, Exiv2::XmpParser::omitPacketWrapper));
+  EXPECT_EQ(uri, uriForPrefix(packet, "xgen2"));
+  XmpProperties::unregisterNs(uri);
+}
@@ -115,6 +115,7 @@ TEST(XmpRace, ConcurrentEncodeEncode) {
   constexpr int ITERATIONS = 300;
   constexpr int NUM_THREADS = 5;
 
+  std::atomic<int> failures{0};
   auto encode_worker = [&](int thread_id) {
     for (int i = 0; i < ITERATIONS; ++i) {
       try {
@@ -123,8 +124,14 @@ TEST(XmpRace, ConcurrentEncodeEncode) {
         xmpData["Xmp.dc.title"] = "Thread " + std::to_string(thread_id) + " iteration " + std::to_string(i);
 
         std::string packet;
-        Exiv2::XmpParser::encode(packet, xmpData);
+        Exiv2::XmpData decoded;
+        if (Exiv2::XmpParser::encode(packet, xmpData) != 0 ||
+            Exiv2::XmpParser::decode(decoded, packet, defaultDecodeParams()) != 0 ||
+            decoded["Xmp.dc.title"].toString() != xmpData["Xmp.dc.title"].toString()) {
+          failures++;
+        }
       } catch (...) {
+        failures++;
       }
     }
   };
@@ -139,7 +146,7 @@ TEST(XmpRace, ConcurrentEncodeEncode) {
       t.join();
   }
 
-  SUCCEED();
+  EXPECT_EQ(0, failures.load());
 }
 
 // Test concurrent decode operations
@@ -181,3 +188,138 @@ TEST(XmpRace, ConcurrentDecodeDecode) {
 
   SUCCEED();
 }
+
+// Decode and encode run without the Giant Lock: concurrent decodes of a packet with a struct, arrays and a
+// language alternative must give the same result as a single one
+
+TEST(XmpRace, ConcurrentDecodeMatchesASingleDecode) {
+  constexpr int ITERATIONS = 100;
+  constexpr int NUM_THREADS = 4;
+
+  const auto xmpPacket = std::string(
+      "<?xpacket begin=\"\" id=\"W5M0MpCehiHzreSzNTczkc9d\"?>\n"
+      "<x:xmpmeta xmlns:x=\"adobe:ns:meta/\" x:xmptk=\"XMP Core 4.4.0\">\n"
+      " <rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\">\n"
+      "  <rdf:Description rdf:about=\"\"\n"
+      "    xmlns:dc=\"http://purl.org/dc/elements/1.1/\"\n"
+      "    xmlns:xmpMM=\"http://ns.adobe.com/xap/1.0/mm/\"\n"
+      "    xmlns:stEvt=\"http://ns.adobe.com/xap/1.0/sType/ResourceEvent#\"\n"
+      "    dc:format=\"image/jpeg\">\n"
+      "   <dc:title><rdf:Alt><rdf:li xml:lang=\"x-default\">Title</rdf:li></rdf:Alt></dc:title>\n"
+      "   <dc:subject><rdf:Bag><rdf:li>one</rdf:li><rdf:li>two</rdf:li></rdf:Bag></dc:subject>\n"
+      "   <xmpMM:History><rdf:Seq><rdf:li stEvt:action=\"saved\" stEvt:when=\"2020-01-01\"/></rdf:Seq>"
+      "</xmpMM:History>\n"
+      "  </rdf:Description>\n"
+      " </rdf:RDF>\n"
+      "</x:xmpmeta>\n"
+      "<?xpacket end=\"w\"?>");
+
+  auto entries = [](const Exiv2::XmpData& xmpData) {
+    std::vector<std::string> ret;
+    for (auto&& md : xmpData) {
+      ret.push_back(md.key() + "=" + md.toString());
+    }
+    return ret;
+  };
+
+  Exiv2::XmpData expected;
+  ASSERT_EQ(0, Exiv2::XmpParser::decode(expected, xmpPacket, defaultDecodeParams()));
+  ASSERT_GT(expected.count(), 5);
+  const auto expectedEntries = entries(expected);
+
+  std::atomic<int> mismatches{0};
+  auto decode_worker = [&]() {
+    for (int i = 0; i < ITERATIONS; ++i) {
+      Exiv2::XmpData xmpData;
+      if (Exiv2::XmpParser::decode(xmpData, xmpPacket, defaultDecodeParams()) != 0 ||
+          entries(xmpData) != expectedEntries) {
+        mismatches++;
+      }
+      std::string packet;
+      if (Exiv2::XmpParser::encode(packet, xmpData) != 0 || packet.find("saved") == std::string::npos)
+        mismatches++;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < NUM_THREADS; ++i) {
+    threads.emplace_back(decode_worker);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(0, mismatches.load());
+}
+
+// Decodes of packets which bind a namespace to another prefix must not break concurrent encodes: the packet
+// an encode gives must decode to the data it was encoded from
+
+TEST(XmpRace, EncodeRoundTripsWhileDecodesRebindAPrefix) {
+  constexpr int ITERATIONS = 1000;
+  constexpr int NUM_THREADS = 2;
+
+  auto packetWithPrefix = [](const std::string& prefix) {
+    return std::string(
+        "<?xpacket begin=\"\" id=\"W5M0MpCehiHzreSzNTczkc9d\"?>\n"
+        "<x:xmpmeta xmlns:x=\"adobe:ns:meta/\" x:xmptk=\"XMP Core 4.4.0\">\n"
+        " <rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\">\n"
+        "  <rdf:Description rdf:about=\"\"\n"
+        "    xmlns:" +
+        prefix + "=\"http://purl.org/dc/elements/1.1/\"\n    " + prefix +
+        ":format=\"image/jpeg\"/>\n"
+        " </rdf:RDF>\n"
+        "</x:xmpmeta>\n"
+        "<?xpacket end=\"w\"?>");
+  };
+
+  auto entries = [](const Exiv2::XmpData& xmpData) {
+    std::vector<std::string> ret;
+    for (auto&& md : xmpData) {
+      ret.push_back(md.key() + "=" + md.toString());
+    }
+    return ret;
+  };
+
+  std::atomic<bool> done{false};
+  auto decode_worker = [&](int thread_id) {
+    const auto packets = std::vector{packetWithPrefix("dc"), packetWithPrefix("dcx" + std::to_string(thread_id))};
+    for (size_t i = 0; !done; ++i) {
+      Exiv2::XmpData xmpData;
+      Exiv2::XmpParser::decode(xmpData, packets[i % 2], defaultDecodeParams());
+    }
+  };
+
+  std::atomic<int> failures{0};
+  auto encode_worker = [&](int thread_id) {
+    for (int i = 0; i < ITERATIONS; ++i) {
+      Exiv2::XmpData xmpData;
+      xmpData["Xmp.dc.format"] = "image/jpeg";
+      xmpData["Xmp.dc.source"] = "Thread " + std::to_string(thread_id) + " iteration " + std::to_string(i);
+      xmpData["Xmp.dc.title"] = "lang=x-default Title";
+      xmpData["Xmp.dc.subject"] = "one";
+
+      std::string packet;
+      Exiv2::XmpData decoded;
+      if (Exiv2::XmpParser::encode(packet, xmpData) != 0 ||
+          Exiv2::XmpParser::decode(decoded, packet, defaultDecodeParams()) != 0 ||
+          entries(decoded) != entries(xmpData)) {
+        failures++;
+      }
+    }
+  };
+
+  std::vector<std::thread> decoders;
+  std::vector<std::thread> encoders;
+  for (int i = 0; i < NUM_THREADS; ++i) {
+    decoders.emplace_back(decode_worker, i);
+    encoders.emplace_back(encode_worker, i);
+  }
+  for (auto& t : encoders) {
+    t.join();
+  }
+  done = true;
+  for (auto& t : decoders) {
+    t.join();
+  }
+  EXPECT_EQ(0, failures.load());
+}
@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <exiv2/exiv2.hpp>
+
+#include <string>
+
+using namespace Exiv2;
+
+namespace {
+// A packet with a property nested depth structs deep, about depth + 5 XML elements
+std::string nestedPacket(int depth) {
+  std::string packet =
+      "<x:xmpmeta xmlns:x=\"adobe:ns:meta/\">"
+      "<rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\">"
+      "<rdf:Description rdf:about=\"\" xmlns:exif=\"http://ns.adobe.com/exif/1.0/\">";
+  for (int i = 0; i < depth; ++i)
+    packet += "<exif:Nested rdf:parseType=\"Resource\">";
+  packet += "<exif:Leaf>value</exif:Leaf>";
+  for (int i = 0; i < depth; ++i)
+    packet += "</exif:Nested>";
+  packet += "</rdf:Description></rdf:RDF></x:xmpmeta>";
+  return packet;
+}
+
+int decodeMuted(XmpData& xmpData, const std::string& packet, size_t maxDepth) {
+  const auto level = LogMsg::level();
+  LogMsg::setLevel(LogMsg::mute);
+  const int rc = XmpParser::decode(xmpData, packet, DecodeParams(maxDepth));
+  LogMsg::setLevel(level);
+  return rc;
+}
+}  // namespace
+
+TEST(AnXmpPacket, isDecodedIfItIsNestedWithinTheLimit) {
+  XmpData xmpData;
+  ASSERT_EQ(0, decodeMuted(xmpData, nestedPacket(20), 30));
+  ASSERT_FALSE(xmpData.empty());
+}
+
+TEST(AnXmpPacket, isRejectedIfItIsNestedDeeperThanTheLimit) {
+  XmpData xmpData;
+  ASSERT_EQ(3, decodeMuted(xmpData, nestedPacket(20), 10));
+  ASSERT_TRUE(xmpData.empty());
+}
+
+TEST(AnXmpPacket, isRejectedIfItHasADoctype) {
+  const std::string packet = "<!DOCTYPE x:xmpmeta [<!ENTITY e \"value\">]>" + nestedPacket(1);
+  XmpData xmpData;
+  ASSERT_EQ(3, decodeMuted(xmpData, packet, 500));
+  ASSERT_TRUE(xmpData.empty());
+}
+
+TEST(AnXmpPacket, isRejectedIfItIsNotWellFormed) {
+  auto packet = nestedPacket(1);
+  packet.resize(packet.size() - 5);
+  XmpData xmpData;
+  ASSERT_EQ(3, decodeMuted(xmpData, packet, 500));
+  ASSERT_TRUE(xmpData.empty());
+}
@@ -329,6 +329,18 @@ public:
 
     static void DeleteNamespace ( XMP_StringPtr namespaceURI );
 
+    // ---------------------------------------------------------------------------------------------
+    /// @brief \c GetNamespaceGeneration() reports a counter that changes whenever a namespace is
+    /// registered with a new URI or prefix, or deleted.
+    ///
+    /// Clients that keep the registry in sync with their own can skip the work while it is unchanged.
+    ///
+    /// This function is static; make the call directly from the concrete class (\c SXMPMeta).
+    ///
+    /// @return The current generation of the namespace registry.
+
+    static XMP_Uns64 GetNamespaceGeneration();
+
     /// @}
 
     // ---------------------------------------------------------------------------------------------
@@ -1533,11 +1545,18 @@ public:
     ///   \li \c #kXMP_ParseMoreBuffers - This is not the last buffer of input, more calls follow.
     ///   \li \c #kXMP_RequireXMPMeta - The \c x:xmpmeta XML element is required around \c rdf:RDF.
     ///
+    /// @param maxDepth Optional limit on the nesting of XML elements and of namespace declarations.
+    /// If it is not 0, deeper nesting and a \c DOCTYPE declaration are rejected while the XML is
+    /// parsed, ISO Latin-1 and ASCII controls are not tolerated, and every XML error is reported as
+    /// \c kXMPErr_BadXML "Error in XMLValidator". Only the first call of a series of input buffers
+    /// sets it.
+    ///
     /// @see \c TXMPFiles::GetXMP()
 
     void ParseFromBuffer ( XMP_StringPtr  buffer,
 						   XMP_StringLen  bufferSize,
-						   XMP_OptionBits options = 0 );
+						   XMP_OptionBits options = 0,
+						   XMP_Uns32      maxDepth = 0 );
 
     // ---------------------------------------------------------------------------------------------
     /// @brief \c SerializeToBuffer() serializes metadata in this XMP object into a string as RDF.
@@ -51,6 +51,9 @@ extern "C" {
 #define zXMPMeta_DeleteNamespace_1(namespaceURI) \
     WXMPMeta_DeleteNamespace_1 ( namespaceURI, &wResult )
 
+#define zXMPMeta_GetNamespaceGeneration_1() \
+    WXMPMeta_GetNamespaceGeneration_1 ( &wResult )
+
 #define zXMPMeta_RegisterAlias_1(aliasNS,aliasProp,actualNS,actualProp,arrayForm) \
     WXMPMeta_RegisterAlias_1 ( aliasNS, aliasProp, actualNS, actualProp, arrayForm, &wResult )
 
@@ -177,8 +180,8 @@ extern "C" {
 #define zXMPMeta_DumpObject_1(outProc,refCon) \
     WXMPMeta_DumpObject_1 ( this->xmpRef, outProc, refCon, &wResult )
 
-#define zXMPMeta_ParseFromBuffer_1(buffer,bufferSize,options) \
-    WXMPMeta_ParseFromBuffer_1 ( this->xmpRef, buffer, bufferSize, options, &wResult )
+#define zXMPMeta_ParseFromBuffer_1(buffer,bufferSize,options,maxDepth) \
+    WXMPMeta_ParseFromBuffer_1 ( this->xmpRef, buffer, bufferSize, options, maxDepth, &wResult )
 
 #define zXMPMeta_SerializeToBuffer_1(pktString,pktSize,options,padding,newline,indent,baseIndent) \
     WXMPMeta_SerializeToBuffer_1 ( this->xmpRef, pktString, pktSize, options, padding, newline, indent, baseIndent, &wResult )
@@ -251,6 +254,9 @@ extern void
 WXMPMeta_DeleteNamespace_1 ( XMP_StringPtr namespaceURI,
                              WXMP_Result * wResult );
 
+extern void
+WXMPMeta_GetNamespaceGeneration_1 ( WXMP_Result * wResult );
+
 // -------------------------------------------------------------------------------------------------
 
 extern void
@@ -600,6 +606,7 @@ WXMPMeta_ParseFromBuffer_1 ( XMPMetaRef     xmpRef,
                              XMP_StringPtr  buffer,
                              XMP_StringLen  bufferSize,
                              XMP_OptionBits options,
+                             XMP_Uns32      maxDepth,
                              WXMP_Result *  wResult );
 
 extern void
@@ -64,15 +64,17 @@ static void CommentHandler               ( void * userData, XMP_StringPtr commen
 
 // =================================================================================================
 
-extern "C" ExpatAdapter * XMP_NewExpatAdapter()
+extern "C" ExpatAdapter * XMP_NewExpatAdapter ( size_t maxDepth )
 {
-	return new ExpatAdapter;
+	return new ExpatAdapter ( maxDepth );
 }	// XMP_NewExpatAdapter
 
 // =================================================================================================
 
-ExpatAdapter::ExpatAdapter() : parser(0)
+ExpatAdapter::ExpatAdapter ( size_t _maxDepth /* = 0 */ )
+	: parser(0), elemDepth(0), nsDepth(0), isInvalid(false)
 {
+	this->maxDepth = _maxDepth;
 
 	#if XMP_DebugBuild
 		this->elemNesting = 0;
@@ -134,6 +136,15 @@ void ExpatAdapter::ParseBuffer ( const void * buffer, size_t length, bool last /
 	
 	status = XML_Parse ( this->parser, (const char *)buffer, length, last );
 	
+	if ( this->maxDepth != 0 ) {
+		// Exiv2 reports every XML error of a checked parse alike, as it did for the separate pass.
+		bool isBad = (status != XML_STATUS_OK) || this->isInvalid;
+		#if BanAllEntityUsage
+			isBad = isBad || this->isAborted;
+		#endif
+		if ( isBad ) XMP_Throw ( "Error in XMLValidator", kXMPErr_BadXML );
+	}
+	
 	#if BanAllEntityUsage
 		if ( this->isAborted ) XMP_Throw ( "DOCTYPE is not allowed", kXMPErr_BadXML );
 	#endif
@@ -183,6 +194,14 @@ void ExpatAdapter::ParseBuffer ( const void * buffer, size_t length, bool last /
 
 // =================================================================================================
 
+static void StopInvalidParse ( ExpatAdapter * thiz )
+{
+	thiz->isInvalid = true;	// ! Can't throw an exception across the plain C Expat frames.
+	(void) XML_StopParser ( thiz->parser, XML_FALSE /* not resumable */ );
+}
+
+// =================================================================================================
+
 static void SetQualName ( XMP_StringPtr fullName, XML_Node * node )
 {
 	// Expat delivers the full name as a catenation of namespace URI, separator, and local name.
@@ -240,14 +259,15 @@ static void SetQualName ( XMP_StringPtr fullName, XML_Node * node )
 
 static void StartNamespaceDeclHandler ( void * userData, XMP_StringPtr prefix, XMP_StringPtr uri )
 {
-	IgnoreParam(userData);
-	
 	// As a bug fix hack, change a URI of "http://purl.org/dc/1.1/" to ""http://purl.org/dc/elements/1.1/.
 	// Early versions of Flash that put XMP in SWF used a bad URI for the dc: namespace.
 	
-	#if XMP_DebugBuild & DumpXMLParseEvents		// Avoid unused variable warning.
-		ExpatAdapter * thiz = (ExpatAdapter*)userData;
-	#endif
+	ExpatAdapter * thiz = (ExpatAdapter*)userData;
+
+	if ( thiz->maxDepth != 0 ) {
+		if ( thiz->nsDepth > thiz->maxDepth ) StopInvalidParse ( thiz );
+		++thiz->nsDepth;
+	}
 
 	if ( prefix == 0 ) prefix = "_dflt_";	// Have default namespace.
 	if ( uri == 0 ) return;	// Ignore, have xmlns:pre="", no URI to register.
@@ -268,11 +288,9 @@ static void StartNamespaceDeclHandler ( void * userData, XMP_StringPtr prefix, X
 
 static void EndNamespaceDeclHandler ( void * userData, XMP_StringPtr prefix )
 {
-	IgnoreParam(userData);
+	ExpatAdapter * thiz = (ExpatAdapter*)userData;
 
-	#if XMP_DebugBuild & DumpXMLParseEvents		// Avoid unused variable warning.
-		ExpatAdapter * thiz = (ExpatAdapter*)userData;
-	#endif
+	if ( thiz->nsDepth > 0 ) --thiz->nsDepth;
 
 	if ( prefix == 0 ) prefix = "_dflt_";	// Have default namespace.
 	
@@ -299,6 +317,13 @@ static void StartElementHandler ( void * userData, XMP_StringPtr name, XMP_Strin
 	if ( (attrCount & 1) != 0 )	XMP_Throw ( "Expat attribute info has odd length", kXMPErr_ExternalFailure );
 	attrCount = attrCount/2;	// They are name/value pairs.
 	
+	if ( thiz->maxDepth != 0 ) {
+		// Very deep trees could overflow the stack in the recursive RDF parser. The node is still
+		// added, the parse stack must stay balanced for the end tags Expat may yet deliver.
+		if ( thiz->elemDepth > thiz->maxDepth ) StopInvalidParse ( thiz );
+		++thiz->elemDepth;
+	}
+	
 	#if XMP_DebugBuild & DumpXMLParseEvents
 		if ( thiz->parseLog != 0 ) {
 			PrintIndent ( thiz->parseLog, thiz->elemNesting );
@@ -351,6 +376,7 @@ static void EndElementHandler ( void * userData, XMP_StringPtr name )
 	
 	ExpatAdapter * thiz = (ExpatAdapter*)userData;
 
+	if ( thiz->elemDepth > 0 ) --thiz->elemDepth;
 	#if XMP_DebugBuild
 		--thiz->elemNesting;
 	#endif
@@ -17,7 +17,7 @@
 // =================================================================================================
 
 #ifndef BanAllEntityUsage
-	#define BanAllEntityUsage	0
+	#define BanAllEntityUsage	1	// ! Exiv2 has no other DOCTYPE check since XMLValidator was folded in here.
 #endif
 
 struct XML_ParserStruct;	// ! Hack to avoid exposing expat.h to all clients.
@@ -36,14 +36,20 @@ public:
 		size_t elemNesting;
 	#endif
 	
-	ExpatAdapter();
+	// The checks of Exiv2's former XMLValidator, made in the same Expat pass. A maxDepth of 0
+	// turns them off, otherwise deeper element or namespace nesting stops the parse.
+	size_t elemDepth;
+	size_t nsDepth;
+	bool isInvalid;
+	
+	ExpatAdapter ( size_t _maxDepth = 0 );
 	virtual ~ExpatAdapter();
 	
 	void ParseBuffer ( const void * buffer, size_t length, bool last = true );
 
 };
 
-extern "C" ExpatAdapter * XMP_NewExpatAdapter();
+extern "C" ExpatAdapter * XMP_NewExpatAdapter ( size_t maxDepth );
 
 // =================================================================================================
 
@@ -386,7 +386,12 @@ AddChildNode ( XMP_Node * xmpParent, const XML_Node & xmlNode, const XMP_StringP
 		xmpParent = schemaNode;
 		
 		// If this is an alias set the isAlias flag in the node and the hasAliases flag in the tree.
-		if ( sRegisteredAliasMap->find ( xmlNode.name ) != sRegisteredAliasMap->end() ) {
+		bool isAlias;
+		{
+			XMP_NamespaceReadLock nsLock ( sNamespaceLock );
+			isAlias = (sRegisteredAliasMap->find ( xmlNode.name ) != sRegisteredAliasMap->end());
+		}
+		if ( isAlias ) {
 			childOptions |= kXMP_PropIsAlias;
 			schemaNode->parent->options |= kXMP_PropHasAliases;
 		}
@@ -38,7 +38,7 @@ WXMPIterator_PropCTor_1 ( XMPMetaRef     xmpRef,
                           XMP_OptionBits options,
                           WXMP_Result *  wResult )
 {
-    XMP_ENTER_WRAPPER ( "WXMPIterator_PropCTor_1" )
+    XMP_ENTER_OBJECT_WRAPPER ( "WXMPIterator_PropCTor_1" )
 
 		if ( schemaNS == 0 ) schemaNS = "";
 		if ( propName == 0 ) propName = "";
@@ -79,7 +79,7 @@ void
 WXMPIterator_IncrementRefCount_1 ( XMPIteratorRef iterRef )
 {
 	WXMP_Result * wResult = &void_wResult;	// ! Needed to "fool" the EnterWrapper macro.
-	XMP_ENTER_WRAPPER ( "WXMPIterator_IncrementRefCount_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPIterator_IncrementRefCount_1" )
 
 		XMPIterator * thiz = (XMPIterator*)iterRef;
 		
@@ -95,7 +95,7 @@ void
 WXMPIterator_DecrementRefCount_1 ( XMPIteratorRef iterRef )
 {
 	WXMP_Result * wResult = &void_wResult;	// ! Needed to "fool" the EnterWrapper macro.
-	XMP_ENTER_WRAPPER ( "WXMPIterator_DecrementRefCount_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPIterator_DecrementRefCount_1" )
 
 		XMPIterator * thiz = (XMPIterator*)iterRef;
 		
@@ -134,7 +134,7 @@ WXMPIterator_Next_1 ( XMPIteratorRef   iterRef,
                       XMP_OptionBits * propOptions,
                       WXMP_Result *    wResult )
 {
-    XMP_ENTER_WRAPPER ( "WXMPIterator_Next_1" )
+    XMP_ENTER_OBJECT_WRAPPER ( "WXMPIterator_Next_1" )
 
 		if ( schemaNS == 0 ) schemaNS = &voidStringPtr;
 		if ( nsSize == 0 ) nsSize = &voidStringLen;
@@ -158,7 +158,7 @@ WXMPIterator_Skip_1 ( XMPIteratorRef iterRef,
                       XMP_OptionBits options,
                       WXMP_Result *  wResult )
 {
-    XMP_ENTER_WRAPPER ( "WXMPIterator_Skip_1" )
+    XMP_ENTER_OBJECT_WRAPPER ( "WXMPIterator_Skip_1" )
 
 		XMPIterator * iter = WtoXMPIterator_Ptr ( iterRef );
 		iter->Skip ( options );
@@ -75,7 +75,7 @@ WXMPMeta_Terminate_1()
 void
 WXMPMeta_CTor_1 ( WXMP_Result * wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_CTor_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_CTor_1" )
 
 		XMPMeta * xmpObj = new XMPMeta();
 		++xmpObj->clientRefs;
@@ -91,7 +91,7 @@ void
 WXMPMeta_IncrementRefCount_1 ( XMPMetaRef xmpRef )
 {
 	WXMP_Result * wResult = &void_wResult;	// ! Needed to "fool" the EnterWrapper macro.
-	XMP_ENTER_WRAPPER ( "WXMPMeta_IncrementRefCount_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_IncrementRefCount_1" )
 
 		XMPMeta * thiz = (XMPMeta*)xmpRef;
 		
@@ -107,7 +107,7 @@ void
 WXMPMeta_DecrementRefCount_1 ( XMPMetaRef xmpRef )
 {
 	WXMP_Result * wResult = &void_wResult;	// ! Needed to "fool" the EnterWrapper macro.
-	XMP_ENTER_WRAPPER ( "WXMPMeta_DecrementRefCount_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_DecrementRefCount_1" )
 
 		XMPMeta * thiz = (XMPMeta*)xmpRef;
 		
@@ -289,6 +289,18 @@ WXMPMeta_DeleteNamespace_1 ( XMP_StringPtr namespaceURI,
 
 // -------------------------------------------------------------------------------------------------
 
+/* class static */ void
+WXMPMeta_GetNamespaceGeneration_1 ( WXMP_Result * wResult )
+{
+	XMP_ENTER_WRAPPER ( "WXMPMeta_GetNamespaceGeneration_1" )
+
+		wResult->int64Result = XMPMeta::GetNamespaceGeneration();
+
+	XMP_EXIT_WRAPPER
+}
+
+// -------------------------------------------------------------------------------------------------
+
 /* class static */ void
 WXMPMeta_RegisterAlias_1 ( XMP_StringPtr  aliasNS,
 						   XMP_StringPtr  aliasProp,
@@ -378,20 +390,18 @@ WXMPMeta_RegisterStandardAliases_1 ( XMP_StringPtr schemaNS,
 //
 //		validate parameters
 //		try
-//			acquire object lock
 //			call through to the implementation
-//			retain object lock if necessary
 //		catch anything and return an appropriate XMP_Error object
 //		return null (no error if we get to here)
 //
-// The object lock is acquired through a local wrapper object that automatically unlocks when the
-// try-block is exited. The lock must be retained if the function is returning a string result. The
-// output string is owned by the object, the client must copy the string then release the lock. The
-// lock used here is the per-object lock. For simplicity at this time the lock is a simple mutual
-// exclusion lock, we do not allow multiple concurrent readers.
+// The methods do not acquire the toolkit lock, different objects can be used concurrently by
+// different threads. An object must not be used by more than one thread at a time. Output strings
+// are owned by the object or are per thread, the client must copy them before the next call. The
+// shared namespace and alias maps are protected by sNamespaceLock where the implementation uses
+// them.
 //
-// The one exception to this model is UnlockObject. It does not acquire the object lock since this
-// is the function the client calls to release the lock after copying an output string!
+// UnlockObject is kept for the client glue, which calls it after copying an output string. It
+// does nothing.
 //
 // =================================================================================================
 
@@ -404,7 +414,7 @@ WXMPMeta_GetProperty_1 ( XMPMetaRef		  xmpRef,
 						 XMP_OptionBits * options,
 						 WXMP_Result *	  wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_GetProperty_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_GetProperty_1" )
 	
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -432,7 +442,7 @@ WXMPMeta_GetArrayItem_1 ( XMPMetaRef	   xmpRef,
 						  XMP_OptionBits * options,
 						  WXMP_Result *	   wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_GetArrayItem_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_GetArrayItem_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (arrayName == 0) || (*arrayName == 0) ) XMP_Throw ( "Empty array name", kXMPErr_BadXPath );
@@ -461,7 +471,7 @@ WXMPMeta_GetStructField_1 ( XMPMetaRef		 xmpRef,
 							XMP_OptionBits * options,
 							WXMP_Result *	 wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_GetStructField_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_GetStructField_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (structName == 0) || (*structName == 0) ) XMP_Throw ( "Empty struct name", kXMPErr_BadXPath );
@@ -492,7 +502,7 @@ WXMPMeta_GetQualifier_1 ( XMPMetaRef	   xmpRef,
 						  XMP_OptionBits * options,
 						  WXMP_Result *	   wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_GetQualifier_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_GetQualifier_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -520,7 +530,7 @@ WXMPMeta_SetProperty_1 ( XMPMetaRef		xmpRef,
 						 XMP_OptionBits options,
 						 WXMP_Result *	wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_SetProperty_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_SetProperty_1" )
 
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -542,7 +552,7 @@ WXMPMeta_SetArrayItem_1 ( XMPMetaRef	 xmpRef,
 						  XMP_OptionBits options,
 						  WXMP_Result *	 wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_SetArrayItem_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_SetArrayItem_1" )
 
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (arrayName == 0) || (*arrayName == 0) ) XMP_Throw ( "Empty array name", kXMPErr_BadXPath );
@@ -564,7 +574,7 @@ WXMPMeta_AppendArrayItem_1 ( XMPMetaRef		xmpRef,
 							 XMP_OptionBits options,
 							 WXMP_Result *	wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_AppendArrayItem_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_AppendArrayItem_1" )
 
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (arrayName == 0) || (*arrayName == 0) ) XMP_Throw ( "Empty array name", kXMPErr_BadXPath );
@@ -587,7 +597,7 @@ WXMPMeta_SetStructField_1 ( XMPMetaRef	   xmpRef,
 							XMP_OptionBits options,
 							WXMP_Result *  wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_SetStructField_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_SetStructField_1" )
 
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (structName == 0) || (*structName == 0) ) XMP_Throw ( "Empty struct name", kXMPErr_BadXPath );
@@ -612,7 +622,7 @@ WXMPMeta_SetQualifier_1 ( XMPMetaRef	 xmpRef,
 						  XMP_OptionBits options,
 						  WXMP_Result *	 wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_SetQualifier_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_SetQualifier_1" )
 
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -633,7 +643,7 @@ WXMPMeta_DeleteProperty_1 ( XMPMetaRef	  xmpRef,
 							XMP_StringPtr propName,
 							WXMP_Result * wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_DeleteProperty_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_DeleteProperty_1" )
  
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -653,7 +663,7 @@ WXMPMeta_DeleteArrayItem_1 ( XMPMetaRef	   xmpRef,
 							 XMP_Index	   itemIndex,
 							 WXMP_Result * wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_DeleteArrayItem_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_DeleteArrayItem_1" )
 
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (arrayName == 0) || (*arrayName == 0) ) XMP_Throw ( "Empty array name", kXMPErr_BadXPath );
@@ -674,7 +684,7 @@ WXMPMeta_DeleteStructField_1 ( XMPMetaRef	 xmpRef,
 							   XMP_StringPtr fieldName,
 							   WXMP_Result * wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_DeleteStructField_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_DeleteStructField_1" )
 
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (structName == 0) || (*structName == 0) ) XMP_Throw ( "Empty struct name", kXMPErr_BadXPath );
@@ -697,7 +707,7 @@ WXMPMeta_DeleteQualifier_1 ( XMPMetaRef	   xmpRef,
 							 XMP_StringPtr qualName,
 							 WXMP_Result * wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_DeleteQualifier_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_DeleteQualifier_1" )
 
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -718,7 +728,7 @@ WXMPMeta_DoesPropertyExist_1 ( XMPMetaRef	 xmpRef,
 							   XMP_StringPtr propName,
 							   WXMP_Result * wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_DoesPropertyExist_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_DoesPropertyExist_1" )
 	
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -739,7 +749,7 @@ WXMPMeta_DoesArrayItemExist_1 ( XMPMetaRef	  xmpRef,
 								XMP_Index	  itemIndex,
 								WXMP_Result * wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_DoesArrayItemExist_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_DoesArrayItemExist_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (arrayName == 0) || (*arrayName == 0) ) XMP_Throw ( "Empty array name", kXMPErr_BadXPath );
@@ -761,7 +771,7 @@ WXMPMeta_DoesStructFieldExist_1 ( XMPMetaRef	xmpRef,
 								  XMP_StringPtr fieldName,
 								  WXMP_Result * wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_DoesStructFieldExist_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_DoesStructFieldExist_1" )
 
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (structName == 0) || (*structName == 0) ) XMP_Throw ( "Empty struct name", kXMPErr_BadXPath );
@@ -785,7 +795,7 @@ WXMPMeta_DoesQualifierExist_1 ( XMPMetaRef	  xmpRef,
 								XMP_StringPtr qualName,
 								WXMP_Result * wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_DoesQualifierExist_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_DoesQualifierExist_1" )
 
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -814,7 +824,7 @@ WXMPMeta_GetLocalizedText_1 ( XMPMetaRef	   xmpRef,
 							  XMP_OptionBits * options,
 							  WXMP_Result *	   wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_GetLocalizedText_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_GetLocalizedText_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (arrayName == 0) || (*arrayName == 0) ) XMP_Throw ( "Empty array name", kXMPErr_BadXPath );
@@ -847,7 +857,7 @@ WXMPMeta_SetLocalizedText_1 ( XMPMetaRef	 xmpRef,
 							  XMP_OptionBits options,
 							  WXMP_Result *	 wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_SetLocalizedText_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_SetLocalizedText_1" )
 
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (arrayName == 0) || (*arrayName == 0) ) XMP_Throw ( "Empty array name", kXMPErr_BadXPath );
@@ -871,7 +881,7 @@ WXMPMeta_GetProperty_Bool_1 ( XMPMetaRef	   xmpRef,
 							  XMP_OptionBits * options,
 							  WXMP_Result *	   wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_GetProperty_Bool_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_GetProperty_Bool_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -898,7 +908,7 @@ WXMPMeta_GetProperty_Int_1 ( XMPMetaRef		  xmpRef,
 							 XMP_OptionBits * options,
 							 WXMP_Result *	  wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_GetProperty_Int_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_GetProperty_Int_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -923,7 +933,7 @@ WXMPMeta_GetProperty_Int64_1 ( XMPMetaRef		  xmpRef,
 							   XMP_OptionBits * options,
 							   WXMP_Result *	  wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_GetProperty_Int64_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_GetProperty_Int64_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -948,7 +958,7 @@ WXMPMeta_GetProperty_Float_1 ( XMPMetaRef		xmpRef,
 							   XMP_OptionBits * options,
 							   WXMP_Result *	wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_GetProperty_Float_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_GetProperty_Float_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -973,7 +983,7 @@ WXMPMeta_GetProperty_Date_1 ( XMPMetaRef	   xmpRef,
 							  XMP_OptionBits * options,
 							  WXMP_Result *	   wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_GetProperty_Date_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_GetProperty_Date_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -998,7 +1008,7 @@ WXMPMeta_SetProperty_Bool_1 ( XMPMetaRef	 xmpRef,
 							  XMP_OptionBits options,
 							  WXMP_Result *	 wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_SetProperty_Bool_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_SetProperty_Bool_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -1019,7 +1029,7 @@ WXMPMeta_SetProperty_Int_1 ( XMPMetaRef		xmpRef,
 							 XMP_OptionBits options,
 							 WXMP_Result *	wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_SetProperty_Int_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_SetProperty_Int_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -1040,7 +1050,7 @@ WXMPMeta_SetProperty_Int64_1 ( XMPMetaRef	  xmpRef,
 							   XMP_OptionBits options,
 							   WXMP_Result *  wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_SetProperty_Int64_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_SetProperty_Int64_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -1061,7 +1071,7 @@ WXMPMeta_SetProperty_Float_1 ( XMPMetaRef	  xmpRef,
 							   XMP_OptionBits options,
 							   WXMP_Result *  wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_SetProperty_Float_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_SetProperty_Float_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -1082,7 +1092,7 @@ WXMPMeta_SetProperty_Date_1 ( XMPMetaRef		   xmpRef,
 							  XMP_OptionBits	   options,
 							  WXMP_Result *		   wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_SetProperty_Date_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_SetProperty_Date_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (propName == 0) || (*propName == 0) ) XMP_Throw ( "Empty property name", kXMPErr_BadXPath );
@@ -1101,7 +1111,7 @@ WXMPMeta_DumpObject_1 ( XMPMetaRef		   xmpRef,
 						void *			   refCon,
 						WXMP_Result *	   wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_DumpObject_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_DumpObject_1" )
 
 		if ( outProc == 0 ) XMP_Throw ( "Null client output routine", kXMPErr_BadParam );
 		
@@ -1118,7 +1128,7 @@ void
 WXMPMeta_Sort_1 ( XMPMetaRef	xmpRef,
 				  WXMP_Result * wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_Sort_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_Sort_1" )
 
 		XMPMeta * meta = WtoXMPMeta_Ptr ( xmpRef );
 		meta->Sort();
@@ -1132,7 +1142,7 @@ void
 WXMPMeta_Erase_1 ( XMPMetaRef	xmpRef,
 				   WXMP_Result * wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_Erase_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_Erase_1" )
 
 		XMPMeta * meta = WtoXMPMeta_Ptr ( xmpRef );
 		meta->Erase();
@@ -1147,7 +1157,7 @@ WXMPMeta_Clone_1 ( XMPMetaRef	  xmpRef,
 				   XMP_OptionBits options,
 				   WXMP_Result *  wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_Clone_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_Clone_1" )
 
 		const XMPMeta & xOriginal = WtoXMPMeta_Ref ( xmpRef );
 		XMPMeta * xClone = new XMPMeta;
@@ -1166,7 +1176,7 @@ WXMPMeta_CountArrayItems_1 ( XMPMetaRef	   xmpRef,
 							 XMP_StringPtr arrayName,
 							 WXMP_Result * wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_CountArrayItems_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_CountArrayItems_1" )
 		
 		if ( (schemaNS == 0) || (*schemaNS == 0) ) XMP_Throw ( "Empty schema namespace URI", kXMPErr_BadSchema );
 		if ( (arrayName == 0) || (*arrayName == 0) ) XMP_Throw ( "Empty array name", kXMPErr_BadXPath );
@@ -1201,7 +1211,7 @@ WXMPMeta_GetObjectName_1 ( XMPMetaRef	   xmpRef,
 						   XMP_StringLen * nameLen,
 						   WXMP_Result *   wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_GetObjectName_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_GetObjectName_1" )
 
 		if ( namePtr == 0 ) namePtr = &voidStringPtr;
 		if ( nameLen == 0 ) nameLen = &voidStringLen;
@@ -1219,7 +1229,7 @@ WXMPMeta_SetObjectName_1 ( XMPMetaRef	 xmpRef,
 						   XMP_StringPtr name,
 						   WXMP_Result * wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_SetObjectName_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_SetObjectName_1" )
 
 		if ( name == 0 ) name = "";
 
@@ -1235,7 +1245,7 @@ void
 WXMPMeta_GetObjectOptions_1 ( XMPMetaRef    xmpRef,
 							  WXMP_Result * wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_GetObjectOptions_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_GetObjectOptions_1" )
 
 		const XMPMeta & meta = WtoXMPMeta_Ref ( xmpRef );
 		XMP_OptionBits options = meta.GetObjectOptions();
@@ -1251,7 +1261,7 @@ WXMPMeta_SetObjectOptions_1 ( XMPMetaRef	 xmpRef,
 							  XMP_OptionBits options,
 							  WXMP_Result *	 wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_SetObjectOptions_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_SetObjectOptions_1" )
 	
 		XMPMeta * meta = WtoXMPMeta_Ptr ( xmpRef );
 		meta->SetObjectOptions ( options );
@@ -1266,12 +1276,13 @@ WXMPMeta_ParseFromBuffer_1 ( XMPMetaRef		xmpRef,
 							 XMP_StringPtr	buffer,
 							 XMP_StringLen	bufferSize,
 							 XMP_OptionBits options,
+							 XMP_Uns32		maxDepth,
 							 WXMP_Result *	wResult )
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_ParseFromBuffer_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_ParseFromBuffer_1" )
 
 		XMPMeta * meta = WtoXMPMeta_Ptr ( xmpRef );
-		meta->ParseFromBuffer ( buffer, bufferSize, options );
+		meta->ParseFromBuffer ( buffer, bufferSize, options, maxDepth );
 		
 	XMP_EXIT_WRAPPER
 }
@@ -1289,7 +1300,7 @@ WXMPMeta_SerializeToBuffer_1 ( XMPMetaRef	   xmpRef,
 							   XMP_Index	   baseIndent,
 							   WXMP_Result *   wResult ) /* const */
 {
-	XMP_ENTER_WRAPPER ( "WXMPMeta_SerializeToBuffer_1" )
+	XMP_ENTER_OBJECT_WRAPPER ( "WXMPMeta_SerializeToBuffer_1" )
 
 		if ( rdfString == 0 ) rdfString = &voidStringPtr;
 		if ( rdfSize == 0 ) rdfSize = &voidStringLen;
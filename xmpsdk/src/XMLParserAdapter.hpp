@@ -109,7 +109,7 @@ class XMLParserAdapter {
 public:
 
 	XMLParserAdapter()
-		: tree(0,"",kRootNode), rootNode(0), rootCount(0), charEncoding(XMP_OptionBits(-1)), pendingCount(0)
+		: tree(0,"",kRootNode), rootNode(0), rootCount(0), charEncoding(XMP_OptionBits(-1)), pendingCount(0), maxDepth(0)
 	{
 		#if XMP_DebugBuild
 			parseLog = 0;
@@ -128,6 +128,7 @@ public:
 	XMP_OptionBits	charEncoding;
 	size_t          pendingCount;
 	unsigned char	pendingInput[kXMLPendingInputMax];	// Buffered input for character encoding checks.
+	size_t			maxDepth;	// Nesting limit of a strict parse, 0 for the usual tolerant one.
 	
 	#if XMP_DebugBuild
 		FILE * parseLog;
@@ -52,31 +52,37 @@ XMP_Int32 sXMP_InitCount = 0;
 
 XMP_StringMap *	sNamespaceURIToPrefixMap = 0;
 XMP_StringMap *	sNamespacePrefixToURIMap = 0;
+XMP_Uns64		sNamespaceGeneration = 0;
 
 XMP_AliasMap *	sRegisteredAliasMap = 0;	// Needed by XMPIterator.
 
-XMP_VarString *	sOutputNS  = 0;
-XMP_VarString *	sOutputStr = 0;
+static thread_local XMP_VarString sThreadOutputNS;
+static thread_local XMP_VarString sThreadOutputStr;
+
+thread_local XMP_VarString *	sOutputNS  = &sThreadOutputNS;
+thread_local XMP_VarString *	sOutputStr = &sThreadOutputStr;
 XMP_VarString * sExceptionMessage = 0;
 
 XMP_Mutex sXMPCoreLock;
 int sLockCount = 0;
 
+std::shared_mutex sNamespaceLock;
+
 #if TraceXMPCalls
 	FILE * xmpOut = stderr;
 #endif
 
-void *              voidVoidPtr    = 0;	// Used to backfill null output parameters.
-XMP_StringPtr		voidStringPtr  = 0;
-XMP_StringLen		voidStringLen  = 0;
-XMP_OptionBits		voidOptionBits = 0;
-XMP_Uns8			voidByte       = 0;
-bool				voidBool       = 0;
-XMP_Int32			voidInt32      = 0;
-XMP_Int64			voidInt64      = 0;
-double				voidDouble     = 0.0;
-XMP_DateTime		voidDateTime;
-WXMP_Result 		void_wResult;
+thread_local void *				voidVoidPtr    = 0;	// Used to backfill null output parameters.
+thread_local XMP_StringPtr		voidStringPtr  = 0;
+thread_local XMP_StringLen		voidStringLen  = 0;
+thread_local XMP_OptionBits		voidOptionBits = 0;
+thread_local XMP_Uns8			voidByte       = 0;
+thread_local bool				voidBool       = 0;
+thread_local XMP_Int32			voidInt32      = 0;
+thread_local XMP_Int64			voidInt64      = 0;
+thread_local double				voidDouble     = 0.0;
+thread_local XMP_DateTime		voidDateTime;
+thread_local WXMP_Result 		void_wResult;
 
 // =================================================================================================
 // Mutex Utilities
@@ -168,9 +174,14 @@ VerifyXPathRoot	( XMP_StringPtr			schemaURI,
 		}
 	}
 
-	XMP_StringMapPos uriPos = sNamespaceURIToPrefixMap->find ( XMP_VarString ( schemaURI ) );
-	if ( uriPos == sNamespaceURIToPrefixMap->end() ) {
-		XMP_Throw ( "Unregistered schema namespace URI", kXMPErr_BadSchema );
+	XMP_VarString uriPrefix;
+	{
+		XMP_NamespaceReadLock nsLock ( sNamespaceLock );
+		XMP_StringMapPos uriPos = sNamespaceURIToPrefixMap->find ( XMP_VarString ( schemaURI ) );
+		if ( uriPos == sNamespaceURIToPrefixMap->end() ) {
+			XMP_Throw ( "Unregistered schema namespace URI", kXMPErr_BadSchema );
+		}
+		uriPrefix = uriPos->second;
 	}
 
 	XMP_StringPtr colonPos = propName;
@@ -184,7 +195,7 @@ VerifyXPathRoot	( XMP_StringPtr			schemaURI,
 		// The propName is unqualified, use the schemaURI and associated prefix.
 		
 		expandedXPath->push_back ( XPathStepInfo ( schemaURI, kXMP_SchemaNode ) );
-		expandedXPath->push_back ( XPathStepInfo ( uriPos->second, 0 ) );
+		expandedXPath->push_back ( XPathStepInfo ( uriPrefix, 0 ) );
 		(*expandedXPath)[kRootPropStep].step += propName;
 	
 	} else {
@@ -195,11 +206,14 @@ VerifyXPathRoot	( XMP_StringPtr			schemaURI,
 		VerifySimpleXMLName ( colonPos+1, colonPos+strlen(colonPos) );
 
 		XMP_VarString prefix ( propName, prefixLen );
-		XMP_StringMapPos prefixPos = sNamespacePrefixToURIMap->find ( prefix );
-		if ( prefixPos == sNamespacePrefixToURIMap->end() ) {
-			XMP_Throw ( "Unknown schema namespace prefix", kXMPErr_BadSchema );
+		{
+			XMP_NamespaceReadLock nsLock ( sNamespaceLock );
+			XMP_StringMapPos prefixPos = sNamespacePrefixToURIMap->find ( prefix );
+			if ( prefixPos == sNamespacePrefixToURIMap->end() ) {
+				XMP_Throw ( "Unknown schema namespace prefix", kXMPErr_BadSchema );
+			}
 		}
-		if ( prefix != uriPos->second ) {
+		if ( prefix != uriPrefix ) {
 			XMP_Throw ( "Schema namespace URI and prefix mismatch", kXMPErr_BadSchema );
 		}
 
@@ -228,6 +242,7 @@ VerifyQualName ( XMP_StringPtr qualName, XMP_StringPtr nameEnd )
 
 	size_t prefixLen = colonPos - qualName + 1;	// ! Include the colon.
 	XMP_VarString prefix ( qualName, prefixLen );
+	XMP_NamespaceReadLock nsLock ( sNamespaceLock );
 	XMP_StringMapPos prefixPos = sNamespacePrefixToURIMap->find ( prefix );
 	if ( prefixPos == sNamespacePrefixToURIMap->end() ) {
 		XMP_Throw ( "Unknown namespace prefix for qualified name", kXMPErr_BadXPath );
@@ -688,8 +703,11 @@ ExpandXPath	( XMP_StringPtr			schemaNS,
 	VerifyXPathRoot ( schemaNS, currStep.c_str(), expandedXPath );
 
 	XMP_OptionBits stepFlags = kXMP_StructFieldStep;	
-	if ( sRegisteredAliasMap->find ( (*expandedXPath)[kRootPropStep].step ) != sRegisteredAliasMap->end() ) {
-		stepFlags |= kXMP_StepIsAlias;
+	{
+		XMP_NamespaceReadLock nsLock ( sNamespaceLock );
+		if ( sRegisteredAliasMap->find ( (*expandedXPath)[kRootPropStep].step ) != sRegisteredAliasMap->end() ) {
+			stepFlags |= kXMP_StepIsAlias;
+		}
 	}
 	(*expandedXPath)[kRootPropStep].options |= stepFlags;
 		
@@ -1093,10 +1111,15 @@ FindNode ( XMP_Node *		xmpTree,
 
 		stepNum = 2;	// ! Continue processing the original path at the second level step.
 
-		XMP_AliasMapPos aliasPos = sRegisteredAliasMap->find ( expandedXPath[kRootPropStep].step );
-		XMP_Assert ( aliasPos != sRegisteredAliasMap->end() );
+		XMP_ExpandedXPath aliasPath;
+		{
+			XMP_NamespaceReadLock nsLock ( sNamespaceLock );
+			XMP_AliasMapPos aliasPos = sRegisteredAliasMap->find ( expandedXPath[kRootPropStep].step );
+			XMP_Assert ( aliasPos != sRegisteredAliasMap->end() );
+			aliasPath = aliasPos->second;
+		}
 		
-		currNode = FindSchemaNode ( xmpTree, aliasPos->second[kSchemaStep].step.c_str(), createNodes, &currPos );
+		currNode = FindSchemaNode ( xmpTree, aliasPath[kSchemaStep].step.c_str(), createNodes, &currPos );
 		if ( currNode == 0 ) goto EXIT;
 		if ( currNode->options & kXMP_NewImplicitNode ) {
 			currNode->options ^= kXMP_NewImplicitNode;	// Clear the implicit node bit.
@@ -1104,7 +1127,7 @@ FindNode ( XMP_Node *		xmpTree,
 			leafIsNew = true;	// If any parent is new, the leaf will be new also.
 		}
 
-		currNode = FollowXPathStep ( currNode, aliasPos->second, 1, createNodes, &currPos );
+		currNode = FollowXPathStep ( currNode, aliasPath, 1, createNodes, &currPos );
 		if ( currNode == 0 ) goto EXIT;
 		if ( currNode->options & kXMP_NewImplicitNode ) {
 			currNode->options ^= kXMP_NewImplicitNode;	// Clear the implicit node bit.
@@ -1113,12 +1136,12 @@ FindNode ( XMP_Node *		xmpTree,
 			leafIsNew = true;	// If any parent is new, the leaf will be new also.
 		}
 		
-		XMP_OptionBits arrayForm = aliasPos->second[kRootPropStep].options & kXMP_PropArrayFormMask;
+		XMP_OptionBits arrayForm = aliasPath[kRootPropStep].options & kXMP_PropArrayFormMask;
 		XMP_Assert ( (arrayForm == 0) || (arrayForm & kXMP_PropValueIsArray) );
-		XMP_Assert ( (arrayForm == 0) ? (aliasPos->second.size() == 2) : (aliasPos->second.size() == 3) );
+		XMP_Assert ( (arrayForm == 0) ? (aliasPath.size() == 2) : (aliasPath.size() == 3) );
 		
 		if ( arrayForm != 0 ) { 
-			currNode = FollowXPathStep ( currNode, aliasPos->second, 2, createNodes, &currPos, true );
+			currNode = FollowXPathStep ( currNode, aliasPath, 2, createNodes, &currPos, true );
 			if ( currNode == 0 ) goto EXIT;
 			if ( currNode->options & kXMP_NewImplicitNode ) {
 				currNode->options ^= kXMP_NewImplicitNode;	// Clear the implicit node bit.
@@ -18,6 +18,8 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <mutex>
+#include <shared_mutex>
 
 #include <cassert>
 #include <cstring>
@@ -75,21 +77,32 @@ extern XMP_AliasMap *	sRegisteredAliasMap;
 
 extern XMP_StringMap *	sNamespaceURIToPrefixMap;
 extern XMP_StringMap *	sNamespacePrefixToURIMap;
+extern XMP_Uns64		sNamespaceGeneration;	// Changed by every change of the namespace maps.
 
-extern XMP_VarString *	sOutputNS;
-extern XMP_VarString *	sOutputStr;
-
-extern void *			voidVoidPtr;	// Used to backfill null output parameters.
-extern XMP_StringPtr	voidStringPtr;
-extern XMP_StringLen	voidStringLen;
-extern XMP_OptionBits	voidOptionBits;
-extern XMP_Bool			voidByte;
-extern bool				voidBool;
-extern XMP_Int32		voidInt32;
-extern XMP_Int64		voidInt64;
-extern double			voidDouble;
-extern XMP_DateTime		voidDateTime;
-extern WXMP_Result		void_wResult;
+// The namespace and alias maps are shared by all XMPMeta objects. The object methods are not
+// serialized by sXMPCoreLock, they take sNamespaceLock around each access to the maps instead. It
+// is never held across a call that could take it again.
+extern std::shared_mutex sNamespaceLock;
+
+typedef std::shared_lock < std::shared_mutex > XMP_NamespaceReadLock;
+typedef std::unique_lock < std::shared_mutex > XMP_NamespaceWriteLock;
+
+// Output strings returned to the client and backfilled output parameters are per thread.
+
+extern thread_local XMP_VarString *	sOutputNS;
+extern thread_local XMP_VarString *	sOutputStr;
+
+extern thread_local void *			voidVoidPtr;	// Used to backfill null output parameters.
+extern thread_local XMP_StringPtr	voidStringPtr;
+extern thread_local XMP_StringLen	voidStringLen;
+extern thread_local XMP_OptionBits	voidOptionBits;
+extern thread_local XMP_Bool		voidByte;
+extern thread_local bool			voidBool;
+extern thread_local XMP_Int32		voidInt32;
+extern thread_local XMP_Int64		voidInt64;
+extern thread_local double			voidDouble;
+extern thread_local XMP_DateTime	voidDateTime;
+extern thread_local WXMP_Result		void_wResult;
 
 #define kHexDigits "0123456789ABCDEF"
 
@@ -245,6 +258,23 @@ private:
 		XMP_AutoMutex mutex;								\
 		wResult->errMessage = 0;
 
+// Object wrappers do not take the toolkit lock. An XMPMeta or XMPIterator object must not be used
+// by more than one thread at a time, output strings are owned by the object. The shared namespace
+// and alias maps are protected by sNamespaceLock.
+
+class XMP_ObjectMutex {
+public:
+	XMP_ObjectMutex() {};
+	void KeepLock() {};
+};
+
+#define XMP_ENTER_OBJECT_WRAPPER(proc)						\
+	AnnounceEntry ( proc );									\
+	XMP_Assert ( sXMP_InitCount > 0 );	                    \
+	try {													\
+		XMP_ObjectMutex mutex;								\
+		wResult->errMessage = 0;
+
 #define XMP_EXIT_WRAPPER	\
 	XMP_CATCH_EXCEPTIONS	\
 	AnnounceExit();
@@ -86,18 +86,26 @@ AddSchemaAliases ( IterInfo & info, IterNode & iterSchema, XMP_StringPtr schemaU
 	bool found = XMPMeta::GetNamespacePrefix ( schemaURI, &nsPrefix, &nsLen );
 	if ( ! found ) XMP_Throw ( "Unknown iteration namespace", kXMPErr_BadSchema );
 	
-	XMP_AliasMapPos currAlias = sRegisteredAliasMap->begin();
-	XMP_AliasMapPos endAlias  = sRegisteredAliasMap->end();
-	
-	for ( ; currAlias != endAlias; ++currAlias ) {
-		if ( XMP_LitNMatch ( currAlias->first.c_str(), nsPrefix, nsLen ) ) {
-			const XMP_Node * actualProp = FindConstNode ( &info.xmpObj->tree, currAlias->second );
-			if ( actualProp != 0 ) {
-				iterSchema.children.push_back ( IterNode ( (actualProp->options | kXMP_PropIsAlias), currAlias->first, 0 ) );
-				#if TraceIterators
-					printf ( "        %s  =>  %s\n", currAlias->first.c_str(), actualProp->name.c_str() );
-				#endif
-			}
+	// Copy the aliases of the schema, the alias map lock is not held while looking up the actuals.
+	
+	std::vector < std::pair < XMP_VarString, XMP_ExpandedXPath > > schemaAliases;
+	{
+		XMP_NamespaceReadLock nsLock ( sNamespaceLock );
+		XMP_AliasMapPos currAlias = sRegisteredAliasMap->begin();
+		XMP_AliasMapPos endAlias  = sRegisteredAliasMap->end();
+		for ( ; currAlias != endAlias; ++currAlias ) {
+			if ( XMP_LitNMatch ( currAlias->first.c_str(), nsPrefix, nsLen ) ) schemaAliases.push_back ( *currAlias );
+		}
+	}
+	
+	for ( size_t aliasNum = 0, aliasLim = schemaAliases.size(); aliasNum != aliasLim; ++aliasNum ) {
+		const XMP_VarString & aliasName = schemaAliases[aliasNum].first;
+		const XMP_Node * actualProp = FindConstNode ( &info.xmpObj->tree, schemaAliases[aliasNum].second );
+		if ( actualProp != 0 ) {
+			iterSchema.children.push_back ( IterNode ( (actualProp->options | kXMP_PropIsAlias), aliasName, 0 ) );
+			#if TraceIterators
+				printf ( "        %s  =>  %s\n", aliasName.c_str(), actualProp->name.c_str() );
+			#endif
 		}
 	}
 
@@ -529,10 +537,15 @@ XMPIterator::XMPIterator ( const XMPMeta & xmpObj,
 			// ! here to determine if the namespace has any aliases to existing properties. We then
 			// ! strip the children if necessary.
 
-			XMP_cStringMapPos currNS = sNamespaceURIToPrefixMap->begin();
-			XMP_cStringMapPos endNS  = sNamespaceURIToPrefixMap->end();
-			for ( ; currNS != endNS; ++currNS ) {
-				XMP_StringPtr schemaName = currNS->first.c_str();
+			std::vector < XMP_VarString > namespaceURIs;
+			{
+				XMP_NamespaceReadLock nsLock ( sNamespaceLock );
+				XMP_cStringMapPos currNS = sNamespaceURIToPrefixMap->begin();
+				XMP_cStringMapPos endNS  = sNamespaceURIToPrefixMap->end();
+				for ( ; currNS != endNS; ++currNS ) namespaceURIs.push_back ( currNS->first );
+			}
+			for ( size_t nsNum = 0, nsLim = namespaceURIs.size(); nsNum != nsLim; ++nsNum ) {
+				XMP_StringPtr schemaName = namespaceURIs[nsNum].c_str();
 				if ( FindConstSchema ( &xmpObj.tree, schemaName ) != 0 ) continue;
 				info.tree.children.push_back ( IterNode ( kXMP_SchemaNode, schemaName, 0 ) );
 				IterNode & iterSchema = info.tree.children.back();
@@ -729,7 +742,7 @@ XMPIterator::UnlockIter	( XMP_OptionBits options )
 {
 	UNUSED(options);
 
-	XMPMeta::Unlock ( 0 );
+	// Nothing to do, the iterator methods do not take the toolkit lock.
 	
 }	// UnlockIter
 
@@ -401,9 +401,13 @@ MoveExplicitAliases ( XMP_Node * tree, XMP_OptionBits parseOptions )
 
 			// Find the base path, look for the base schema and root node.
 
-			XMP_AliasMapPos aliasPos = sRegisteredAliasMap->find ( currProp->name );
-			XMP_Assert ( aliasPos != sRegisteredAliasMap->end() );
-			XMP_ExpandedXPath & basePath = aliasPos->second;
+			XMP_ExpandedXPath basePath;
+			{
+				XMP_NamespaceReadLock nsLock ( sNamespaceLock );
+				XMP_AliasMapPos aliasPos = sRegisteredAliasMap->find ( currProp->name );
+				XMP_Assert ( aliasPos != sRegisteredAliasMap->end() );
+				basePath = aliasPos->second;
+			}
 			XMP_OptionBits arrayOptions = (basePath[kRootPropStep].options & kXMP_PropArrayFormMask);
 
 			XMP_Node * baseSchema = FindSchemaNode ( tree, basePath[kSchemaStep].step.c_str(), kXMP_CreateNodes );
@@ -1092,7 +1096,8 @@ ProcessUTF8Portion ( XMLParserAdapter * xmlParser,
 void
 XMPMeta::ParseFromBuffer ( XMP_StringPtr  buffer,
 						   XMP_StringLen  xmpSize,
-						   XMP_OptionBits options )
+						   XMP_OptionBits options,
+						   XMP_Uns32      maxDepth /* = 0 */ )
 {
 	if ( (buffer == 0) && (xmpSize != 0) ) XMP_Throw ( "Null parse buffer", kXMPErr_BadParam );
 	if ( xmpSize == kXMP_UseNullTermination ) xmpSize = strlen ( buffer );
@@ -1103,7 +1108,7 @@ XMPMeta::ParseFromBuffer ( XMP_StringPtr  buffer,
 
 	if ( this->xmlParser == 0 ) {
 		if ( (xmpSize == 0) && lastClientCall ) return;	// Tolerate empty parse. Expat complains if there are no XML elements.
-		this->xmlParser = XMP_NewExpatAdapter();
+		this->xmlParser = XMP_NewExpatAdapter ( maxDepth );
 	}
 	
 	XMLParserAdapter& parser = *this->xmlParser;
@@ -1157,8 +1162,10 @@ XMPMeta::ParseFromBuffer ( XMP_StringPtr  buffer,
 		// handling to take care of things like ISO Latin-1 or unescaped ASCII controls.
 
 		XMP_Assert ( parser.charEncoding != XMP_OptionBits(-1) );
+		
+		// A strict parse takes the input as is, raw controls or Latin-1 are XML errors like any other.
 
-		if ( parser.charEncoding != kXMP_EncodeUTF8 ) {
+		if ( (parser.charEncoding != kXMP_EncodeUTF8) || (parser.maxDepth != 0) ) {
 		
 			if ( parser.pendingCount > 0 ) {
 				// Might have pendingInput from the above portion to determine the character encoding.
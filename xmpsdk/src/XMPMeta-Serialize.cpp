@@ -172,9 +172,14 @@ DeclareElemNamespace ( const XMP_VarString & elemName,
 
 	if ( colonPos != XMP_VarString::npos ) {
 		XMP_VarString nsPrefix ( elemName.substr ( 0, colonPos+1 ) );
-		XMP_StringMapPos prefixPos = sNamespacePrefixToURIMap->find ( nsPrefix );
-		XMP_Enforce ( prefixPos != sNamespacePrefixToURIMap->end() );
-		DeclareOneNamespace ( nsPrefix, prefixPos->second, usedNS, outputStr, newline, indentStr, indent );
+		XMP_VarString nsURI;
+		{
+			XMP_NamespaceReadLock nsLock ( sNamespaceLock );
+			XMP_StringMapPos prefixPos = sNamespacePrefixToURIMap->find ( nsPrefix );
+			XMP_Enforce ( prefixPos != sNamespacePrefixToURIMap->end() );
+			nsURI = prefixPos->second;
+		}
+		DeclareOneNamespace ( nsPrefix, nsURI, usedNS, outputStr, newline, indentStr, indent );
 	}
 
 }	// DeclareElemNamespace
@@ -613,9 +618,12 @@ SerializePrettyRDFSchema ( const XMP_VarString & treeName,
 	outputStr += '"';
 
 	size_t totalLen = 8;	// Start at 8 for "xml:rdf:".
-	XMP_cStringMapPos currPos = sNamespacePrefixToURIMap->begin();
-	XMP_cStringMapPos endPos  = sNamespacePrefixToURIMap->end();
-	for ( ; currPos != endPos; ++currPos ) totalLen += currPos->first.size();
+	{
+		XMP_NamespaceReadLock nsLock ( sNamespaceLock );
+		XMP_cStringMapPos currPos = sNamespacePrefixToURIMap->begin();
+		XMP_cStringMapPos endPos  = sNamespacePrefixToURIMap->end();
+		for ( ; currPos != endPos; ++currPos ) totalLen += currPos->first.size();
+	}
 
 	XMP_VarString usedNS;
 	usedNS.reserve ( totalLen );
@@ -989,9 +997,12 @@ SerializeCompactRDFSchemas ( const XMP_Node & xmpTree,
 	// Write all necessary xmlns attributes.
 	
 	size_t totalLen = 8;	// Start at 8 for "xml:rdf:".
-	XMP_cStringMapPos currPos = sNamespacePrefixToURIMap->begin();
-	XMP_cStringMapPos endPos  = sNamespacePrefixToURIMap->end();
-	for ( ; currPos != endPos; ++currPos ) totalLen += currPos->first.size();
+	{
+		XMP_NamespaceReadLock nsLock ( sNamespaceLock );
+		XMP_cStringMapPos currPos = sNamespacePrefixToURIMap->begin();
+		XMP_cStringMapPos endPos  = sNamespacePrefixToURIMap->end();
+		for ( ; currPos != endPos; ++currPos ) totalLen += currPos->first.size();
+	}
 
 	XMP_VarString usedNS;
 	usedNS.reserve ( totalLen );
@@ -654,8 +654,6 @@ XMPMeta::Initialize()
 	
 	sExceptionMessage = new XMP_VarString();
 	XMP_InitMutex ( &sXMPCoreLock );
-    sOutputNS  = new XMP_VarString;
-    sOutputStr = new XMP_VarString;
 
 	xdefaultName = new XMP_VarString ( "x-default" );
 	
@@ -826,8 +824,6 @@ XMPMeta::Terminate() RELEASE_NO_THROW
 	EliminateGlobal ( sRegisteredAliasMap );
     
     EliminateGlobal ( xdefaultName );
-    EliminateGlobal ( sOutputNS );
-    EliminateGlobal ( sOutputStr );
 	EliminateGlobal ( sExceptionMessage );
 
 	XMP_TermMutex ( sXMPCoreLock );
@@ -863,7 +859,7 @@ XMPMeta::UnlockObject ( XMP_OptionBits options ) const
 {
 	UNUSED(options);
 
-	XMPMeta::Unlock ( 0 );
+	// Nothing to do, the object methods do not take the toolkit lock.
 
 }	// UnlockObject
 
@@ -883,6 +879,7 @@ XMPMeta::DumpNamespaces ( XMP_TextOutputProc outProc,
 	XMP_Assert ( outProc != 0 );	// ! Enforced by wrapper.
 	XMP_Status status = 0;
 	
+	XMP_NamespaceReadLock nsLock ( sNamespaceLock );	// ! Parsing registers namespaces without the toolkit lock.
 	XMP_StringMapPos p2uEnd = sNamespacePrefixToURIMap->end();	// ! Move up to avoid gcc complaints.
 	XMP_StringMapPos u2pEnd = sNamespaceURIToPrefixMap->end();
 	
@@ -1049,8 +1046,14 @@ XMPMeta::RegisterNamespace ( XMP_StringPtr	 namespaceURI,
 	VerifySimpleXMLName ( prefix, prefix+prfix.size()-1 );	// Exclude the colon.
 	
         // Set the new namespace in both maps.
+        XMP_NamespaceWriteLock nsLock ( sNamespaceLock );
+        XMP_StringMapPos uriPos = sNamespaceURIToPrefixMap->find ( nsURI );
+        XMP_StringMapPos prefixPos = sNamespacePrefixToURIMap->find ( prfix );
+        if ( (uriPos != sNamespaceURIToPrefixMap->end()) && (uriPos->second == prfix) &&
+             (prefixPos != sNamespacePrefixToURIMap->end()) && (prefixPos->second == nsURI) ) return;
         (*sNamespaceURIToPrefixMap)[nsURI] = prfix;
         (*sNamespacePrefixToURIMap)[prfix] = nsURI;
+        ++sNamespaceGeneration;
 	
 }	// RegisterNamespace
 
@@ -1069,12 +1072,17 @@ XMPMeta::GetNamespacePrefix	( XMP_StringPtr   namespaceURI,
 	XMP_Assert ( *namespaceURI != 0 ); 	// ! Enforced by wrapper.
 	XMP_Assert ( (namespacePrefix != 0) && (prefixSize != 0) );	// ! Enforced by wrapper.
 
+	// ! The prefix is copied to a per thread string, the map entry can change once the lock is released.
+	static thread_local XMP_VarString sPrefix;
+
 	XMP_VarString    nsURI ( namespaceURI );
+	XMP_NamespaceReadLock nsLock ( sNamespaceLock );
 	XMP_StringMapPos uriPos	= sNamespaceURIToPrefixMap->find ( nsURI );
 	
 	if ( uriPos != sNamespaceURIToPrefixMap->end() ) {
-		*namespacePrefix = uriPos->second.c_str();
-		*prefixSize = uriPos->second.size();
+		sPrefix = uriPos->second;
+		*namespacePrefix = sPrefix.c_str();
+		*prefixSize = sPrefix.size();
 		found = true;
 	}
 	
@@ -1100,11 +1108,16 @@ XMPMeta::GetNamespaceURI ( XMP_StringPtr   namespacePrefix,
 	XMP_VarString nsPrefix ( namespacePrefix );
 	if ( nsPrefix[nsPrefix.size()-1] != ':' ) nsPrefix += ':';
 	
+	// ! The URI is copied to a per thread string, the map entry can change once the lock is released.
+	static thread_local XMP_VarString sURI;
+
+	XMP_NamespaceReadLock nsLock ( sNamespaceLock );
 	XMP_StringMapPos prefixPos = sNamespacePrefixToURIMap->find ( nsPrefix );
 	
 	if ( prefixPos != sNamespacePrefixToURIMap->end() ) {
-		*namespaceURI = prefixPos->second.c_str();
-		*uriSize = prefixPos->second.size();
+		sURI = prefixPos->second;
+		*namespaceURI = sURI.c_str();
+		*uriSize = sURI.size();
 		found = true;
 	}
 	
@@ -1124,6 +1137,7 @@ XMPMeta::GetNamespaceURI ( XMP_StringPtr   namespacePrefix,
 /* class-static */ void
 XMPMeta::DeleteNamespace ( XMP_StringPtr namespaceURI )
 {
+	XMP_NamespaceWriteLock nsLock ( sNamespaceLock );
 	XMP_StringMapPos uriPos = sNamespaceURIToPrefixMap->find ( namespaceURI );
 	if ( uriPos == sNamespaceURIToPrefixMap->end() ) return;
 
@@ -1132,10 +1146,24 @@ XMPMeta::DeleteNamespace ( XMP_StringPtr namespaceURI )
 	
 	sNamespaceURIToPrefixMap->erase ( uriPos );
 	sNamespacePrefixToURIMap->erase ( prefixPos );
+	++sNamespaceGeneration;
 
 }	// DeleteNamespace
 
 
+// -------------------------------------------------------------------------------------------------
+// GetNamespaceGeneration
+// ----------------------
+
+/* class-static */ XMP_Uns64
+XMPMeta::GetNamespaceGeneration()
+{
+	XMP_NamespaceReadLock nsLock ( sNamespaceLock );
+	return sNamespaceGeneration;
+
+}	// GetNamespaceGeneration
+
+
 // -------------------------------------------------------------------------------------------------
 // RegisterAlias
 // -------------
@@ -1190,6 +1218,7 @@ XMPMeta::RegisterAlias ( XMP_StringPtr 	aliasNS,
 	// alias is already aliased it is only OK to reregister an identical alias. If the actual is
 	// already aliased to something else and the new chain is legal, just swap in the old base.
 
+	XMP_NamespaceWriteLock nsLock ( sNamespaceLock );
 	mapPos = sRegisteredAliasMap->find ( expAlias[kRootPropStep].step );
 	if ( mapPos != sRegisteredAliasMap->end() ) {
 
@@ -1289,12 +1318,16 @@ XMPMeta::ResolveAlias ( XMP_StringPtr	 aliasNS,
 
 	minPath.push_back ( fullPath[kSchemaStep] );
 	minPath.push_back ( fullPath[kRootPropStep] );
-	XMP_AliasMapPos mapPos = sRegisteredAliasMap->find ( minPath[kRootPropStep].step );
-	if ( mapPos == sRegisteredAliasMap->end() ) return false;
+	XMP_ExpandedXPath actualPath;
+	{
+		XMP_NamespaceReadLock nsLock ( sNamespaceLock );
+		XMP_AliasMapPos mapPos = sRegisteredAliasMap->find ( minPath[kRootPropStep].step );
+		if ( mapPos == sRegisteredAliasMap->end() ) return false;
+		actualPath = mapPos->second;
+	}
 	
 	// Replace the alias portion of the full expanded path. Compose the output path string.
 	
-	const XMP_ExpandedXPath & actualPath = mapPos->second;
 	
 	fullPath[kSchemaStep] = actualPath[kSchemaStep];
 	fullPath[kRootPropStep] = actualPath[kRootPropStep];
@@ -83,6 +83,9 @@ public:
 	
 	static void
 	DeleteNamespace ( XMP_StringPtr namespaceURI );
+	
+	static XMP_Uns64
+	GetNamespaceGeneration();
 
 	// ---------------------------------------------------------------------------------------------
 	
@@ -355,7 +358,8 @@ public:
 	void
 	ParseFromBuffer ( XMP_StringPtr	 buffer,
 					  XMP_StringLen	 bufferSize,
-					  XMP_OptionBits options );
+					  XMP_OptionBits options,
+					  XMP_Uns32		 maxDepth = 0 );
 	
 	void
 	SerializeToBuffer ( XMP_StringPtr * rdfString,
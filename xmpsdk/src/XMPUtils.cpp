@@ -41,13 +41,21 @@ static const char * sBase64Chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqr
 // Static Variables
 // ================
 
-XMP_VarString * sComposedPath = 0;		// *** Only really need 1 string. Shrink periodically?
-XMP_VarString * sConvertedValue = 0;
-XMP_VarString * sBase64Str = 0;
-XMP_VarString * sCatenatedItems = 0;
-XMP_VarString * sStandardXMP = 0;
-XMP_VarString * sExtendedXMP = 0;
-XMP_VarString * sExtendedDigest = 0;
+static thread_local XMP_VarString sThreadComposedPath;
+static thread_local XMP_VarString sThreadConvertedValue;
+static thread_local XMP_VarString sThreadBase64Str;
+static thread_local XMP_VarString sThreadCatenatedItems;
+static thread_local XMP_VarString sThreadStandardXMP;
+static thread_local XMP_VarString sThreadExtendedXMP;
+static thread_local XMP_VarString sThreadExtendedDigest;
+
+thread_local XMP_VarString * sComposedPath = &sThreadComposedPath;		// *** Only really need 1 string. Shrink periodically?
+thread_local XMP_VarString * sConvertedValue = &sThreadConvertedValue;
+thread_local XMP_VarString * sBase64Str = &sThreadBase64Str;
+thread_local XMP_VarString * sCatenatedItems = &sThreadCatenatedItems;
+thread_local XMP_VarString * sStandardXMP = &sThreadStandardXMP;
+thread_local XMP_VarString * sExtendedXMP = &sThreadExtendedXMP;
+thread_local XMP_VarString * sExtendedDigest = &sThreadExtendedDigest;
 
 // =================================================================================================
 // Local Utilities
@@ -638,14 +646,6 @@ static size_t MoveLargestProperty ( XMPMeta & stdXMP, XMPMeta * extXMP, PropSize
 /* class static */ bool
 XMPUtils::Initialize()
 {
-	sComposedPath	= new XMP_VarString();
-	sConvertedValue = new XMP_VarString();
-	sBase64Str		= new XMP_VarString();
-	sCatenatedItems = new XMP_VarString();
-	sStandardXMP    = new XMP_VarString();
-	sExtendedXMP    = new XMP_VarString();
-	sExtendedDigest = new XMP_VarString();
-
 	#if XMP_MacBuild && __MWERKS__
 		LookupTimeProcs();
 	#endif
@@ -659,18 +659,10 @@ XMPUtils::Initialize()
 // Terminate
 // ---------
 
-#define EliminateGlobal(g) delete ( g ); g = 0
-
 /* class static */ void
 XMPUtils::Terminate() RELEASE_NO_THROW
 {
-	EliminateGlobal ( sComposedPath );
-	EliminateGlobal ( sConvertedValue );
-	EliminateGlobal ( sBase64Str );
-	EliminateGlobal ( sCatenatedItems );
-	EliminateGlobal ( sStandardXMP );
-	EliminateGlobal ( sExtendedXMP );
-	EliminateGlobal ( sExtendedDigest );
+	// The output strings are per thread and released with the thread.
 
 	return;
 
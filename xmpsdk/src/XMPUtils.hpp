@@ -18,13 +18,15 @@
 
 // -------------------------------------------------------------------------------------------------
 
-extern XMP_VarString * sComposedPath;		// *** Only really need 1 string. Shrink periodically?
-extern XMP_VarString * sConvertedValue;
-extern XMP_VarString * sBase64Str;
-extern XMP_VarString * sCatenatedItems;
-extern XMP_VarString * sStandardXMP;
-extern XMP_VarString * sExtendedXMP;
-extern XMP_VarString * sExtendedDigest;
+// Output strings, per thread since the XMPMeta methods that use them are not serialized.
+
+extern thread_local XMP_VarString * sComposedPath;		// *** Only really need 1 string. Shrink periodically?
+extern thread_local XMP_VarString * sConvertedValue;
+extern thread_local XMP_VarString * sBase64Str;
+extern thread_local XMP_VarString * sCatenatedItems;
+extern thread_local XMP_VarString * sStandardXMP;
+extern thread_local XMP_VarString * sExtendedXMP;
+extern thread_local XMP_VarString * sExtendedDigest;
 
 // -------------------------------------------------------------------------------------------------
 